@@ -0,0 +1,213 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinaryArchive.cpp
+ * @date October 2026
+ * @brief Low-level reading and writing of the GTSAM binary format
+ */
+
+#include <gtsam/base/BinaryArchive.h>
+#include <gtsam/base/MappedFile.h>
+
+#include <limits>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+const char kMagic[8] = {'G', 'T', 'S', 'A', 'M', 'B', 'I', 'N'};
+const uint32_t kByteOrder = 0x01020304;
+const size_t kAlignment = sizeof(double);
+
+/// Memory with a copy of a buffer, aligned to 8 bytes
+struct AlignedCopy {
+  std::vector<double> data;
+};
+}
+
+/* ************************************************************************* */
+const uint32_t BinaryOutArchive::Version;
+
+/* ************************************************************************* */
+BinaryOutArchive::BinaryOutArchive(ostream& os) : os_(os), start_(os.tellp()) {
+  if (start_ == streampos(-1))
+    throw invalid_argument("BinaryOutArchive: stream is not seekable");
+  writeBytes(kMagic, sizeof(kMagic));
+  write(Version);
+  write(kByteOrder);
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeBytes(const void* data, size_t size) {
+  os_.write(static_cast<const char*>(data), size);
+  if (!os_) throw runtime_error("BinaryOutArchive: write failed");
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeString(const string& s) {
+  write<uint64_t>(s.size());
+  writeBytes(s.data(), s.size());
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeDoubles(const double* data, size_t n) {
+  writeAligned(data, n * sizeof(double));
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeAligned(const void* data, size_t size) {
+  static const char padding[kAlignment] = {0};
+  const size_t misaligned = position() % kAlignment;
+  if (misaligned) writeBytes(padding, kAlignment - misaligned);
+  writeBytes(data, size);
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeVector(const Vector& v) {
+  write<uint64_t>(v.size());
+  writeDoubles(v.data(), v.size());
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::writeMatrix(const Matrix& A) {
+  write<uint64_t>(A.rows());
+  write<uint64_t>(A.cols());
+  writeDoubles(A.data(), A.size());
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::beginSection(uint32_t tag) {
+  write(tag);
+  sections_.push_back(os_.tellp());
+  write<uint64_t>(0);  // length, filled in by endSection
+}
+
+/* ************************************************************************* */
+void BinaryOutArchive::endSection() {
+  if (sections_.empty())
+    throw logic_error("BinaryOutArchive::endSection: no open section");
+  const streampos lengthPosition = sections_.back(), end = os_.tellp();
+  sections_.pop_back();
+  const uint64_t length = end - lengthPosition - streamoff(sizeof(uint64_t));
+  os_.seekp(lengthPosition);
+  write(length);
+  os_.seekp(end);
+}
+
+/* ************************************************************************* */
+uint64_t BinaryOutArchive::position() const {
+  return os_.tellp() - start_;
+}
+
+/* ************************************************************************* */
+BinaryInArchive::BinaryInArchive(const string& filename) {
+  boost::shared_ptr<MappedFile> file(new MappedFile(filename));
+  begin_ = file->data();
+  end_ = file->end();
+  storage_ = file;
+  cursor_ = begin_;
+  readHeader();
+}
+
+/* ************************************************************************* */
+BinaryInArchive::BinaryInArchive(const char* data, size_t size)
+    : begin_(data), end_(data + size) {
+  if (reinterpret_cast<size_t>(data) % kAlignment != 0) {
+    boost::shared_ptr<AlignedCopy> copy(new AlignedCopy());
+    copy->data.resize((size + kAlignment - 1) / kAlignment);
+    memcpy(copy->data.data(), data, size);
+    begin_ = reinterpret_cast<const char*>(copy->data.data());
+    end_ = begin_ + size;
+    storage_ = copy;
+  }
+  cursor_ = begin_;
+  readHeader();
+}
+
+/* ************************************************************************* */
+void BinaryInArchive::readHeader() {
+  if (end_ - begin_ < static_cast<ptrdiff_t>(sizeof(kMagic)) ||
+      memcmp(begin_, kMagic, sizeof(kMagic)) != 0)
+    throw runtime_error("BinaryInArchive: not a GTSAM binary file");
+  advance(sizeof(kMagic));
+  const uint32_t version = read<uint32_t>();
+  if (version > BinaryOutArchive::Version)
+    throw runtime_error("BinaryInArchive: unsupported format version " +
+                        to_string(version));
+  if (read<uint32_t>() != kByteOrder)
+    throw runtime_error("BinaryInArchive: data has a different byte order");
+}
+
+/* ************************************************************************* */
+const char* BinaryInArchive::advance(size_t size) {
+  if (static_cast<size_t>(end_ - cursor_) < size)
+    throw runtime_error("BinaryInArchive: unexpected end of data");
+  const char* data = cursor_;
+  cursor_ += size;
+  return data;
+}
+
+/* ************************************************************************* */
+string BinaryInArchive::readString() {
+  const uint64_t size = read<uint64_t>();
+  return string(advance(size), size);
+}
+
+/* ************************************************************************* */
+const double* BinaryInArchive::readDoubles(size_t n) {
+  if (n > static_cast<size_t>(end_ - cursor_) / sizeof(double))
+    throw runtime_error("BinaryInArchive: unexpected end of data");
+  return reinterpret_cast<const double*>(readAligned(n * sizeof(double)));
+}
+
+/* ************************************************************************* */
+const char* BinaryInArchive::readAligned(size_t size) {
+  const size_t misaligned = position() % kAlignment;
+  if (misaligned) advance(kAlignment - misaligned);
+  return advance(size);
+}
+
+/* ************************************************************************* */
+Eigen::Map<const Vector> BinaryInArchive::readVector() {
+  const uint64_t size = read<uint64_t>();
+  return Eigen::Map<const Vector>(readDoubles(size), size);
+}
+
+/* ************************************************************************* */
+Eigen::Map<const Matrix> BinaryInArchive::readMatrix() {
+  const uint64_t rows = read<uint64_t>(), cols = read<uint64_t>();
+  if (rows && cols > numeric_limits<uint64_t>::max() / rows)
+    throw runtime_error("BinaryInArchive: corrupt matrix size");
+  return Eigen::Map<const Matrix>(readDoubles(rows * cols), rows, cols);
+}
+
+/* ************************************************************************* */
+BinaryInArchive::Section BinaryInArchive::readSection() {
+  Section section;
+  section.tag = read<uint32_t>();
+  section.length = read<uint64_t>();
+  if (section.length > static_cast<uint64_t>(end_ - cursor_))
+    throw runtime_error("BinaryInArchive: truncated section");
+  return section;
+}
+
+/* ************************************************************************* */
+BinaryInArchive::Section BinaryInArchive::readSection(uint32_t tag) {
+  const Section section = readSection();
+  if (section.tag != tag)
+    throw runtime_error("BinaryInArchive: expected section " + to_string(tag) +
+                        ", found " + to_string(section.tag));
+  return section;
+}
+
+} // namespace gtsam
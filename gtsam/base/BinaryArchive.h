@@ -0,0 +1,219 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinaryArchive.h
+ * @date October 2026
+ * @brief Low-level reading and writing of the GTSAM binary format
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/dllexport.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Writes the GTSAM binary format to a stream.
+ *
+ * A file starts with a header (magic, format version and byte order), followed
+ * by sections. Each section starts with a tag and its length in bytes, so that
+ * readers can skip sections they do not know. Arrays of doubles are aligned to
+ * 8 bytes relative to the start of the file, so that a memory mapped file can
+ * be read without copying them (see BinaryInArchive).
+ *
+ * Sections are closed by writing their length in place, so the stream has to
+ * be seekable, as are file and string streams.
+ */
+class GTSAM_EXPORT BinaryOutArchive {
+  std::ostream& os_;
+  std::streampos start_;
+  std::vector<std::streampos> sections_;  ///< open sections, for endSection
+
+public:
+
+  /// Version of the format that is written
+  static const uint32_t Version = 1;
+
+  /// Write the header of the format to os
+  explicit BinaryOutArchive(std::ostream& os);
+
+  /// Write a value of a trivially copyable type, e.g., an integer or double
+  template<typename POD>
+  void write(const POD& value) {
+    static_assert(std::is_trivially_copyable<POD>::value,
+                  "BinaryOutArchive::write needs a trivially copyable type");
+    writeBytes(&value, sizeof(POD));
+  }
+
+  /// Write raw bytes
+  void writeBytes(const void* data, size_t size);
+
+  /// Write a string, with its length
+  void writeString(const std::string& s);
+
+  /// Write n doubles, aligned to 8 bytes
+  void writeDoubles(const double* data, size_t n);
+
+  /// Write n values of a trivially copyable type, aligned to 8 bytes, so that
+  /// BinaryInArchive::readArray can read them in place
+  template<typename POD>
+  void writeArray(const POD* data, size_t n) {
+    static_assert(std::is_trivially_copyable<POD>::value,
+                  "BinaryOutArchive::writeArray needs a trivially copyable type");
+    writeAligned(data, n * sizeof(POD));
+  }
+
+  /// Write raw bytes, aligned to 8 bytes
+  void writeAligned(const void* data, size_t size);
+
+  /// Write a vector, with its size
+  void writeVector(const Vector& v);
+
+  /// Write a dense matrix, column-major, with its size
+  void writeMatrix(const Matrix& A);
+
+  /// Write fixed-size Eigen objects without their size
+  template<typename Derived>
+  void writeFixed(const Eigen::MatrixBase<Derived>& A) {
+    const Eigen::Matrix<double, Derived::RowsAtCompileTime,
+                        Derived::ColsAtCompileTime> copy = A;
+    writeDoubles(copy.data(), copy.size());
+  }
+
+  /// Start a section with the given tag, closed by endSection
+  void beginSection(uint32_t tag);
+
+  /// Close the last section that was begun
+  void endSection();
+
+  /// Current position relative to the start of the archive
+  uint64_t position() const;
+};
+
+/**
+ * Reads the GTSAM binary format from memory, typically from a memory mapped
+ * file. Arrays of doubles are returned as Eigen maps into the data, so they
+ * are read in place rather than parsed.
+ */
+class GTSAM_EXPORT BinaryInArchive {
+public:
+
+  /// Header of a section
+  struct Section {
+    uint32_t tag;
+    uint64_t length;  ///< in bytes, after the header
+  };
+
+private:
+
+  boost::shared_ptr<const void> storage_;  ///< keeps the data alive
+  const char* begin_;
+  const char* end_;
+  const char* cursor_;
+
+  void readHeader();
+  const char* advance(size_t size);
+
+public:
+
+  /// Map the file into memory and read its header, throws on failure
+  explicit BinaryInArchive(const std::string& filename);
+
+  /**
+   * Read from data in memory, which has to outlive the archive unless it is
+   * not aligned to 8 bytes, in which case it is copied.
+   */
+  BinaryInArchive(const char* data, size_t size);
+
+  /// Read a value of a trivially copyable type
+  template<typename POD>
+  POD read() {
+    static_assert(std::is_trivially_copyable<POD>::value,
+                  "BinaryInArchive::read needs a trivially copyable type");
+    POD value;
+    std::memcpy(&value, advance(sizeof(POD)), sizeof(POD));
+    return value;
+  }
+
+  /**
+   * Read the number of elements that follow, each at least sizeof(POD) bytes,
+   * and check that the data can hold that many before anything is sized
+   * from it
+   */
+  template<typename POD>
+  size_t readCount() {
+    const uint64_t n = read<uint64_t>();
+    if (n > static_cast<uint64_t>(end_ - cursor_) / sizeof(POD))
+      throw std::runtime_error("BinaryInArchive: corrupt array size");
+    return static_cast<size_t>(n);
+  }
+
+  /// Read a string written with writeString
+  std::string readString();
+
+  /// Read n doubles in place, valid for the lifetime of the archive
+  const double* readDoubles(size_t n);
+
+  /// Read n values written with BinaryOutArchive::writeArray, in place
+  template<typename POD>
+  const POD* readArray(size_t n) {
+    static_assert(std::is_trivially_copyable<POD>::value && alignof(POD) <= 8,
+                  "BinaryInArchive::readArray needs a trivially copyable type");
+    if (n > std::numeric_limits<size_t>::max() / sizeof(POD))
+      throw std::runtime_error("BinaryInArchive: corrupt array size");
+    return reinterpret_cast<const POD*>(readAligned(n * sizeof(POD)));
+  }
+
+  /// Read size bytes written with BinaryOutArchive::writeAligned, in place
+  const char* readAligned(size_t size);
+
+  /// Read a vector written with writeVector, in place
+  Eigen::Map<const Vector> readVector();
+
+  /// Read a matrix written with writeMatrix, in place
+  Eigen::Map<const Matrix> readMatrix();
+
+  /// Read a fixed-size Eigen object written with writeFixed
+  template<typename FIXED>
+  FIXED readFixed() {
+    return Eigen::Map<const FIXED>(readDoubles(FIXED::SizeAtCompileTime));
+  }
+
+  /// Read the header of the next section
+  Section readSection();
+
+  /// Read the header of the next section, and check its tag
+  Section readSection(uint32_t tag);
+
+  /// Skip the given number of bytes, e.g., the rest of a section
+  void skip(uint64_t size) { advance(size); }
+
+  /// Whether all data was read
+  bool atEnd() const { return cursor_ == end_; }
+
+  /// Current position relative to the start of the archive
+  uint64_t position() const { return cursor_ - begin_; }
+};
+
+} // namespace gtsam
@@ -0,0 +1,79 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MappedFile.cpp
+ * @date October 2026
+ * @brief Read-only access to the contents of a whole file
+ */
+
+#include <gtsam/base/MappedFile.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+MappedFile::MappedFile(const string& filename)
+    : data_(nullptr), size_(0), mapped_(false) {
+#ifndef _WIN32
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw runtime_error("MappedFile: cannot open " + filename);
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw runtime_error("MappedFile: cannot read " + filename);
+  }
+  size_ = info.st_size;
+  if (size_ > 0) {
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw runtime_error("MappedFile: cannot map " + filename);
+    }
+    data_ = static_cast<const char*>(data);
+    mapped_ = true;
+  }
+  close(fd);
+#else
+  // Without mmap, read the whole file into aligned memory
+  ifstream is(filename.c_str(), ios::binary | ios::ate);
+  if (!is)
+    throw runtime_error("MappedFile: cannot open " + filename);
+  size_ = is.tellg();
+  copy_.resize((size_ + sizeof(double) - 1) / sizeof(double));
+  is.seekg(0);
+  is.read(reinterpret_cast<char*>(copy_.data()), size_);
+  if (!is)
+    throw runtime_error("MappedFile: cannot read " + filename);
+  data_ = reinterpret_cast<const char*>(copy_.data());
+#endif
+}
+
+/* ************************************************************************* */
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+  if (mapped_) munmap(const_cast<char*>(data_), size_);
+#endif
+}
+
+} // namespace gtsam
@@ -0,0 +1,60 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MappedFile.h
+ * @date October 2026
+ * @brief Read-only access to the contents of a whole file
+ */
+
+#pragma once
+
+#include <gtsam/dllexport.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * The contents of a file, mapped into memory where the platform supports it,
+ * and read into memory otherwise. The data is aligned to at least 8 bytes and
+ * stays valid for the lifetime of the object.
+ */
+class GTSAM_EXPORT MappedFile {
+  const char* data_;
+  size_t size_;
+  bool mapped_;
+  std::vector<double> copy_;  ///< aligned storage when the file is not mapped
+
+public:
+
+  /// Map the file, throws std::runtime_error if it cannot be read
+  explicit MappedFile(const std::string& filename);
+
+  /// Unmap the file
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// The first byte of the file
+  const char* data() const { return data_; }
+
+  /// The size of the file in bytes
+  size_t size() const { return size_; }
+
+  /// One past the last byte of the file
+  const char* end() const { return data_ + size_; }
+};
+
+} // namespace gtsam
@@ -21,8 +21,15 @@
 
 #include <gtsam/discrete/DecisionTree.h>
 #include <gtsam/base/Testable.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
 
 #include <boost/format.hpp>
+#include <boost/functional/hash.hpp>
 #include <boost/optional.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/assign/std/vector.hpp>
@@ -34,6 +41,9 @@ using boost::assign::operator+=;
 #include <cmath>
 #include <fstream>
 #include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace gtsam {
 
@@ -100,32 +110,6 @@ namespace gtsam {
       return constant_;
     }
 
-    /** apply unary operator */
-    NodePtr apply(const Unary& op) const {
-      NodePtr f(new Leaf(op(constant_)));
-      return f;
-    }
-
-    // Apply binary operator "h = f op g" on Leaf node
-    // Note op is not assumed commutative so we need to keep track of order
-    // Simply calls apply on argument to call correct virtual method:
-    // fL.apply_f_op_g(gL) -> gL.apply_g_op_fL(fL) (below)
-    // fL.apply_f_op_g(gC) -> gC.apply_g_op_fL(fL) (Choice)
-    NodePtr apply_f_op_g(const Node& g, const Binary& op) const {
-      return g.apply_g_op_fL(*this, op);
-    }
-
-    // Applying binary operator to two leaves results in a leaf
-    NodePtr apply_g_op_fL(const Leaf& fL, const Binary& op) const {
-      NodePtr h(new Leaf(op(fL.constant_, constant_))); // fL op gL
-      return h;
-    }
-
-    // If second argument is a Choice node, call it's apply with leaf as second
-    NodePtr apply_g_op_fC(const Choice& fC, const Binary& op) const {
-      return fC.apply_fC_op_gL(*this, op); // operand order back to normal
-    }
-
     /** choose a branch, create new memory ! */
     NodePtr choose(const L& label, size_t index) const {
       return NodePtr(new Leaf(constant()));
@@ -168,8 +152,7 @@ namespace gtsam {
         assert(f->branches().size() > 0);
         NodePtr f0 = f->branches_[0];
         assert(f0->isLeaf());
-        NodePtr newLeaf(new Leaf(boost::dynamic_pointer_cast<const Leaf>(f0)->constant()));
-        return newLeaf;
+        return f0; // nodes are immutable, so the leaf can be shared
       } else
 #endif
         return f;
@@ -183,37 +166,6 @@ namespace gtsam {
       branches_.reserve(count);
     }
 
-    /**
-     * Construct from applying binary op to two Choice nodes
-     */
-    Choice(const Choice& f, const Choice& g, const Binary& op) :
-      allSame_(true) {
-
-      // Choose what to do based on label
-      if (f.label() > g.label()) {
-        // f higher than g
-        label_ = f.label();
-        size_t count = f.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(f.branches_[i]->apply_f_op_g(g, op));
-      } else if (g.label() > f.label()) {
-        // f lower than g
-        label_ = g.label();
-        size_t count = g.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(g.branches_[i]->apply_g_op_fC(f, op));
-      } else {
-        // f same level as g
-        label_ = f.label();
-        size_t count = f.nrChoices();
-        branches_.reserve(count);
-        for (size_t i = 0; i < count; i++)
-          push_back(f.branches_[i]->apply_f_op_g(*g.branches_[i], op));
-      }
-    }
-
     const L& label() const {
       return label_;
     }
@@ -302,68 +254,254 @@ namespace gtsam {
       return (*child)(x);
     }
 
-    /**
-     * Construct from applying unary op to a Choice node
-     */
-    Choice(const L& label, const Choice& f, const Unary& op) :
-      label_(label), allSame_(true) {
-
-      branches_.reserve(f.branches_.size()); // reserve space
-      for (const NodePtr& branch: f.branches_)
-              push_back(branch->apply(op));
-    }
+    /** choose a branch, recursively */
+    NodePtr choose(const L& label, size_t index) const {
+      if (label_ == label)
+        return branches_[index]; // choose branch
 
-    /** apply unary operator */
-    NodePtr apply(const Unary& op) const {
-      boost::shared_ptr<Choice> r(new Choice(label_, *this, op));
+      // second case, not label of interest, just recurse
+      boost::shared_ptr<Choice> r(new Choice(label_, branches_.size()));
+      for(const NodePtr& branch: branches_)
+              r->push_back(branch->choose(label, index));
       return Unique(r);
     }
 
-    // Apply binary operator "h = f op g" on Choice node
-    // Note op is not assumed commutative so we need to keep track of order
-    // Simply calls apply on argument to call correct virtual method:
-    // fC.apply_f_op_g(gL) -> gL.apply_g_op_fC(fC) -> (Leaf)
-    // fC.apply_f_op_g(gC) -> gC.apply_g_op_fC(fC) -> (below)
-    NodePtr apply_f_op_g(const Node& g, const Binary& op) const {
-      return g.apply_g_op_fC(*this, op);
+  }; // Choice
+
+  /*********************************************************************************/
+  // OperationCache
+  /*********************************************************************************/
+  namespace internal {
+    /// Unique table for leaves: none for general Y, which may not be hashable
+    template<typename Y, typename LEAF, typename PTR,
+        bool = std::is_arithmetic<Y>::value>
+    struct DecisionTreeLeaves {
+      PTR operator()(const Y& y) { return PTR(new LEAF(y)); }
+    };
+
+    /// Unique table for arithmetic leaves
+    template<typename Y, typename LEAF, typename PTR>
+    struct DecisionTreeLeaves<Y, LEAF, PTR, true> {
+      std::unordered_map<Y, PTR> leaves;
+      PTR operator()(const Y& y) {
+        PTR& leaf = leaves[y];
+        if (!leaf) leaf.reset(new LEAF(y));
+        return leaf;
+      }
+    };
+  } // namespace internal
+
+  /**
+   * Memoization for one apply or combine, which makes the result a decision
+   * diagram (as the ADDs of Bahar et al. 93) rather than a tree:
+   * - a unique table, so that a Choice on the same label with the same
+   *   branches (and, for arithmetic Y, a leaf with the same value) is only
+   *   created once, and identical subtrees are shared;
+   * - computed tables, keyed on the argument nodes, so that shared subtrees
+   *   of the arguments are only visited once.
+   * The op is fixed for the lifetime of a cache, which is why the tables are
+   * per operation. The tables hold on to the nodes in their keys, so their
+   * addresses can not be reused while the cache is alive.
+   */
+  template<typename L, typename Y>
+  class DecisionTree<L, Y>::OperationCache: boost::noncopyable {
+
+    /// Arguments and result of an operation
+    struct Computed {
+      NodePtr f, g, h;
+    };
+
+    typedef std::pair<const Node*, const Node*> NodePair;
+    struct NodePairHash {
+      size_t operator()(const NodePair& p) const {
+        size_t seed = 0;
+        boost::hash_combine(seed, p.first);
+        boost::hash_combine(seed, p.second);
+        return seed;
+      }
+    };
+
+    /// Key of a Choice node, hashed on its branches only, as L may not be hashable
+    struct ChoiceKey {
+      L label;
+      std::vector<const Node*> branches;
+      bool operator==(const ChoiceKey& other) const {
+        return branches == other.branches && label == other.label;
+      }
+    };
+    struct ChoiceKeyHash {
+      size_t operator()(const ChoiceKey& key) const {
+        return boost::hash_range(key.branches.begin(), key.branches.end());
+      }
+    };
+
+    internal::DecisionTreeLeaves<Y, Leaf, NodePtr> leaves_;
+    std::unordered_map<ChoiceKey, Computed, ChoiceKeyHash> choices_;
+    std::unordered_map<const Node*, Computed> unary_, combined_;
+    std::unordered_map<NodePair, Computed, NodePairHash> binary_;
+
+    // Leaf and Choice are the only nodes
+    static const Choice* AsChoice(const NodePtr& f) {
+      return f->isLeaf() ? 0 : static_cast<const Choice*>(f.get());
+    }
+    static const Y& Constant(const NodePtr& f) {
+      return static_cast<const Leaf&>(*f).constant();
     }
 
-    // If second argument of binary op is Leaf node, recurse on branches
-    NodePtr apply_g_op_fL(const Leaf& fL, const Binary& op) const {
-      boost::shared_ptr<Choice> h(new Choice(label(), nrChoices()));
-      for(NodePtr branch: branches_)
-              h->push_back(fL.apply_f_op_g(*branch, op));
-      return Unique(h);
+    /**
+     * Choice on label with branches branch(cache, i), in parallel with a cache
+     * per thread if requested and TBB is available. Only the caller can know
+     * whether op is thread-safe, so parallel is never set by default.
+     */
+    template<typename BRANCH>
+    NodePtr split(const L& label, size_t n, bool parallel, BRANCH branch) {
+      std::vector<NodePtr> branches(n);
+#ifdef GTSAM_USE_TBB
+      if (parallel && n > 1) {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+            [&](const tbb::blocked_range<size_t>& range) {
+              OperationCache cache;
+              for (size_t i = range.begin(); i != range.end(); ++i)
+                branches[i] = branch(cache, i);
+            });
+        return choice(label, branches);
+      }
+#endif
+      for (size_t i = 0; i < n; i++)
+        branches[i] = branch(*this, i);
+      return choice(label, branches);
     }
 
-    // If second argument of binary op is Choice, call constructor
-    NodePtr apply_g_op_fC(const Choice& fC, const Binary& op) const {
-      boost::shared_ptr<Choice> h(new Choice(fC, *this, op));
-      return Unique(h);
+  public:
+
+    /// Number of nodes above which apply and combine split over threads
+    static const size_t kParallelNodes = 4096;
+
+    /// Whether trees f and g are large enough to be split over threads
+    static bool Parallel(const NodePtr& f, const NodePtr& g) {
+#ifdef GTSAM_USE_TBB
+      std::unordered_set<const Node*> visited;
+      std::vector<const Node*> stack;
+      stack.push_back(f.get());
+      stack.push_back(g.get());
+      while (!stack.empty()) {
+        const Node* node = stack.back();
+        stack.pop_back();
+        if (!visited.insert(node).second) continue;
+        if (visited.size() > kParallelNodes) return true;
+        if (!node->isLeaf())
+          for (const NodePtr& branch: static_cast<const Choice*>(node)->branches())
+            stack.push_back(branch.get());
+      }
+#endif
+      return false;
     }
 
-    // If second argument of binary op is Leaf
-    template<typename OP>
-    NodePtr apply_fC_op_gL(const Leaf& gL, OP op) const {
-      boost::shared_ptr<Choice> h(new Choice(label(), nrChoices()));
-      for(const NodePtr& branch: branches_)
-              h->push_back(branch->apply_f_op_g(gL, op));
-      return Unique(h);
+    /// The unique leaf with value y
+    NodePtr leaf(const Y& y) {
+      return leaves_(y);
+    }
+
+    /// The unique Choice on label with the given branches, or their leaf if all same
+    NodePtr choice(const L& label, const std::vector<NodePtr>& branches) {
+      ChoiceKey key;
+      key.label = label;
+      key.branches.reserve(branches.size());
+      for (const NodePtr& branch: branches)
+        key.branches.push_back(branch.get());
+      typename std::unordered_map<ChoiceKey, Computed, ChoiceKeyHash>::const_iterator
+          it = choices_.find(key);
+      if (it != choices_.end()) return it->second.h;
+
+      boost::shared_ptr<Choice> c(new Choice(label, branches.size()));
+      for (const NodePtr& branch: branches)
+        c->push_back(branch);
+      const Computed computed = {c, NodePtr(), Choice::Unique(c)};
+      choices_.emplace(std::move(key), computed);
+      return computed.h;
+    }
+
+    /// op(f)
+    NodePtr apply(const NodePtr& f, const Unary& op) {
+      typename std::unordered_map<const Node*, Computed>::const_iterator it =
+          unary_.find(f.get());
+      if (it != unary_.end()) return it->second.h;
+
+      NodePtr h;
+      if (const Choice* fC = AsChoice(f)) {
+        std::vector<NodePtr> branches;
+        branches.reserve(fC->nrChoices());
+        for (const NodePtr& branch: fC->branches())
+          branches.push_back(apply(branch, op));
+        h = choice(fC->label(), branches);
+      } else {
+        h = leaf(op(Constant(f)));
+      }
+      const Computed computed = {f, NodePtr(), h};
+      unary_.emplace(f.get(), computed);
+      return h;
     }
 
-    /** choose a branch, recursively */
-    NodePtr choose(const L& label, size_t index) const {
-      if (label_ == label)
-        return branches_[index]; // choose branch
+    /// f op g, split on the highest label of f and g as in the Choice constructor
+    NodePtr apply(const NodePtr& f, const NodePtr& g, const Binary& op,
+        bool parallel = false) {
+      const NodePair key(f.get(), g.get());
+      typename std::unordered_map<NodePair, Computed, NodePairHash>::const_iterator
+          it = binary_.find(key);
+      if (it != binary_.end()) return it->second.h;
 
-      // second case, not label of interest, just recurse
-      boost::shared_ptr<Choice> r(new Choice(label_, branches_.size()));
-      for(const NodePtr& branch: branches_)
-              r->push_back(branch->choose(label, index));
-      return Unique(r);
+      NodePtr h;
+      const Choice* fC = AsChoice(f);
+      const Choice* gC = AsChoice(g);
+      if (!fC && !gC) {
+        h = leaf(op(Constant(f), Constant(g)));
+      } else {
+        const Choice& top = (fC && (!gC || !(gC->label() > fC->label()))) ? *fC : *gC;
+        const bool splitF = fC && fC->label() == top.label();
+        const bool splitG = gC && gC->label() == top.label();
+        h = split(top.label(), top.nrChoices(), parallel,
+            [&](OperationCache& cache, size_t i) {
+              return cache.apply(splitF ? fC->branches()[i] : f,
+                  splitG ? gC->branches()[i] : g, op);
+            });
+      }
+      const Computed computed = {f, g, h};
+      binary_.emplace(key, computed);
+      return h;
     }
 
-  }; // Choice
+    /// op over the subtrees of f for all values of label, as in combine
+    NodePtr combine(const NodePtr& f, const L& label, size_t cardinality,
+        const Binary& op, bool parallel = false) {
+      typename std::unordered_map<const Node*, Computed>::const_iterator it =
+          combined_.find(f.get());
+      if (it != combined_.end()) return it->second.h;
+
+      NodePtr h;
+      const Choice* fC = AsChoice(f);
+      if (fC && fC->label() == label) {
+        // choose(label, i) is branch i
+        h = fC->branches()[0];
+        for (size_t i = 1; i < cardinality; i++)
+          h = apply(h, fC->branches()[i], op, parallel);
+      } else if (fC && fC->label() > label) {
+        // label is further down, combine the branches
+        h = split(fC->label(), fC->nrChoices(), parallel,
+            [&](OperationCache& cache, size_t i) {
+              return cache.combine(fC->branches()[i], label, cardinality, op);
+            });
+      } else {
+        // labels are ordered, so label does not occur in f
+        h = f;
+        for (size_t i = 1; i < cardinality; i++)
+          h = apply(h, f, op, parallel);
+      }
+      const Computed computed = {f, NodePtr(), h};
+      combined_.emplace(f.get(), computed);
+      return h;
+    }
+
+  }; // OperationCache
 
   /*********************************************************************************/
   // DecisionTree
@@ -622,15 +760,18 @@ namespace gtsam {
 
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::apply(const Unary& op) const {
-    return DecisionTree(root_->apply(op));
+    OperationCache cache;
+    return DecisionTree(cache.apply(root_, op));
   }
 
   /*********************************************************************************/
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::apply(const DecisionTree& g,
-      const Binary& op) const {
+      const Binary& op, bool parallel) const {
     // apply the operaton on the root of both diagrams
-    NodePtr h = root_->apply_f_op_g(*g.root_, op);
+    OperationCache cache;
+    NodePtr h = cache.apply(root_, g.root_, op,
+        parallel && OperationCache::Parallel(root_, g.root_));
     // create a new class with the resulting root "h"
     DecisionTree result(h);
     return result;
@@ -643,17 +784,17 @@ namespace gtsam {
   // The function "choose(label,index)" will return a tree of one less depth,
   // where there is no more branch on "label": only the subtree under that
   // branch point corresponding to the value "index" is left instead.
-  // The function below get all these smaller trees and "ops" them together.
-  // This implements marginalization in Darwiche09book, pg 330
+  // The function below "ops" all these smaller trees together, without
+  // creating them: above "label" it recurses into the branches, at "label" it
+  // applies op to the branches, and where "label" does not occur it applies op
+  // to copies of the subtree. This implements marginalization in
+  // Darwiche09book, pg 330
   template<typename L, typename Y>
   DecisionTree<L, Y> DecisionTree<L, Y>::combine(const L& label,
-      size_t cardinality, const Binary& op) const {
-    DecisionTree result = choose(label, 0);
-    for (size_t index = 1; index < cardinality; index++) {
-      DecisionTree chosen = choose(label, index);
-      result = result.apply(chosen, op);
-    }
-    return result;
+      size_t cardinality, const Binary& op, bool parallel) const {
+    OperationCache cache;
+    return DecisionTree(cache.combine(root_, label, cardinality, op,
+        parallel && OperationCache::Parallel(root_, root_)));
   }
 
   /*********************************************************************************/
@@ -48,6 +48,9 @@ namespace gtsam {
     class Leaf;
     class Choice;
 
+    /** Unique table and computed tables of one apply or combine operation */
+    class OperationCache;
+
     /** ------------------------ Node base class --------------------------- */
     class Node {
     public:
@@ -81,10 +84,6 @@ namespace gtsam {
       virtual bool sameLeaf(const Node& q) const = 0;
       virtual bool equals(const Node& other, double tol = 1e-9) const = 0;
       virtual const Y& operator()(const Assignment<L>& x) const = 0;
-      virtual Ptr apply(const Unary& op) const = 0;
-      virtual Ptr apply_f_op_g(const Node&, const Binary&) const = 0;
-      virtual Ptr apply_g_op_fL(const Leaf&, const Binary&) const = 0;
-      virtual Ptr apply_g_op_fC(const Choice&, const Binary&) const = 0;
       virtual Ptr choose(const L& label, size_t index) const = 0;
       virtual bool isLeaf() const = 0;
     };
@@ -169,11 +168,22 @@ namespace gtsam {
     /** evaluate */
     const Y& operator()(const Assignment<L>& x) const;
 
-    /** apply Unary operation "op" to f */
+    /**
+     * apply Unary operation "op" to f
+     * Identical subtrees of the result are shared, and only computed once.
+     */
     DecisionTree apply(const Unary& op) const;
 
-    /** apply binary operation "op" to f and g */
-    DecisionTree apply(const DecisionTree& g, const Binary& op) const;
+    /**
+     * apply binary operation "op" to f and g
+     * Identical subtrees of the result are shared, and pairs of subtrees of f
+     * and g are only combined once.
+     * @param parallel if true and GTSAM is built with TBB, large trees are
+     * split over the branches of their root and combined in parallel, so op
+     * must then be thread-safe
+     */
+    DecisionTree apply(const DecisionTree& g, const Binary& op,
+        bool parallel = false) const;
 
     /** create a new function where value(label)==index
      * It's like "restrict" in Darwiche09book pg329, 330? */
@@ -182,12 +192,18 @@ namespace gtsam {
       return DecisionTree(newRoot);
     }
 
-    /** combine subtrees on key with binary operation "op" */
-    DecisionTree combine(const L& label, size_t cardinality, const Binary& op) const;
+    /**
+     * combine subtrees on key with binary operation "op"
+     * Done in one pass over the tree, with the same sharing as binary apply,
+     * and in parallel if requested, as in binary apply.
+     */
+    DecisionTree combine(const L& label, size_t cardinality, const Binary& op,
+        bool parallel = false) const;
 
     /** combine with LabelC for convenience */
-    DecisionTree combine(const LabelC& labelC, const Binary& op) const {
-      return combine(labelC.first, labelC.second, op);
+    DecisionTree combine(const LabelC& labelC, const Binary& op,
+        bool parallel = false) const {
+      return combine(labelC.first, labelC.second, op, parallel);
     }
 
     /** output to graphviz format, stream version */
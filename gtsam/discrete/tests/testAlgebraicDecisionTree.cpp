@@ -176,7 +176,7 @@ TEST(ADT, joint)
   dot(joint, "Asia-ASTLBEX");
   joint = apply(joint, pD, &mul);
   dot(joint, "Asia-ASTLBEXD");
-  EXPECT_LONGS_EQUAL(346, (long)muls);
+  EXPECT_LONGS_EQUAL(308, (long)muls); // shared subtrees are multiplied once
   printCounts("Asia joint");
 
   ADT pASTL = pA;
@@ -227,7 +227,7 @@ TEST(ADT, inference)
   dot(joint, "Joint-Product-ASTLBEX");
   joint = apply(joint, pD, &mul);
   dot(joint, "Joint-Product-ASTLBEXD");
-  EXPECT_LONGS_EQUAL(370, (long)muls); // different ordering
+  EXPECT_LONGS_EQUAL(308, (long)muls); // different ordering
   printCounts("Asia product");
 
   ADT marginal = joint;
@@ -239,7 +239,7 @@ TEST(ADT, inference)
   dot(marginal, "Joint-Sum-ADBLE");
   marginal = marginal.combine(E, &add_);
   dot(marginal, "Joint-Sum-ADBL");
-  EXPECT_LONGS_EQUAL(161, (long)adds);
+  EXPECT_LONGS_EQUAL(150, (long)adds);
   printCounts("Asia sum");
 }
 
@@ -268,7 +268,7 @@ TEST(ADT, factor_graph)
   fg = apply(fg, pX, &mul);
   fg = apply(fg, pD, &mul);
   dot(fg, "FactorGraph");
-  EXPECT_LONGS_EQUAL(158, (long)muls);
+  EXPECT_LONGS_EQUAL(130, (long)muls);
   printCounts("Asia FG");
 
   fg = fg.combine(X, &add_);
@@ -516,6 +516,90 @@ TEST(ADT, zero)
   EXPECT_DOUBLES_EQUAL(0, anotb(x11), 1e-9);
 }
 
+/* ******************************************************************************** */
+// Test that identical subtrees of a result are shared
+TEST(ADT, sharing)
+{
+  DiscreteKey A(2,2), B(1,2), C(0,2);
+
+  // The two C subtrees of f are distinct nodes with the same values
+  ADT f(A & C, "3 4 3 4"), g(B, 1, 2);
+  ADT h = f * g;
+  ADT expected(A & B & C, "3 4 6 8 3 4 6 8");
+  EXPECT(assert_equal(expected, h));
+
+  // In h, they are the same node
+  typedef ADT::Choice Choice;
+  boost::shared_ptr<const Choice> root =
+      boost::dynamic_pointer_cast<const Choice>(h.root_);
+  CHECK(root);
+  EXPECT_LONGS_EQUAL(2, root->nrChoices());
+  EXPECT(root->branches()[0] == root->branches()[1]);
+}
+
+/* ******************************************************************************** */
+// Test product and sum of a chain of factors against brute force
+TEST(ADT, chain)
+{
+  const size_t n = 12;
+  vector<DiscreteKey> keys;
+  for (size_t i = 0; i < n; i++)
+    keys.push_back(DiscreteKey(i, 2));
+
+  vector<ADT> factors;
+  ADT product; // 1.0
+  for (size_t i = 0; i + 1 < n; i++) {
+    vector<double> table;
+    table += 1.0 + i, 2.0, 0.5, 1.0 + 0.1 * i;
+    factors.push_back(ADT(keys[i] & keys[i + 1], table));
+    product = product * factors.back();
+  }
+
+  // sum out a key in the middle of the tree, and compare with choose/apply
+  const Key middle = n / 2;
+  ADT actual = product.sum(middle, 2);
+  ADT expected = ADT(product.choose(middle, 0)) + ADT(product.choose(middle, 1));
+  EXPECT(assert_equal(expected, actual));
+
+  for (size_t j = 0; j < (1u << n); j++) {
+    Assignment<Key> x;
+    for (size_t i = 0; i < n; i++)
+      x[i] = (j >> i) & 1;
+    double value = 1.0;
+    for (const ADT& factor: factors)
+      value *= factor(x);
+    EXPECT_DOUBLES_EQUAL(value, product(x), 1e-9);
+    if (x[middle] == 0) {
+      Assignment<Key> x1 = x;
+      x1[middle] = 1;
+      EXPECT_DOUBLES_EQUAL(product(x) + product(x1), actual(x), 1e-9);
+    }
+  }
+}
+
+/* ******************************************************************************** */
+// Parallel apply and combine are opt-in, and agree with the sequential ones.
+// Without TBB they are the sequential ones.
+TEST(ADT, parallel)
+{
+  // Trees with all values distinct, large enough to be split over threads
+  const size_t n = 13;
+  vector<DiscreteKey> keys;
+  for (size_t i = 0; i < n; i++)
+    keys.push_back(DiscreteKey(i, 2));
+  vector<double> table1, table2;
+  for (size_t j = 0; j < (1u << n); j++) {
+    table1.push_back(1.0 + j);
+    table2.push_back(1.0 / (2.0 + j));
+  }
+  const ADT f(keys, table1), g(keys, table2);
+
+  EXPECT(assert_equal(ADT(f.apply(g, &ADT::Ring::mul)),
+                      ADT(f.apply(g, &ADT::Ring::mul, true))));
+  EXPECT(assert_equal(ADT(f.combine(n / 2, 2, &ADT::Ring::add)),
+                      ADT(f.combine(n / 2, 2, &ADT::Ring::add, true))));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
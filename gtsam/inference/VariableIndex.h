@@ -31,6 +31,8 @@
 
 namespace gtsam {
 
+class BinaryInArchive;
+
 /**
  * The VariableIndex class computes and stores the block column structure of a
  * factor graph.  The factor graph stores a collection of factors, each of
@@ -183,6 +185,10 @@ protected:
   }
 
   /// @}
+
+private:
+  /// Restores the index exactly, including the order of the factor indices
+  friend void readBinary(BinaryInArchive& ar, VariableIndex& variableIndex);
 };
 
 /// traits
@@ -0,0 +1,262 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FixedKalmanFilter.h
+ * @date October 2026
+ * @brief Dense Kalman filter with a compile-time state dimension
+ */
+
+#pragma once
+
+#include <gtsam/linear/KalmanFilter.h>
+
+#include <boost/make_shared.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+namespace gtsam {
+
+/**
+ * Kalman filter for a state of compile-time dimension N.
+ *
+ * KalmanFilter builds and eliminates a small factor graph in every step, which
+ * for small states, e.g. a 15-dimensional INS filter at a few hundred Hz, costs
+ * far more than the math itself. This filter does the textbook dense equations
+ * on fixed-size Eigen matrices instead, so predict and update do not allocate.
+ * Like KalmanFilter, it is functional: states go in, new states come out.
+ *
+ * There are two parametrizations of the state, with the same methods:
+ * - State, mean and covariance: cheap predict, update solves an MxM system
+ *   for M-dimensional measurements (Joseph form, to keep P symmetric PSD).
+ * - InformationState, information vector and matrix: update is a cheap
+ *   addition, which pays off with many measurements per predict.
+ *
+ * The predictExtended and updateExtended variants take the prediction and
+ * measurement error of a nonlinear model, with its Jacobian, as in an EKF.
+ * Both states convert to and from KalmanFilter::State, so the filters can be
+ * mixed, e.g. to use KalmanFilter for states whose dimension varies.
+ */
+template<int N>
+class FixedKalmanFilter {
+public:
+
+  // Unaligned, so states can be stored anywhere without aligned allocation
+  typedef Eigen::Matrix<double, N, 1, Eigen::DontAlign> VectorN;
+  typedef Eigen::Matrix<double, N, N, Eigen::DontAlign> MatrixN;
+
+  /// Mean and covariance, i.e., x_{t|t} and P_{t|t}, at step k
+  struct State {
+    Key k;
+    VectorN x;
+    MatrixN P;
+  };
+
+  /// Information vector eta = P^-1 x and matrix Lambda = P^-1, at step k
+  struct InformationState {
+    Key k;
+    VectorN eta;
+    MatrixN Lambda;
+  };
+
+private:
+
+  typedef Eigen::Matrix<double, N, 1> Vec;
+  typedef Eigen::Matrix<double, N, N> Mat;
+
+  static State MakeCovariance(Key k, const Vec& x, const Mat& P) {
+    State p;
+    p.k = k;
+    p.x = x;
+    p.P = 0.5 * (P + P.transpose());
+    return p;
+  }
+
+  static InformationState MakeInformation(Key k, const Vec& eta,
+                                          const Mat& Lambda) {
+    InformationState p;
+    p.k = k;
+    p.eta = eta;
+    p.Lambda = 0.5 * (Lambda + Lambda.transpose());
+    return p;
+  }
+
+  /// Update with the measurement error Hx - b of a linear model
+  template<int M>
+  static State Update(const State& p, const Eigen::Matrix<double, M, N>& H,
+                      const Eigen::Matrix<double, M, 1>& error,
+                      const Eigen::Matrix<double, M, M>& R) {
+    const Mat P = p.P;
+    const Eigen::Matrix<double, N, M> PHt = P * H.transpose();
+    const Eigen::Matrix<double, M, M> S = H * PHt + R;
+    const Eigen::Matrix<double, N, M> K =
+        S.llt().solve(PHt.transpose()).transpose();
+    const Mat I_KH = Mat::Identity() - K * H;
+    return MakeCovariance(p.k, Vec(p.x) - K * error,
+                          I_KH * P * I_KH.transpose() + K * R * K.transpose());
+  }
+
+public:
+
+  /// Create initial state, i.e., x_{0|0} and P_{0|0}
+  State init(const VectorN& x0, const MatrixN& P0) const {
+    return MakeCovariance(0, Vec(x0), Mat(P0));
+  }
+
+  /// print
+  void print(const std::string& s = "") const {
+    std::cout << "FixedKalmanFilter " << s << ", dim = " << N << std::endl;
+  }
+
+  /** Return step index k, starts at 0, incremented at each predict. */
+  static Key step(const State& p) { return p.k; }
+  static Key step(const InformationState& p) { return p.k; }
+
+  /// @name Conversions
+  /// @{
+
+  /// Convert to the information form
+  static InformationState ToInformation(const State& p) {
+    const Mat Lambda = Mat(p.P).inverse();
+    return MakeInformation(p.k, Lambda * Vec(p.x), Lambda);
+  }
+
+  /// Convert to the covariance form
+  static State ToCovariance(const InformationState& p) {
+    const Eigen::LLT<Mat> llt{Mat(p.Lambda)};
+    return MakeCovariance(p.k, llt.solve(Vec(p.eta)),
+                          llt.solve(Mat::Identity()));
+  }
+
+  /// Convert to the square-root information form of KalmanFilter
+  static KalmanFilter::State ToDensity(const InformationState& p) {
+    const Eigen::LLT<Mat> llt{Mat(p.Lambda)};
+    const Matrix R = llt.matrixU();
+    const Vector d = llt.matrixL().solve(Vec(p.eta));
+    return boost::make_shared<GaussianDensity>(p.k, d, R);
+  }
+
+  /// Convert to the square-root information form of KalmanFilter
+  static KalmanFilter::State ToDensity(const State& p) {
+    return ToDensity(ToInformation(p));
+  }
+
+  /// Convert from KalmanFilter, throws std::invalid_argument on dimension mismatch
+  static InformationState FromDensity(const KalmanFilter::State& p) {
+    if (p->rows() != N)
+      throw std::invalid_argument(
+          "FixedKalmanFilter::FromDensity: dimension mismatch");
+    const Mat Lambda = p->information();
+    return MakeInformation(p->firstFrontalKey(), Lambda * Vec(p->mean()),
+                           Lambda);
+  }
+
+  /// @}
+  /// @name Covariance form
+  /// @{
+
+  /**
+   * Predict the state P(x_{t+1}|Z^t), i.e., x_{t+1|t} and P_{t+1|t}, for
+   * the motion model x_{t+1} = F*x_{t} + B*u_{t} + w, with w ~ N(0, Q)
+   */
+  template<int C>
+  State predictQ(const State& p, const MatrixN& F,
+                 const Eigen::Matrix<double, N, C>& B,
+                 const Eigen::Matrix<double, C, 1>& u, const MatrixN& Q) const {
+    const Mat F_ = F;
+    return MakeCovariance(p.k + 1, F_ * Vec(p.x) + B * u,
+                          F_ * Mat(p.P) * F_.transpose() + Mat(Q));
+  }
+
+  /**
+   * Predict with a nonlinear motion model x_{t+1} = f(x_{t}) + w,
+   * given the prediction fx = f(x_{t|t}) and its Jacobian F
+   */
+  State predictExtended(const State& p, const VectorN& fx, const MatrixN& F,
+                        const MatrixN& Q) const {
+    const Mat F_ = F;
+    return MakeCovariance(p.k + 1, Vec(fx),
+                          F_ * Mat(p.P) * F_.transpose() + Mat(Q));
+  }
+
+  /**
+   * Update with a measurement z_{t} = H*x_{t} + v, with v ~ N(0, R). As in
+   * KalmanFilter::updateQ, the measurement covariance is the last argument.
+   */
+  template<int M>
+  State updateQ(const State& p, const Eigen::Matrix<double, M, N>& H,
+                const Eigen::Matrix<double, M, 1>& z,
+                const Eigen::Matrix<double, M, M>& R) const {
+    return Update<M>(p, H, H * Vec(p.x) - z, R);
+  }
+
+  /**
+   * Update with a nonlinear measurement z_{t} = h(x_{t}) + v, given the
+   * error h(x_{t|t-1}) - z_{t}, as returned by evaluateError, and its
+   * Jacobian H
+   */
+  template<int M>
+  State updateExtended(const State& p, const Eigen::Matrix<double, M, N>& H,
+                       const Eigen::Matrix<double, M, 1>& error,
+                       const Eigen::Matrix<double, M, M>& R) const {
+    return Update<M>(p, H, error, R);
+  }
+
+  /// @}
+  /// @name Information form
+  /// @{
+
+  /// Predict, as predictQ for the covariance form
+  template<int C>
+  InformationState predictQ(const InformationState& p, const MatrixN& F,
+                            const Eigen::Matrix<double, N, C>& B,
+                            const Eigen::Matrix<double, C, 1>& u,
+                            const MatrixN& Q) const {
+    return ToInformation(predictQ<C>(ToCovariance(p), F, B, u, Q));
+  }
+
+  /// Predict, as predictExtended for the covariance form
+  InformationState predictExtended(const InformationState& p,
+                                   const VectorN& fx, const MatrixN& F,
+                                   const MatrixN& Q) const {
+    return ToInformation(predictExtended(ToCovariance(p), fx, F, Q));
+  }
+
+  /// Update, as updateQ for the covariance form, by adding H^T R^-1 H to Lambda
+  template<int M>
+  InformationState updateQ(const InformationState& p,
+                           const Eigen::Matrix<double, M, N>& H,
+                           const Eigen::Matrix<double, M, 1>& z,
+                           const Eigen::Matrix<double, M, M>& R) const {
+    const Eigen::Matrix<double, N, M> HtRinv =
+        R.llt().solve(H).transpose();
+    return MakeInformation(p.k, Vec(p.eta) + HtRinv * z,
+                           Mat(p.Lambda) + HtRinv * H);
+  }
+
+  /**
+   * Update, as updateExtended for the covariance form. The error is
+   * linearized around the mean, which is recovered from the information form.
+   */
+  template<int M>
+  InformationState updateExtended(const InformationState& p,
+                                  const Eigen::Matrix<double, M, N>& H,
+                                  const Eigen::Matrix<double, M, 1>& error,
+                                  const Eigen::Matrix<double, M, M>& R) const {
+    const Vec x = Mat(p.Lambda).llt().solve(Vec(p.eta));
+    return updateQ<M>(p, H, H * x - error, R);
+  }
+
+  /// @}
+};
+
+} // \namespace gtsam
@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FixedWhitener.h
+ * @date October 2026
+ * @brief Whitening of fixed-dimension systems without virtual calls
+ */
+
+#pragma once
+
+#include <gtsam/linear/NoiseModel.h>
+
+#include <typeinfo>
+
+namespace gtsam {
+namespace noiseModel {
+
+/**
+ * Whitens systems [A b] with a compile-time number of rows D, as in the
+ * linearization of an ExpressionFactor with a fixed-size measurement, or of a
+ * BetweenFactor or PriorFactor on a fixed-size VALUE.
+ *
+ * The type of the noise model is resolved once, in the constructor: Unit,
+ * Isotropic, Diagonal and Gaussian models are copied into fixed-size storage
+ * and applied inline. Any other model (Constrained, Robust, user-defined
+ * models, or D == Eigen::Dynamic) falls back to the virtual WhitenSystem.
+ */
+template<int D>
+class FixedWhitener {
+public:
+
+  /// The noise models that are whitened inline
+  enum Kind { UNIT, ISOTROPIC, DIAGONAL, GAUSSIAN, VIRTUAL };
+
+private:
+
+  // Unaligned, so factors holding a FixedWhitener need no aligned allocation
+  typedef Eigen::Matrix<double, D, 1, Eigen::DontAlign> VectorD;
+  typedef Eigen::Matrix<double, D, D, Eigen::DontAlign> MatrixD;
+
+  Kind kind_;
+  double invsigma_;
+  VectorD invsigmas_;
+  MatrixD R_;
+  SharedNoiseModel model_;
+
+  /// Whiten the D rows of M in place, for the kinds that are whitened inline
+  template<class BLOCK>
+  void whitenRows(BLOCK& M) const {
+    switch (kind_) {
+      case ISOTROPIC:
+        M *= invsigma_;
+        break;
+      case DIAGONAL:
+        M.array().colwise() *= invsigmas_.array();
+        break;
+      case GAUSSIAN:
+        // Column by column through a fixed-size copy, so nothing is allocated
+        for (Eigen::Index j = 0; j < M.cols(); ++j) {
+          const Eigen::Matrix<double, D, 1> column = M.col(j);
+          M.col(j).noalias() = R_ * column;
+        }
+        break;
+      case UNIT:
+      case VIRTUAL:
+        break;
+    }
+  }
+
+public:
+
+  /// Default constructor, whitens nothing
+  FixedWhitener() : kind_(UNIT), invsigma_(1.0) {}
+
+  /// Resolve the type of the noise model, which may be null (no whitening)
+  explicit FixedWhitener(const SharedNoiseModel& model)
+      : kind_(VIRTUAL), invsigma_(1.0), model_(model) {
+    if (!model) {
+      kind_ = UNIT;
+      return;
+    }
+    if (D == Eigen::Dynamic || static_cast<int>(model->dim()) != D) return;
+
+    // Exact types only, derived models may whiten differently
+    const std::type_info& type = typeid(*model);
+    if (type == typeid(Unit)) {
+      kind_ = UNIT;
+    } else if (type == typeid(Isotropic)) {
+      kind_ = ISOTROPIC;
+      invsigma_ = static_cast<const Isotropic&>(*model).invsigma(0);
+    } else if (type == typeid(Diagonal)) {
+      kind_ = DIAGONAL;
+      invsigmas_ = static_cast<const Diagonal&>(*model).invsigmas();
+    } else if (type == typeid(Gaussian)) {
+      kind_ = GAUSSIAN;
+      R_ = static_cast<const Gaussian&>(*model).R();
+    }
+  }
+
+  /// How the system is whitened
+  Kind kind() const { return kind_; }
+
+  /**
+   * Whiten the system Ab in place, with the right-hand side as last column.
+   * @return the norm of the whitened right-hand side if \c norm is true
+   */
+  double whitenSystem(Matrix& Ab, bool norm = false) const {
+    if (kind_ == VIRTUAL) {
+      Vector b = Ab.rightCols<1>();  // need b to be valid for Robust noise models
+      model_->WhitenSystem(Ab, b);
+      return norm ? b.norm() : 0.0;
+    }
+    assert(D == Eigen::Dynamic || Ab.rows() == D);
+    Eigen::Block<Matrix, D, Eigen::Dynamic> block(Ab, 0, 0, Ab.rows(),
+                                                  Ab.cols());
+    whitenRows(block);
+    return norm ? block.template rightCols<1>().norm() : 0.0;
+  }
+
+  /// Whiten the system given as separate Jacobians A and right-hand side b
+  void whitenSystem(std::vector<Matrix>& A, Vector& b) const {
+    if (kind_ == VIRTUAL) {
+      model_->WhitenSystem(A, b);
+      return;
+    }
+    assert(D == Eigen::Dynamic || b.rows() == D);
+    for (Matrix& Aj : A) {
+      Eigen::Block<Matrix, D, Eigen::Dynamic> block(Aj, 0, 0, Aj.rows(),
+                                                    Aj.cols());
+      whitenRows(block);
+    }
+    Eigen::Map<Eigen::Matrix<double, D, 1> > bD(b.data(), b.rows());
+    whitenRows(bD);
+  }
+};
+
+} // namespace noiseModel
+} // namespace gtsam
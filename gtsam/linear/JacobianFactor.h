@@ -370,6 +370,7 @@ namespace gtsam {
 
     // be very selective on who can access these private methods:
     template<typename T> friend class ExpressionFactor;
+    template<typename T> friend class ExpressionFactorGroup;
 
     /** Serialization function */
     friend class boost::serialization::access;
@@ -37,6 +37,9 @@ namespace gtsam {
  *
  * The filter is functional, in that it does not have state: you call init() to create
  * an initial state, then predict() and update() that create new states out of an old state.
+ *
+ * For small states of known dimension, FixedKalmanFilter does the same without
+ * building and eliminating a factor graph in every step.
  */
 class GTSAM_EXPORT KalmanFilter {
 
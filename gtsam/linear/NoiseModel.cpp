@@ -622,23 +622,37 @@ void Unit::print(const std::string& name) const {
 
 namespace mEstimator {
 
+// Batched weights are computed with Eigen array expressions on the raw arrays
+typedef Eigen::Map<const Eigen::ArrayXd> ConstErrors;
+typedef Eigen::Map<Eigen::ArrayXd> Weights;
+
 Vector Base::weight(const Vector& error) const {
   const size_t n = error.rows();
   Vector w(n);
-  for (size_t i = 0; i < n; ++i)
-    w(i) = weight(error(i));
+  weights(error.data(), w.data(), n);
   return w;
 }
 
-// The following three functions re-weight block matrices and a vector
-// according to their weight implementation
+void Base::weights(const double* errors, double* w, size_t n) const {
+  for (size_t i = 0; i < n; ++i)
+    w[i] = weight(errors[i]);
+}
+
+void Base::sqrtWeights(const double* errors, double* w, size_t n) const {
+  weights(errors, w, n);
+  Weights(w, n) = Weights(w, n).sqrt();
+}
+
+// The following functions re-weight block matrices and a vector according to
+// their weight implementation. The Scalar scheme computes the weights of all
+// rows in one batched call.
 
 void Base::reweight(Vector& error) const {
   if (reweight_ == Block) {
     const double w = sqrtWeight(error.norm());
     error *= w;
   } else {
-    error.array() *= weight(error).cwiseSqrt().array();
+    error.array() *= sqrtWeight(error).array();
   }
 }
 
@@ -712,6 +726,10 @@ void Base::reweight(Matrix &A1, Matrix &A2, Matrix &A3, Vector &error) const {
 // Null model
 /* ************************************************************************* */
 
+void Null::weights(const double* /*errors*/, double* w, size_t n) const {
+  Weights(w, n).setOnes();
+}
+
 void Null::print(const std::string &s="") const
 { cout << s << "null ()" << endl; }
 
@@ -728,6 +746,11 @@ Fair::Fair(double c, const ReweightScheme reweight) : Base(reweight), c_(c) {
 // Fair
 /* ************************************************************************* */
 
+void Fair::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = 1.0 / (1.0 + e.abs() / c_);
+}
+
 void Fair::print(const std::string &s="") const
 { cout << s << "fair (" << c_ << ")" << endl; }
 
@@ -750,6 +773,11 @@ Huber::Huber(double k, const ReweightScheme reweight) : Base(reweight), k_(k) {
   }
 }
 
+void Huber::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = (e.abs() < k_).select(1.0, k_ / e.abs());
+}
+
 void Huber::print(const std::string &s="") const {
   cout << s << "huber (" << k_ << ")" << endl;
 }
@@ -774,6 +802,11 @@ Cauchy::Cauchy(double k, const ReweightScheme reweight) : Base(reweight), k_(k),
   }
 }
 
+void Cauchy::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = ksquared_ / (ksquared_ + e * e);
+}
+
 void Cauchy::print(const std::string &s="") const {
   cout << s << "cauchy (" << k_ << ")" << endl;
 }
@@ -793,6 +826,12 @@ Cauchy::shared_ptr Cauchy::Create(double c, const ReweightScheme reweight) {
 /* ************************************************************************* */
 Tukey::Tukey(double c, const ReweightScheme reweight) : Base(reweight), c_(c), csquared_(c * c) {}
 
+void Tukey::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) =
+      (e.abs() <= c_).select((1.0 - e * e / csquared_).square(), 0.0);
+}
+
 void Tukey::print(const std::string &s="") const {
   std::cout << s << ": Tukey (" << c_ << ")" << std::endl;
 }
@@ -812,6 +851,11 @@ Tukey::shared_ptr Tukey::Create(double c, const ReweightScheme reweight) {
 /* ************************************************************************* */
 Welsch::Welsch(double c, const ReweightScheme reweight) : Base(reweight), c_(c), csquared_(c * c) {}
 
+void Welsch::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = (-(e * e) / csquared_).exp();
+}
+
 void Welsch::print(const std::string &s="") const {
   std::cout << s << ": Welsch (" << c_ << ")" << std::endl;
 }
@@ -858,6 +902,13 @@ double GemanMcClure::weight(double error) const {
   return c4/(c2error*c2error);
 }
 
+void GemanMcClure::weights(const double* errors, double* w, size_t n) const {
+  const double c2 = c_*c_;
+  const double c4 = c2*c2;
+  const ConstErrors e(errors, n);
+  Weights(w, n) = c4 / (c2 + e * e).square();
+}
+
 void GemanMcClure::print(const std::string &s="") const {
   std::cout << s << ": Geman-McClure (" << c_ << ")" << std::endl;
 }
@@ -890,6 +941,11 @@ double DCS::weight(double error) const {
   return 1.0;
 }
 
+void DCS::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = (e * e > c_).select((2.0 * c_ / (c_ + e * e)).square(), 1.0);
+}
+
 void DCS::print(const std::string &s="") const {
   std::cout << s << ": DCS (" << c_ << ")" << std::endl;
 }
@@ -914,6 +970,12 @@ L2WithDeadZone::L2WithDeadZone(double k, const ReweightScheme reweight) : Base(r
   }
 }
 
+void L2WithDeadZone::weights(const double* errors, double* w, size_t n) const {
+  const ConstErrors e(errors, n);
+  Weights(w, n) = (e.abs() <= k_).select(
+      0.0, (e > k_).select((-k_ + e) / e, (k_ + e) / e));
+}
+
 void L2WithDeadZone::print(const std::string &s="") const {
   std::cout << s << ": L2WithDeadZone (" << k_ << ")" << std::endl;
 }
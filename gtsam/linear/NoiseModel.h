@@ -687,6 +687,13 @@ namespace gtsam {
          */
         virtual double weight(double error) const = 0;
 
+        /**
+         * Batched weight function, w[i] = weight(errors[i]) for i < n.
+         * The M-estimators below override this with a vectorized kernel, so
+         * reweighting many residuals costs one virtual call rather than n.
+         */
+        virtual void weights(const double* errors, double* w, size_t n) const;
+
         virtual void print(const std::string &s) const = 0;
         virtual bool equals(const Base& expected, double tol=1e-8) const = 0;
 
@@ -698,11 +705,19 @@ namespace gtsam {
         * robust function */
         Vector weight(const Vector &error) const;
 
-        /** square root version of the weight function */
+        /** square root version of the weight function, see sqrtWeights */
         Vector sqrtWeight(const Vector &error) const {
-          return weight(error).cwiseSqrt();
+          Vector w(error.rows());
+          sqrtWeights(error.data(), w.data(), error.rows());
+          return w;
         }
 
+        /** batched square root version of the weight function */
+        void sqrtWeights(const double* errors, double* w, size_t n) const;
+
+        /// How the rows of a system are reweighted
+        ReweightScheme reweightScheme() const { return reweight_; }
+
         /** reweight block matrices and a vector according to their weight implementation */
         void reweight(Vector &error) const;
         void reweight(std::vector<Matrix> &A, Vector &error) const;
@@ -727,6 +742,7 @@ namespace gtsam {
         Null(const ReweightScheme reweight = Block) : Base(reweight) {}
         virtual ~Null() {}
         virtual double weight(double /*error*/) const { return 1.0; }
+        virtual void weights(const double* errors, double* w, size_t n) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& /*expected*/, double /*tol*/) const { return true; }
         static shared_ptr Create() ;
@@ -752,10 +768,14 @@ namespace gtsam {
         double weight(double error) const {
           return 1.0 / (1.0 + std::abs(error) / c_);
         }
+        void weights(const double* errors, double* w, size_t n) const;
         void print(const std::string &s) const;
         bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double c, const ReweightScheme reweight = Block) ;
 
+        /// The parameter c
+        double modelParameter() const { return c_; }
+
       private:
         /** Serialization function */
         friend class boost::serialization::access;
@@ -779,10 +799,14 @@ namespace gtsam {
           double absError = std::abs(error);
           return (absError < k_) ? (1.0) : (k_ / absError);
         }
+        void weights(const double* errors, double* w, size_t n) const;
         void print(const std::string &s) const;
         bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The parameter k
+        double modelParameter() const { return k_; }
+
       private:
         /** Serialization function */
         friend class boost::serialization::access;
@@ -809,10 +833,14 @@ namespace gtsam {
         double weight(double error) const {
           return ksquared_ / (ksquared_ + error*error);
         }
+        void weights(const double* errors, double* w, size_t n) const;
         void print(const std::string &s) const;
         bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The parameter k
+        double modelParameter() const { return k_; }
+
       private:
         /** Serialization function */
         friend class boost::serialization::access;
@@ -839,10 +867,17 @@ namespace gtsam {
           }
           return 0.0;
         }
+        void weights(const double* errors, double* w, size_t n) const;
         void print(const std::string &s) const;
         bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The threshold c
+        double modelParameter() const { return c_; }
+
+        /// Change the threshold c in place, e.g., for graduated non-convexity
+        void setModelParameter(double c) { c_ = c; csquared_ = c * c; }
+
       private:
         /** Serialization function */
         friend class boost::serialization::access;
@@ -866,10 +901,14 @@ namespace gtsam {
           double xc2 = (error*error)/csquared_;
           return std::exp(-xc2);
         }
+        void weights(const double* errors, double* w, size_t n) const;
         void print(const std::string &s) const;
         bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The parameter c
+        double modelParameter() const { return c_; }
+
       private:
         /** Serialization function */
         friend class boost::serialization::access;
@@ -925,10 +964,17 @@ namespace gtsam {
         GemanMcClure(double c = 1.0, const ReweightScheme reweight = Block);
         virtual ~GemanMcClure() {}
         virtual double weight(double error) const;
+        virtual void weights(const double* errors, double* w, size_t n) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The scale c
+        double modelParameter() const { return c_; }
+
+        /// Change the scale c in place, e.g., for graduated non-convexity
+        void setModelParameter(double c) { c_ = c; }
+
       protected:
         double c_;
 
@@ -954,10 +1000,14 @@ namespace gtsam {
         DCS(double c = 1.0, const ReweightScheme reweight = Block);
         virtual ~DCS() {}
         virtual double weight(double error) const;
+        virtual void weights(const double* errors, double* w, size_t n) const;
         virtual void print(const std::string &s) const;
         virtual bool equals(const Base& expected, double tol=1e-8) const;
         static shared_ptr Create(double k, const ReweightScheme reweight = Block) ;
 
+        /// The parameter c
+        double modelParameter() const { return c_; }
+
       protected:
         double c_;
 
@@ -996,10 +1046,14 @@ namespace gtsam {
             else if (error > k_) return (-k_+error)/error;
             else return (k_+error)/error;
           }
+          void weights(const double* errors, double* w, size_t n) const;
           void print(const std::string &s) const;
           bool equals(const Base& expected, double tol=1e-8) const;
           static shared_ptr Create(double k, const ReweightScheme reweight = Block);
 
+          /// The parameter k
+          double modelParameter() const { return k_; }
+
       private:
           /** Serialization function */
           friend class boost::serialization::access;
@@ -18,6 +18,7 @@
  */
 
 #include <gtsam/linear/KalmanFilter.h>
+#include <gtsam/linear/FixedKalmanFilter.h>
 #include <gtsam/linear/NoiseModel.h>
 #include <gtsam/base/Testable.h>
 #include <CppUnitLite/TestHarness.h>
@@ -286,6 +287,90 @@ TEST( KalmanFilter, QRvsCholesky ) {
   EXPECT(assert_equal(expected2, pb3->covariance(), 1e-7));
 }
 
+/* ************************************************************************* */
+// The fixed-size filter agrees with KalmanFilter, in both of its forms
+TEST( FixedKalmanFilter, predictUpdate ) {
+
+  // Create dynamics and measurement model
+  Matrix3 F;
+  F << 1.0, 0.1, 0.0, 0.2, 1.1, 0.3, 0.0, -0.1, 0.9;
+  Eigen::Matrix<double, 3, 2> B;
+  B << 1.0, 0.1, 0.2, 1.1, 1.2, 0.8;
+  const Vector2 u(1.0, -2.0);
+  Matrix3 Q;
+  Q << 0.2, 0.01, 0.0, 0.01, 0.1, 0.02, 0.0, 0.02, 0.3;
+  Matrix23 H;
+  H << 1.0, 0.0, 0.5, 0.0, 2.0, -1.0;
+  const Vector2 z(0.3, -0.7);
+  const Matrix2 R = (Matrix2() << 0.5, 0.1, 0.1, 0.4).finished();
+
+  KalmanFilter kf(3);
+  FixedKalmanFilter<3> fkf;
+  typedef FixedKalmanFilter<3> Filter;
+
+  const Vector3 x0(1.0, 2.0, 3.0);
+  const Matrix3 P0 = 0.1 * I_3x3 + 0.01 * Matrix3::Ones();
+  KalmanFilter::State p = kf.init(x0, P0);
+  Filter::State q = fkf.init(x0, P0);
+  Filter::InformationState r = Filter::ToInformation(q);
+
+  for (size_t k = 0; k < 3; k++) {
+    p = kf.updateQ(kf.predictQ(p, F, B, u, Q), H, z, R);
+    q = fkf.updateQ(fkf.predictQ(q, F, B, u, Q), H, z, R);
+    r = fkf.updateQ(fkf.predictQ(r, F, B, u, Q), H, z, R);
+    EXPECT(assert_equal(p->mean(), Vector(q.x), 1e-9));
+    EXPECT(assert_equal(p->covariance(), Matrix(q.P), 1e-9));
+    EXPECT(assert_equal(p->information(), Matrix(r.Lambda), 1e-9));
+    EXPECT(assert_equal(Vector(p->information() * p->mean()), Vector(r.eta),
+                        1e-9));
+  }
+  LONGS_EQUAL(3, (long)Filter::step(q));
+  LONGS_EQUAL(3, (long)Filter::step(r));
+
+  // Conversion to and from KalmanFilter::State
+  const KalmanFilter::State density = Filter::ToDensity(q);
+  LONGS_EQUAL(3, (long)KalmanFilter::step(density));
+  EXPECT(assert_equal(p->mean(), density->mean(), 1e-9));
+  EXPECT(assert_equal(p->information(), density->information(), 1e-9));
+  const Filter::InformationState fromDensity = Filter::FromDensity(p);
+  EXPECT(assert_equal(Matrix(r.Lambda), Matrix(fromDensity.Lambda), 1e-9));
+  CHECK_EXCEPTION(FixedKalmanFilter<2>::FromDensity(p), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+// A linear model given to the extended versions gives the same result
+TEST( FixedKalmanFilter, extended ) {
+  Matrix2 F;
+  F << 1.0, 0.1, 0.0, 1.0;
+  const Matrix2 Q = 0.01 * I_2x2;
+  Matrix12 H;
+  H << 1.0, 0.5;
+  const Vector1 z(0.4);
+  const Matrix1 R = 0.1 * I_1x1;
+
+  typedef FixedKalmanFilter<2> Filter;
+  Filter fkf;
+  const Filter::State p0 = fkf.init(Vector2(1.0, -1.0), I_2x2);
+  const Matrix21 B = Matrix21::Zero();
+  const Vector1 u = Vector1::Zero();
+  const Filter::State expected =
+      fkf.updateQ(fkf.predictQ(p0, F, B, u, Q), H, z, R);
+
+  // The error h(x) - z is evaluated at the predicted mean
+  const Filter::State p1 = fkf.predictExtended(p0, F * p0.x, F, Q);
+  const Vector1 error = H * p1.x - z;
+  const Filter::State actual = fkf.updateExtended(p1, H, error, R);
+  EXPECT(assert_equal(Vector(expected.x), Vector(actual.x), 1e-9));
+  EXPECT(assert_equal(Matrix(expected.P), Matrix(actual.P), 1e-9));
+
+  const Filter::InformationState r1 =
+      fkf.predictExtended(Filter::ToInformation(p0), F * p0.x, F, Q);
+  const Filter::State fromInformation =
+      Filter::ToCovariance(fkf.updateExtended(r1, H, error, R));
+  EXPECT(assert_equal(Vector(expected.x), Vector(fromInformation.x), 1e-9));
+  EXPECT(assert_equal(Matrix(expected.P), Matrix(fromInformation.P), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -18,6 +18,7 @@
 
 
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/FixedWhitener.h>
 #include <gtsam/base/TestableAssertions.h>
 
 #include <CppUnitLite/TestHarness.h>
@@ -643,6 +644,103 @@ TEST(NoiseModel, NonDiagonalGaussian)
   }
 }
 
+/* ************************************************************************* */
+// The batched weights agree with the scalar weight function
+TEST(NoiseModel, robustFunctionBatchedWeights)
+{
+  const Vector errors = (Vector(9) << 0.0, 0.3, -0.3, 1.0, -1.2, 2.5, -4.0,
+                         10.0, -20.0).finished();
+  vector<mEstimator::Base::shared_ptr> estimators;
+  estimators += mEstimator::Null::Create(), mEstimator::Fair::Create(1.4),
+      mEstimator::Huber::Create(1.345), mEstimator::Cauchy::Create(0.5),
+      mEstimator::Tukey::Create(4.6851), mEstimator::Welsch::Create(2.9846),
+      mEstimator::GemanMcClure::Create(1.0), mEstimator::DCS::Create(1.0),
+      mEstimator::L2WithDeadZone::Create(1.0);
+  for (const mEstimator::Base::shared_ptr& estimator : estimators) {
+    Vector weights(errors.size()), sqrtWeights(errors.size());
+    estimator->weights(errors.data(), weights.data(), errors.size());
+    estimator->sqrtWeights(errors.data(), sqrtWeights.data(), errors.size());
+    for (DenseIndex i = 0; i < errors.size(); i++) {
+      DOUBLES_EQUAL(estimator->weight(errors(i)), weights(i), 1e-12);
+      DOUBLES_EQUAL(estimator->sqrtWeight(errors(i)), sqrtWeights(i), 1e-12);
+    }
+  }
+}
+
+/* ************************************************************************* */
+// Whiten a random system with FixedWhitener<D> and with the virtual interface
+template<int D>
+static bool checkFixedWhitener(const SharedNoiseModel& model,
+                               typename FixedWhitener<D>::Kind expectedKind) {
+  FixedWhitener<D> whitener(model);
+  Matrix Ab = Matrix::Random(D, 4);
+  Matrix expected = Ab;
+  Vector b = Ab.rightCols<1>();
+  model->WhitenSystem(expected, b);
+  expected.rightCols<1>() = b;
+  const double norm = whitener.whitenSystem(Ab, true);
+  return whitener.kind() == expectedKind && assert_equal(expected, Ab, 1e-9) &&
+         fabs(norm - b.norm()) < 1e-9;
+}
+
+template<int D>
+static bool checkFixedWhiteners() {
+  typedef Eigen::Matrix<double, D, 1> VectorD;
+  typedef Eigen::Matrix<double, D, D> MatrixD;
+  const VectorD sigmas = VectorD::LinSpaced(0.5, 2.0);
+  const MatrixD L = MatrixD::Random().template triangularView<Eigen::Lower>();
+  const MatrixD covariance = L * L.transpose() + MatrixD::Identity();
+  return checkFixedWhitener<D>(Unit::Create(D), FixedWhitener<D>::UNIT) &&
+         checkFixedWhitener<D>(Isotropic::Sigma(D, 0.1),
+                               FixedWhitener<D>::ISOTROPIC) &&
+         checkFixedWhitener<D>(Diagonal::Sigmas(sigmas),
+                               FixedWhitener<D>::DIAGONAL) &&
+         checkFixedWhitener<D>(Gaussian::Covariance(covariance),
+                               FixedWhitener<D>::GAUSSIAN) &&
+         checkFixedWhitener<D>(
+             Robust::Create(mEstimator::Huber::Create(0.1),
+                            Isotropic::Sigma(D, 0.1)),
+             FixedWhitener<D>::VIRTUAL) &&
+         checkFixedWhitener<D>(Constrained::MixedSigmas(sigmas),
+                               FixedWhitener<D>::VIRTUAL);
+}
+
+TEST(NoiseModel, FixedWhitener)
+{
+  EXPECT(checkFixedWhiteners<2>());
+  EXPECT(checkFixedWhiteners<3>());
+  EXPECT(checkFixedWhiteners<6>());
+
+  // A model of the wrong dimension is whitened through the virtual interface
+  FixedWhitener<2> wrong(Isotropic::Sigma(3, 0.1));
+  EXPECT(wrong.kind() == FixedWhitener<2>::VIRTUAL);
+}
+
+/* ************************************************************************* */
+// Robust whitening with the Scalar scheme reweights each row by its own error
+TEST(NoiseModel, robustScalarWhitenSystem)
+{
+  const Vector3 sigmas(0.5, 1.0, 2.0);
+  const SharedNoiseModel robust = noiseModel::Robust::Create(
+      mEstimator::Huber::Create(1.345, mEstimator::Base::Scalar),
+      noiseModel::Diagonal::Sigmas(sigmas));
+  Matrix A = (Matrix(3, 2) << 1, 2, 3, 4, 5, 6).finished();
+  Vector b = Vector3(3.0, -0.5, 8.0);
+
+  Matrix expectedA = A;
+  Vector expectedb = b;
+  for (DenseIndex i = 0; i < 3; i++) {
+    const double whitened = b(i) / sigmas(i);
+    const double w = mEstimator::Huber(1.345).sqrtWeight(whitened);
+    expectedA.row(i) *= w / sigmas(i);
+    expectedb(i) = w * whitened;
+  }
+
+  robust->WhitenSystem(A, b);
+  EXPECT(assert_equal(expectedA, A, 1e-9));
+  EXPECT(assert_equal(expectedb, b, 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {  TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
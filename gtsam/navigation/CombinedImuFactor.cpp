@@ -121,6 +121,72 @@ void PreintegratedCombinedMeasurements::integrateMeasurement(
   preintMeasCov_ = F * preintMeasCov_ * F.transpose() + G_measCov_Gt;
 }
 
+//------------------------------------------------------------------------------
+void PreintegratedCombinedMeasurements::integrateMeasurements(
+    const double* measuredAccs, const double* measuredOmegas, const double* dts,
+    size_t n) {
+  typedef Eigen::Map<const Vector3> MapVector3;
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  if (!p().body_P_sensor) {
+    const Matrix3& aCov = p().accelerometerCovariance;
+    const Matrix3& wCov = p().gyroscopeCovariance;
+    const Matrix3& iCov = p().integrationCovariance;
+    const Matrix6& biasAccOmegaInt = p().biasAccOmegaInt;
+    const Matrix3 aCovInt = aCov + biasAccOmegaInt.block<3, 3>(0, 0);
+    const Matrix3 wCovInt = wCov + biasAccOmegaInt.block<3, 3>(3, 3);
+    UpdateJacobians J;
+    for (size_t k = 0; k < n; k++) {
+      const double dt = dts[k];
+      update(MapVector3(measuredAccs + 3 * k),
+             MapVector3(measuredOmegas + 3 * k), dt, &J);
+
+      // Same as F * preintMeasCov_ * F' in integrateMeasurement, where
+      // F = [A Hb; 0 I] and the only nonzero blocks of Hb are
+      // theta_H_biasOmega = -dt * H and vel_H_biasAcc = -dt * R.
+      // With P = [P9 X; X' Pb], the update is
+      //   X  <- A * X + Hb * Pb
+      //   P9 <- A * P9 * A' + Z * Hb' + Hb * Z', with Z = A * X + Hb * Pb / 2
+      const Matrix3 theta_H_biasOmega = -dt * J.H;
+      const Matrix3 vel_H_biasAcc = -dt * J.R;
+      const Eigen::Matrix<double, 9, 6> X = preintMeasCov_.block<9, 6>(0, 9);
+      const Matrix6 Pb = preintMeasCov_.block<6, 6>(9, 9);
+      Eigen::Matrix<double, 9, 6> HbPb = Eigen::Matrix<double, 9, 6>::Zero();
+      HbPb.topRows<3>().noalias() = theta_H_biasOmega * Pb.bottomRows<3>();
+      HbPb.bottomRows<3>().noalias() = vel_H_biasAcc * Pb.topRows<3>();
+      const Eigen::Matrix<double, 9, 6> AX = J.applyA(X);
+      const Eigen::Matrix<double, 9, 6> Z = AX + 0.5 * HbPb;
+      Matrix9 ZHbt;
+      ZHbt.leftCols<3>().noalias() = Z.rightCols<3>() * theta_H_biasOmega.transpose();
+      ZHbt.middleCols<3>(3).setZero();
+      ZHbt.rightCols<3>().noalias() = Z.leftCols<3>() * vel_H_biasAcc.transpose();
+      const Matrix9 P9 = J.propagate(preintMeasCov_.block<9, 9>(0, 0)) + ZHbt
+          + ZHbt.transpose();
+      preintMeasCov_.block<9, 9>(0, 0) = P9;
+      preintMeasCov_.block<9, 6>(0, 9) = AX + HbPb;
+      preintMeasCov_.block<6, 9>(9, 0) = preintMeasCov_.block<9, 6>(0, 9).transpose();
+
+      // Add G * measurementCovariance * G' as in integrateMeasurement
+      Eigen::Matrix<double, 15, 15>* P = &preintMeasCov_;
+      D_t_t(P) += dt * iCov;
+      D_v_v(P) += (1 / dt) * vel_H_biasAcc * aCovInt * vel_H_biasAcc.transpose();
+      D_R_R(P) += (1 / dt) * theta_H_biasOmega * wCovInt
+          * theta_H_biasOmega.transpose();
+      D_a_a(P) += dt * p().biasAccCovariance;
+      D_g_g(P) += dt * p().biasOmegaCovariance;
+      const Matrix3 temp = vel_H_biasAcc * biasAccOmegaInt.block<3, 3>(3, 0)
+          * theta_H_biasOmega.transpose();
+      D_v_R(P) += temp;
+      D_R_v(P) += temp.transpose();
+    }
+    return;
+  }
+#endif
+  for (size_t k = 0; k < n; k++) {
+    integrateMeasurement(MapVector3(measuredAccs + 3 * k),
+                         MapVector3(measuredOmegas + 3 * k), dts[k]);
+  }
+}
+
 //------------------------------------------------------------------------------
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
 PreintegratedCombinedMeasurements::PreintegratedCombinedMeasurements(
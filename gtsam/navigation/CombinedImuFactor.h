@@ -177,6 +177,19 @@ public:
   void integrateMeasurement(const Vector3& measuredAcc,
       const Vector3& measuredOmega, const double dt) override;
 
+  /**
+   * Add n IMU measurements stored contiguously, e.g. in a driver buffer.
+   * Gives the same result as n calls to integrateMeasurement, but with tangent
+   * preintegration and no body_P_sensor the 15x15 covariance is propagated
+   * with the block structure of the Jacobians.
+   * @param measuredAccs 3*n accelerations, x, y, z per measurement
+   * @param measuredOmegas 3*n angular velocities, x, y, z per measurement
+   * @param dts n time intervals
+   * @param n number of measurements
+   */
+  void integrateMeasurements(const double* measuredAccs,
+      const double* measuredOmegas, const double* dts, size_t n);
+
   /// @}
 
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
@@ -22,6 +22,7 @@
 #include <gtsam/navigation/ImuFactor.h>
 
 /* External or standard includes */
+#include <boost/make_shared.hpp>
 #include <ostream>
 
 namespace gtsam {
@@ -47,6 +48,9 @@ bool PreintegratedImuMeasurements::equals(
 void PreintegratedImuMeasurements::resetIntegration() {
   PreintegrationType::resetIntegration();
   preintMeasCov_.setZero();
+  measuredAccs_.clear();
+  measuredOmegas_.clear();
+  dts_.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -57,6 +61,14 @@ void PreintegratedImuMeasurements::integrateMeasurement(
         "PreintegratedImuMeasurements::integrateMeasurement: dt <=0");
   }
 
+  if (keepMeasurements_) {
+    measuredAccs_.insert(measuredAccs_.end(), measuredAcc.data(),
+                         measuredAcc.data() + 3);
+    measuredOmegas_.insert(measuredOmegas_.end(), measuredOmega.data(),
+                           measuredOmega.data() + 3);
+    dts_.push_back(dt);
+  }
+
   // Update preintegrated measurements (also get Jacobian)
   Matrix9 A;  // overall Jacobian wrt preintegrated measurements (df/dx)
   Matrix93 B, C;
@@ -90,20 +102,107 @@ void PreintegratedImuMeasurements::integrateMeasurements(
   assert(dts.cols() >= 1);
   assert(measuredAccs.cols() == dts.cols());
   assert(measuredOmegas.cols() == dts.cols());
-  size_t n = static_cast<size_t>(dts.cols());
-  for (size_t j = 0; j < n; j++) {
-    integrateMeasurement(measuredAccs.col(j), measuredOmegas.col(j), dts(0, j));
+  integrateMeasurements(measuredAccs.data(), measuredOmegas.data(), dts.data(),
+                        static_cast<size_t>(dts.cols()));
+}
+
+//------------------------------------------------------------------------------
+void PreintegratedImuMeasurements::integrateMeasurements(
+    const double* measuredAccs, const double* measuredOmegas, const double* dts,
+    size_t n) {
+  typedef Eigen::Map<const Vector3> MapVector3;
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  if (!p().body_P_sensor) {
+    UpdateJacobians J;
+    for (size_t k = 0; k < n; k++) {
+      if (dts[k] <= 0) {
+        throw std::runtime_error(
+            "PreintegratedImuMeasurements::integrateMeasurements: dt <=0");
+      }
+      update(MapVector3(measuredAccs + 3 * k),
+             MapVector3(measuredOmegas + 3 * k), dts[k], &J);
+      PropagateCovariance(p(), J, &preintMeasCov_);
+    }
+    if (keepMeasurements_) {
+      measuredAccs_.insert(measuredAccs_.end(), measuredAccs,
+                           measuredAccs + 3 * n);
+      measuredOmegas_.insert(measuredOmegas_.end(), measuredOmegas,
+                             measuredOmegas + 3 * n);
+      dts_.insert(dts_.end(), dts, dts + n);
+    }
+    return;
+  }
+#endif
+  for (size_t k = 0; k < n; k++) {
+    integrateMeasurement(MapVector3(measuredAccs + 3 * k),
+                         MapVector3(measuredOmegas + 3 * k), dts[k]);
   }
 }
 
+//------------------------------------------------------------------------------
+void PreintegratedImuMeasurements::keepMeasurements(double biasThreshold) {
+  if (deltaTij_ > 0)
+    throw std::logic_error(
+        "PreintegratedImuMeasurements::keepMeasurements: measurements were "
+        "already integrated");
+  keepMeasurements_ = true;
+  biasThreshold_ = biasThreshold;
+}
+
+//------------------------------------------------------------------------------
+PreintegratedImuMeasurements PreintegratedImuMeasurements::reintegrated(
+    const imuBias::ConstantBias& biasHat) const {
+  if (!keepMeasurements_)
+    throw std::logic_error(
+        "PreintegratedImuMeasurements::reintegrated: measurements were not "
+        "kept");
+  PreintegratedImuMeasurements pim(p_, biasHat);
+  if (!dts_.empty())
+    pim.integrateMeasurements(measuredAccs_.data(), measuredOmegas_.data(),
+                              dts_.data(), dts_.size());
+  return pim;
+}
+
 //------------------------------------------------------------------------------
 #ifdef GTSAM_TANGENT_PREINTEGRATION
+void PreintegratedImuMeasurements::PropagateCovariance(
+    const PreintegrationParams& p, const UpdateJacobians& J,
+    Matrix9* preintMeasCov) {
+  // Same propagation as integrateMeasurement, with A, B and C in block form
+  const double dt = J.dt, dt22 = 0.5 * dt * dt;
+  Matrix9& P = *preintMeasCov;
+  P = J.propagate(P);
+  const Matrix3 RaCovRt = J.R * p.accelerometerCovariance * J.R.transpose();
+  P.block<3, 3>(0, 0).noalias() +=
+      dt * (J.H * p.gyroscopeCovariance * J.H.transpose());
+  P.block<3, 3>(3, 3) +=
+      (dt22 * dt22 / dt) * RaCovRt + p.integrationCovariance * dt;
+  P.block<3, 3>(3, 6) += dt22 * RaCovRt;
+  P.block<3, 3>(6, 3) += dt22 * RaCovRt;
+  P.block<3, 3>(6, 6) += dt * RaCovRt;
+}
+
+//------------------------------------------------------------------------------
 void PreintegratedImuMeasurements::mergeWith(const PreintegratedImuMeasurements& pim12, //
     Matrix9* H1, Matrix9* H2) {
   PreintegrationType::mergeWith(pim12, H1, H2);
   // NOTE(gareth): Temporary P is needed as of Eigen 3.3
   const Matrix9 P = *H1 * preintMeasCov_ * H1->transpose();
   preintMeasCov_ = P + *H2 * pim12.preintMeasCov_ * H2->transpose();
+
+  // The raw measurements of both are needed to re-integrate the merged ones
+  if (keepMeasurements_ && pim12.keepMeasurements_) {
+    measuredAccs_.insert(measuredAccs_.end(), pim12.measuredAccs_.begin(),
+                         pim12.measuredAccs_.end());
+    measuredOmegas_.insert(measuredOmegas_.end(), pim12.measuredOmegas_.begin(),
+                           pim12.measuredOmegas_.end());
+    dts_.insert(dts_.end(), pim12.dts_.begin(), pim12.dts_.end());
+  } else {
+    keepMeasurements_ = false;
+    measuredAccs_.clear();
+    measuredOmegas_.clear();
+    dts_.clear();
+  }
 }
 #endif
 //------------------------------------------------------------------------------
@@ -139,6 +238,8 @@ ImuFactor::ImuFactor(Key pose_i, Key vel_i, Key pose_j, Key vel_j, Key bias,
     const PreintegratedImuMeasurements& pim) :
     Base(noiseModel::Gaussian::Covariance(pim.preintMeasCov_), pose_i, vel_i,
         pose_j, vel_j, bias), _PIM_(pim) {
+  if (pim.keepsMeasurements())
+    reintegration_ = boost::make_shared<Reintegration>();
 }
 
 //------------------------------------------------------------------------------
@@ -177,8 +278,28 @@ Vector ImuFactor::evaluateError(const Pose3& pose_i, const Vector3& vel_i,
     const imuBias::ConstantBias& bias_i, boost::optional<Matrix&> H1,
     boost::optional<Matrix&> H2, boost::optional<Matrix&> H3,
     boost::optional<Matrix&> H4, boost::optional<Matrix&> H5) const {
-  return _PIM_.computeErrorAndJacobians(pose_i, vel_i, pose_j, vel_j, bias_i,
-      H1, H2, H3, H4, H5);
+  boost::shared_ptr<const PreintegratedImuMeasurements> holder;
+  return preintegratedAt(bias_i, &holder).computeErrorAndJacobians(pose_i,
+      vel_i, pose_j, vel_j, bias_i, H1, H2, H3, H4, H5);
+}
+
+//------------------------------------------------------------------------------
+const PreintegratedImuMeasurements& ImuFactor::preintegratedAt(
+    const imuBias::ConstantBias& bias_i,
+    boost::shared_ptr<const PreintegratedImuMeasurements>* holder) const {
+  if (!reintegration_ || !_PIM_.keepsMeasurements()) return _PIM_;
+  const double threshold = _PIM_.biasThreshold();
+  if ((bias_i - _PIM_.biasHat()).vector().norm() <= threshold) return _PIM_;
+
+  // Re-integrate once per bias linearization point, unless the last one is
+  // still close enough
+  std::lock_guard<std::mutex> lock(reintegration_->mutex);
+  const auto& cached = reintegration_->pim;
+  if (!cached || (bias_i - cached->biasHat()).vector().norm() > threshold)
+    reintegration_->pim = boost::make_shared<PreintegratedImuMeasurements>(
+        _PIM_.reintegrated(bias_i));
+  *holder = reintegration_->pim;
+  return **holder;
 }
 
 //------------------------------------------------------------------------------
@@ -27,6 +27,9 @@
 #include <gtsam/navigation/TangentPreintegration.h>
 #include <gtsam/base/debug.h>
 
+#include <mutex>
+#include <vector>
+
 namespace gtsam {
 
 #ifdef GTSAM_TANGENT_PREINTEGRATION
@@ -78,6 +81,10 @@ protected:
   Matrix9 preintMeasCov_; ///< COVARIANCE OF: [PreintROTATION PreintPOSITION PreintVELOCITY]
   ///< (first-order propagation from *measurementCovariance*).
 
+  bool keepMeasurements_ = false; ///< whether the raw measurements are kept
+  double biasThreshold_ = 0.0; ///< bias change for which ImuFactor re-integrates
+  std::vector<double> measuredAccs_, measuredOmegas_, dts_; ///< kept measurements
+
 public:
 
   /// Default constructor for serialization and Cython wrapper
@@ -132,6 +139,46 @@ public:
   void integrateMeasurements(const Matrix& measuredAccs, const Matrix& measuredOmegas,
                              const Matrix& dts);
 
+  /**
+   * Add n IMU measurements stored contiguously, e.g. in a driver buffer.
+   * Gives the same result as n calls to integrateMeasurement, but with tangent
+   * preintegration and no body_P_sensor the covariance is propagated with the
+   * block structure of the Jacobians, which is several times faster.
+   * @param measuredAccs 3*n accelerations, x, y, z per measurement
+   * @param measuredOmegas 3*n angular velocities, x, y, z per measurement
+   * @param dts n time intervals
+   * @param n number of measurements
+   */
+  void integrateMeasurements(const double* measuredAccs,
+      const double* measuredOmegas, const double* dts, size_t n);
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+  /// Propagate the covariance of the preintegrated measurements over one
+  /// update, given its Jacobians in block form. No body_P_sensor support.
+  static void PropagateCovariance(const PreintegrationParams& p,
+      const UpdateJacobians& J, Matrix9* preintMeasCov);
+#endif
+
+  /**
+   * Keep a copy of the raw measurements integrated from now on, so that
+   * ImuFactor can re-integrate them when the bias estimate is more than
+   * biasThreshold (norm of the 6D bias difference) away from biasHat. This is
+   * more accurate than the first-order bias correction for large changes.
+   * Must be called before any measurement is integrated. The measurements are
+   * not serialized.
+   */
+  void keepMeasurements(double biasThreshold);
+
+  /// Whether the raw measurements are kept, see keepMeasurements
+  bool keepsMeasurements() const { return keepMeasurements_; }
+
+  /// Bias change above which ImuFactor re-integrates, see keepMeasurements
+  double biasThreshold() const { return biasThreshold_; }
+
+  /// Re-integrate the kept measurements with a different bias estimate
+  PreintegratedImuMeasurements reintegrated(
+      const imuBias::ConstantBias& biasHat) const;
+
   /// Return pre-integrated measurement covariance
   Matrix preintMeasCov() const { return preintMeasCov_; }
 
@@ -178,6 +225,13 @@ private:
  * (which are usually slowly varying quantities), which is up to the caller.
  * See also CombinedImuFactor for a class that does this for you.
  *
+ * If the preintegrated measurements keep their raw measurements (see
+ * PreintegratedImuMeasurements::keepMeasurements), the factor re-integrates
+ * them when evaluated at a bias too far from the one used for preintegration,
+ * instead of relying on the first-order bias correction. The result is cached
+ * until the bias moves away again. The noise model stays the one computed at
+ * construction.
+ *
  * @addtogroup SLAM
  */
 class GTSAM_EXPORT ImuFactor: public NoiseModelFactor5<Pose3, Vector3, Pose3, Vector3,
@@ -190,6 +244,20 @@ private:
 
   PreintegratedImuMeasurements _PIM_;
 
+  /// Measurements re-integrated at the last bias estimate that was too far
+  /// from the one used for preintegration, shared by copies of the factor
+  struct Reintegration {
+    std::mutex mutex;
+    boost::shared_ptr<const PreintegratedImuMeasurements> pim;
+  };
+  boost::shared_ptr<Reintegration> reintegration_;
+
+  /// Measurements to linearize at bias_i: _PIM_, unless it keeps its raw
+  /// measurements and bias_i is too far from its biasHat
+  const PreintegratedImuMeasurements& preintegratedAt(
+      const imuBias::ConstantBias& bias_i,
+      boost::shared_ptr<const PreintegratedImuMeasurements>* holder) const;
+
 public:
 
   /** Shorthand for a smart pointer to a factor */
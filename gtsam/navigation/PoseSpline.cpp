@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PoseSpline.cpp
+ * @brief   Continuous-time Pose3 trajectory as a cumulative cubic B-spline
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/PoseSpline.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+PoseSpline::Segment::Segment(const Pose3& T0, const Pose3& T1, const Pose3& T2,
+                             const Pose3& T3, bool withJacobians)
+    : T0_(T0), withJacobians_(withJacobians) {
+  const Pose3* T[4] = {&T0, &T1, &T2, &T3};
+  for (size_t j = 0; j < 3; j++) {
+    if (withJacobians) {
+      Matrix6 H_a, H_b, H_log;
+      const Pose3 relative = T[j]->between(*T[j + 1], H_a, H_b);
+      d_[j] = Pose3::Logmap(relative, H_log);
+      H_d_[j][0] = H_log * H_a;
+      H_d_[j][1] = H_log * H_b;
+    } else {
+      d_[j] = Pose3::Logmap(T[j]->between(*T[j + 1]));
+    }
+  }
+}
+
+/* ************************************************************************* */
+Pose3 PoseSpline::Segment::pose(double u, OptionalJacobian<6, 24> H) const {
+  if (H && !withJacobians_)
+    throw logic_error(
+        "PoseSpline::Segment::pose: segment was constructed without Jacobians");
+  const Vector4 b = CumulativeBasis(u);
+  if (!H) {
+    return T0_ * Pose3::Expmap(b(1) * d_[0]) * Pose3::Expmap(b(2) * d_[1]) *
+           Pose3::Expmap(b(3) * d_[2]);
+  }
+
+  // T = ((T0 * E1) * E2) * E3, with E_j = Exp(b_j d_j)
+  Matrix6 H_exp[3];
+  Pose3 E[3];
+  for (size_t j = 0; j < 3; j++)
+    E[j] = Pose3::Expmap(b(j + 1) * d_[j], H_exp[j]);
+  Matrix6 H_P_T0, H_P_E1, H_Q_P, H_Q_E2, H_T_Q, H_T_E3;
+  const Pose3 P = T0_.compose(E[0], H_P_T0, H_P_E1);
+  const Pose3 Q = P.compose(E[1], H_Q_P, H_Q_E2);
+  const Pose3 T = Q.compose(E[2], H_T_Q, H_T_E3);
+
+  // Derivatives w.r.t. E_j, then w.r.t. the control points through d_j
+  const Matrix6 H_T_P = H_T_Q * H_Q_P;
+  const Matrix6 H_T_E[3] = {H_T_P * H_P_E1, H_T_Q * H_Q_E2, H_T_E3};
+  H->setZero();
+  H->block<6, 6>(0, 0) = H_T_P * H_P_T0;
+  for (size_t j = 0; j < 3; j++) {
+    const Matrix6 H_T_d = H_T_E[j] * H_exp[j] * b(j + 1);
+    H->block<6, 6>(0, 6 * j) += H_T_d * H_d_[j][0];
+    H->block<6, 6>(0, 6 * (j + 1)) += H_T_d * H_d_[j][1];
+  }
+  return T;
+}
+
+/* ************************************************************************* */
+PoseSpline::PoseSpline(double t0, double dt, Key key0)
+    : t0_(t0), dt_(dt), key0_(key0) {
+  if (!(dt > 0)) throw invalid_argument("PoseSpline: dt must be positive");
+}
+
+/* ************************************************************************* */
+size_t PoseSpline::segment(double t, double* u) const {
+  if (t < t0_)
+    throw invalid_argument("PoseSpline::segment: time is before the start");
+  const double s = (t - t0_) / dt_;
+  const double i = std::floor(s);
+  *u = s - i;
+  return static_cast<size_t>(i);
+}
+
+/* ************************************************************************* */
+size_t PoseSpline::nrControlPoints(double tEnd) const {
+  double u;
+  return segment(tEnd, &u) + 4;
+}
+
+/* ************************************************************************* */
+Vector4 PoseSpline::CumulativeBasis(double u) {
+  const double u2 = u * u, u3 = u2 * u;
+  return Vector4(1.0, (5.0 + 3.0 * u - 3.0 * u2 + u3) / 6.0,
+                 (1.0 + 3.0 * u + 3.0 * u2 - 2.0 * u3) / 6.0, u3 / 6.0);
+}
+
+/* ************************************************************************* */
+Pose3 PoseSpline::pose(const Values& values, double t) const {
+  double u;
+  const size_t i = segment(t, &u);
+  const Segment controlPoints(
+      values.at<Pose3>(key(i)), values.at<Pose3>(key(i + 1)),
+      values.at<Pose3>(key(i + 2)), values.at<Pose3>(key(i + 3)));
+  return controlPoints.pose(u);
+}
+
+/* ************************************************************************* */
+Values PoseSpline::initialize(const function<Pose3(double)>& poseAt,
+                              double tEnd) const {
+  // The pose at the start of segment i is close to control point i + 1
+  Values values;
+  const size_t n = nrControlPoints(tEnd);
+  for (size_t i = 0; i < n; i++) {
+    const double t = t0_ + (static_cast<double>(i) - 1.0) * dt_;
+    values.insert(key(i), poseAt(t));
+  }
+  return values;
+}
+
+} // namespace gtsam
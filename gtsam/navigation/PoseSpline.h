@@ -0,0 +1,107 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PoseSpline.h
+ * @brief   Continuous-time Pose3 trajectory as a cumulative cubic B-spline
+ * @date    October 2026
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <functional>
+
+namespace gtsam {
+
+/**
+ * A continuous-time Pose3 trajectory, represented as a uniform cumulative
+ * cubic B-spline on SE(3) (Lovegrove et al., BMVC 2013). Control points are
+ * ordinary Pose3 variables with keys key0, key0 + 1, ..., e.g. Symbol('c', i).
+ * Knots are spaced dt apart from t0, and the pose in segment i, i.e. at
+ * t0 + (i + u) dt with u in [0, 1), only depends on control points i..i+3:
+ *
+ *   T(u) = T_i * Exp(b1(u) d1) * Exp(b2(u) d2) * Exp(b3(u) d3),
+ *   with d_j = Log(T_{i+j-1}^{-1} T_{i+j})
+ *
+ * where b_j are the cumulative basis functions. Many measurements at different
+ * times then share a few control points, instead of needing a pose variable
+ * each.
+ */
+class GTSAM_EXPORT PoseSpline {
+  double t0_, dt_;
+  Key key0_;
+
+ public:
+  /// Jacobian of a pose in a segment w.r.t. its four control points
+  typedef Eigen::Matrix<double, 6, 24> Matrix624;
+
+  /**
+   * The four control points of a segment, with everything that evaluating
+   * the pose at many times in the segment shares.
+   */
+  class GTSAM_EXPORT Segment {
+    Pose3 T0_;
+    Vector6 d_[3];         ///< Log of the relative poses of the control points
+    Matrix6 H_d_[3][2];    ///< derivatives of d_j w.r.t. control points j-1, j
+    bool withJacobians_;
+
+   public:
+    /// Construct from the control points, with derivatives if needed later
+    Segment(const Pose3& T0, const Pose3& T1, const Pose3& T2, const Pose3& T3,
+            bool withJacobians = false);
+
+    /**
+     * Pose at fraction u in [0, 1] of the segment
+     * @param H optional derivative w.r.t. the four control points, which
+     *        requires the segment to be constructed withJacobians
+     */
+    Pose3 pose(double u, OptionalJacobian<6, 24> H = boost::none) const;
+  };
+
+  /**
+   * Constructor
+   * @param t0 time of the start of the first segment
+   * @param dt time between knots
+   * @param key0 key of the first control point, the others follow
+   */
+  PoseSpline(double t0, double dt, Key key0);
+
+  double t0() const { return t0_; }
+  double dt() const { return dt_; }
+
+  /// Key of control point i
+  Key key(size_t i) const { return key0_ + i; }
+
+  /// Segment containing time t, and the fraction u of the segment at t.
+  /// Throws std::invalid_argument if t is before t0.
+  size_t segment(double t, double* u) const;
+
+  /// Number of control points needed to cover times up to tEnd
+  size_t nrControlPoints(double tEnd) const;
+
+  /// Cumulative basis functions b0 = 1, b1, b2, b3 at u
+  static Vector4 CumulativeBasis(double u);
+
+  /// Pose at time t, with control points in values
+  Pose3 pose(const Values& values, double t) const;
+
+  /**
+   * Initial control points covering times up to tEnd, from poses sampled at
+   * the knots, e.g. from a Scenario or a discrete-time estimate
+   */
+  Values initialize(const std::function<Pose3(double)>& poseAt,
+                    double tEnd) const;
+};
+
+} // namespace gtsam
@@ -0,0 +1,207 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PreintegrationBatch.cpp
+ * @brief   Preintegration of many IMU streams at once, e.g. for a fleet
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/PreintegrationBatch.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <boost/make_shared.hpp>
+
+using namespace std;
+
+namespace gtsam {
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+/* ************************************************************************* */
+PreintegrationBatch::PreintegrationBatch(const SharedParams& p) : p_(p) {
+  if (p_->body_P_sensor)
+    throw invalid_argument(
+        "PreintegrationBatch: body_P_sensor is not supported");
+}
+
+/* ************************************************************************* */
+size_t PreintegrationBatch::addStream(double startTime, const Bias& biasHat) {
+  preintegrated_.resize(preintegrated_.size() + 9, 0.0);
+  preintegrated_H_biasAcc_.resize(preintegrated_H_biasAcc_.size() + 27, 0.0);
+  preintegrated_H_biasOmega_.resize(preintegrated_H_biasOmega_.size() + 27, 0.0);
+  preintMeasCov_.resize(preintMeasCov_.size() + 81, 0.0);
+  deltaTij_.push_back(0.0);
+  time_.push_back(startTime);
+  biasHat_.push_back(biasHat);
+  keyframes_.push_back(deque<Keyframe>());
+  return time_.size() - 1;
+}
+
+/* ************************************************************************* */
+void PreintegrationBatch::addKeyframe(size_t stream, double time, Key pose_i,
+    Key vel_i, Key pose_j, Key vel_j, Key bias) {
+  const double last = keyframes_[stream].empty() ? time_[stream]
+                                                 : keyframes_[stream].back().time;
+  if (time <= last)
+    throw invalid_argument(
+        "PreintegrationBatch::addKeyframe: keyframe is not after the last one");
+  const Keyframe keyframe = {time, pose_i, vel_i, pose_j, vel_j, bias};
+  keyframes_[stream].push_back(keyframe);
+}
+
+/* ************************************************************************* */
+void PreintegrationBatch::integrate(const size_t* streams, const double* times,
+    const double* measuredAccs, const double* measuredOmegas, size_t n,
+    NonlinearFactorGraph* factors) {
+  // Group the samples by stream, keeping their order within a stream, and
+  // check them before anything is integrated
+  const size_t nrStreams = size();
+  vector<size_t> offsets(nrStreams + 1, 0);
+  for (size_t k = 0; k < n; k++) {
+    if (streams[k] >= nrStreams)
+      throw invalid_argument("PreintegrationBatch::integrate: unknown stream");
+    ++offsets[streams[k] + 1];
+  }
+  for (size_t s = 0; s < nrStreams; s++) offsets[s + 1] += offsets[s];
+  vector<size_t> order(n), next(offsets.begin(), offsets.end() - 1);
+  vector<double> last(time_);
+  for (size_t k = 0; k < n; k++) {
+    const size_t s = streams[k];
+    if (times[k] <= last[s])
+      throw runtime_error(
+          "PreintegrationBatch::integrate: samples are not in increasing time");
+    last[s] = times[k];
+    order[next[s]++] = k;
+  }
+
+  // Integrate the streams independently
+  vector<vector<NonlinearFactor::shared_ptr> > emitted(nrStreams);
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, nrStreams),
+      [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t s = range.begin(); s != range.end(); ++s)
+          integrateStream(s, order.data() + offsets[s],
+                          offsets[s + 1] - offsets[s], times, measuredAccs,
+                          measuredOmegas, &emitted[s]);
+      });
+#else
+  for (size_t s = 0; s < nrStreams; s++)
+    integrateStream(s, order.data() + offsets[s], offsets[s + 1] - offsets[s],
+                    times, measuredAccs, measuredOmegas, &emitted[s]);
+#endif
+
+  if (factors)
+    for (const vector<NonlinearFactor::shared_ptr>& streamFactors : emitted)
+      for (const NonlinearFactor::shared_ptr& factor : streamFactors)
+        factors->push_back(factor);
+}
+
+/* ************************************************************************* */
+void PreintegrationBatch::integrateStream(size_t stream, const size_t* order,
+    size_t count, const double* times, const double* measuredAccs,
+    const double* measuredOmegas, vector<NonlinearFactor::shared_ptr>* factors) {
+  if (count == 0) return;
+
+  // Work on fixed-size copies of the stream's state
+  typedef Eigen::Map<const Vector3> MapVector3;
+  Vector9 preintegrated = Eigen::Map<Vector9>(&preintegrated_[9 * stream]);
+  Matrix93 H_biasAcc =
+      Eigen::Map<Matrix93>(&preintegrated_H_biasAcc_[27 * stream]);
+  Matrix93 H_biasOmega =
+      Eigen::Map<Matrix93>(&preintegrated_H_biasOmega_[27 * stream]);
+  Matrix9 preintMeasCov = Eigen::Map<Matrix9>(&preintMeasCov_[81 * stream]);
+  double deltaTij = deltaTij_[stream], time = time_[stream];
+  const Bias& biasHat = biasHat_[stream];
+  deque<Keyframe>& keyframes = keyframes_[stream];
+
+  TangentPreintegration::UpdateJacobians J;
+  auto step = [&](const Vector3& acc, const Vector3& omega, double dt) {
+    preintegrated = TangentPreintegration::UpdatePreintegrated(
+        acc, omega, dt, preintegrated, &J);
+    TangentPreintegration::UpdateBiasJacobians(J, &H_biasAcc, &H_biasOmega);
+    PreintegratedImuMeasurements::PropagateCovariance(*p_, J, &preintMeasCov);
+    deltaTij += dt;
+  };
+
+  for (size_t i = 0; i < count; i++) {
+    const size_t k = order[i];
+    const Vector3 acc =
+        biasHat.correctAccelerometer(MapVector3(measuredAccs + 3 * k));
+    const Vector3 omega =
+        biasHat.correctGyroscope(MapVector3(measuredOmegas + 3 * k));
+
+    // Split the interval at the keyframes it contains
+    while (!keyframes.empty() && keyframes.front().time <= times[k]) {
+      const Keyframe& keyframe = keyframes.front();
+      step(acc, omega, keyframe.time - time);
+      time = keyframe.time;
+      const PreintegratedImuMeasurements pim(
+          TangentPreintegration(p_, biasHat, deltaTij, preintegrated,
+                                H_biasAcc, H_biasOmega),
+          preintMeasCov);
+      factors->push_back(boost::make_shared<ImuFactor>(keyframe.pose_i,
+          keyframe.vel_i, keyframe.pose_j, keyframe.vel_j, keyframe.bias, pim));
+      preintegrated.setZero();
+      H_biasAcc.setZero();
+      H_biasOmega.setZero();
+      preintMeasCov.setZero();
+      deltaTij = 0.0;
+      keyframes.pop_front();
+    }
+    if (times[k] > time) step(acc, omega, times[k] - time);
+    time = times[k];
+  }
+
+  Eigen::Map<Vector9> preintegratedOut(&preintegrated_[9 * stream]);
+  Eigen::Map<Matrix93> H_biasAccOut(&preintegrated_H_biasAcc_[27 * stream]);
+  Eigen::Map<Matrix93> H_biasOmegaOut(&preintegrated_H_biasOmega_[27 * stream]);
+  Eigen::Map<Matrix9> preintMeasCovOut(&preintMeasCov_[81 * stream]);
+  preintegratedOut = preintegrated;
+  H_biasAccOut = H_biasAcc;
+  H_biasOmegaOut = H_biasOmega;
+  preintMeasCovOut = preintMeasCov;
+  deltaTij_[stream] = deltaTij;
+  time_[stream] = time;
+}
+
+/* ************************************************************************* */
+PreintegratedImuMeasurements PreintegrationBatch::preintegrated(
+    size_t stream) const {
+  typedef Eigen::Map<const Vector9> MapVector9;
+  typedef Eigen::Map<const Matrix93> MapMatrix93;
+  const TangentPreintegration base(p_, biasHat_[stream], deltaTij_[stream],
+      MapVector9(&preintegrated_[9 * stream]),
+      MapMatrix93(&preintegrated_H_biasAcc_[27 * stream]),
+      MapMatrix93(&preintegrated_H_biasOmega_[27 * stream]));
+  return PreintegratedImuMeasurements(base,
+      Eigen::Map<const Matrix9>(&preintMeasCov_[81 * stream]));
+}
+
+/* ************************************************************************* */
+void PreintegrationBatch::resetIntegrationAndSetBias(size_t stream,
+    const Bias& biasHat) {
+  Eigen::Map<Vector9>(&preintegrated_[9 * stream]).setZero();
+  Eigen::Map<Matrix93>(&preintegrated_H_biasAcc_[27 * stream]).setZero();
+  Eigen::Map<Matrix93>(&preintegrated_H_biasOmega_[27 * stream]).setZero();
+  Eigen::Map<Matrix9>(&preintMeasCov_[81 * stream]).setZero();
+  deltaTij_[stream] = 0.0;
+  biasHat_[stream] = biasHat;
+}
+
+#endif
+
+} // namespace gtsam
@@ -0,0 +1,127 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    PreintegrationBatch.h
+ * @brief   Preintegration of many IMU streams at once, e.g. for a fleet
+ * @date    October 2026
+ */
+
+#pragma once
+
+#include <gtsam/navigation/ImuFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <deque>
+#include <vector>
+
+namespace gtsam {
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+/**
+ * Preintegrates the IMU measurements of many streams, e.g. one per vehicle of
+ * a fleet, with tangent preintegration. The state of all streams is kept in
+ * flat arrays (structure of arrays), and batches of interleaved, timestamped
+ * samples are grouped per stream and integrated in parallel over streams when
+ * GTSAM is built with TBB.
+ *
+ * A measurement at time t is integrated over the interval from the previous
+ * sample (or keyframe) of its stream to t. When that interval contains a
+ * scheduled keyframe, it is split at the keyframe, an ImuFactor is emitted
+ * and the stream is reset, as a separate PreintegratedImuMeasurements would
+ * be. Body_P_sensor is not supported.
+ *
+ * Only the 9x9 covariance of PreintegratedImuMeasurements is propagated, and
+ * the emitted factors are ImuFactors with a constant bias between keyframes.
+ * PreintegratedCombinedMeasurements, whose 15x15 covariance includes the bias
+ * random walk, and CombinedImuFactor are not supported: streams that need them
+ * have to be preintegrated one PreintegratedCombinedMeasurements at a time.
+ */
+class GTSAM_EXPORT PreintegrationBatch {
+ public:
+  typedef imuBias::ConstantBias Bias;
+  typedef boost::shared_ptr<PreintegrationParams> SharedParams;
+
+ private:
+  /// An ImuFactor to emit when a stream reaches time
+  struct Keyframe {
+    double time;
+    Key pose_i, vel_i, pose_j, vel_j, bias;
+  };
+
+  SharedParams p_;
+
+  // Per stream, in flat arrays
+  std::vector<double> preintegrated_;              ///< 9 per stream
+  std::vector<double> preintegrated_H_biasAcc_;    ///< 9x3 per stream
+  std::vector<double> preintegrated_H_biasOmega_;  ///< 9x3 per stream
+  std::vector<double> preintMeasCov_;              ///< 9x9 per stream
+  std::vector<double> deltaTij_;   ///< time integrated since the last reset
+  std::vector<double> time_;       ///< time of the last sample or keyframe
+  std::vector<Bias> biasHat_;
+  std::vector<std::deque<Keyframe> > keyframes_;
+
+ public:
+  /// Construct with parameters shared by all streams, which must not have
+  /// body_P_sensor
+  explicit PreintegrationBatch(const SharedParams& p);
+
+  /// Add a stream that starts at time startTime, and return its index
+  size_t addStream(double startTime, const Bias& biasHat = Bias());
+
+  /// Number of streams
+  size_t size() const { return time_.size(); }
+
+  /// Time of the last sample or keyframe of a stream
+  double time(size_t stream) const { return time_[stream]; }
+
+  /**
+   * Emit an ImuFactor between pose_i, vel_i and pose_j, vel_j when stream
+   * reaches time, i.e., when the first sample at or after time is integrated.
+   * Keyframes of a stream must be added in increasing time.
+   */
+  void addKeyframe(size_t stream, double time, Key pose_i, Key vel_i,
+                   Key pose_j, Key vel_j, Key bias);
+
+  /**
+   * Integrate n samples of any streams. Samples of the same stream must be in
+   * increasing time, and later than the stream's time.
+   * @param streams n stream indices
+   * @param times n timestamps
+   * @param measuredAccs 3*n accelerations, x, y, z per sample
+   * @param measuredOmegas 3*n angular velocities, x, y, z per sample
+   * @param n number of samples
+   * @param factors if given, the factors of the keyframes that were reached
+   *        are added, ordered by stream and then by time
+   */
+  void integrate(const size_t* streams, const double* times,
+                 const double* measuredAccs, const double* measuredOmegas,
+                 size_t n, NonlinearFactorGraph* factors = 0);
+
+  /// The measurements integrated since the last keyframe of a stream
+  PreintegratedImuMeasurements preintegrated(size_t stream) const;
+
+  /// Reset a stream's integration, e.g. after an external keyframe, and
+  /// set a new bias estimate
+  void resetIntegrationAndSetBias(size_t stream, const Bias& biasHat);
+
+ private:
+  /// Integrate the samples with indices order[0..count), all of stream
+  void integrateStream(size_t stream, const size_t* order, size_t count,
+                       const double* times, const double* measuredAccs,
+                       const double* measuredOmegas,
+                       std::vector<NonlinearFactor::shared_ptr>* factors);
+};
+
+#endif
+
+} // namespace gtsam
@@ -0,0 +1,229 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SplineFactor.cpp
+ * @brief   Factors on the control points of a PoseSpline
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/SplineFactor.h>
+
+#include <boost/make_shared.hpp>
+
+#include <map>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+/// Noise model of n measurements with the same diagonal noise model
+SharedNoiseModel Stack(const SharedNoiseModel& model, size_t n) {
+  const noiseModel::Diagonal::shared_ptr diagonal =
+      boost::dynamic_pointer_cast<noiseModel::Diagonal>(model);
+  if (!diagonal)
+    throw invalid_argument("SplineFactor: noise model must be diagonal");
+  if (boost::dynamic_pointer_cast<noiseModel::Unit>(model))
+    return noiseModel::Unit::Create(model->dim() * n);
+  if (boost::dynamic_pointer_cast<noiseModel::Isotropic>(model))
+    return noiseModel::Isotropic::Sigma(model->dim() * n, diagonal->sigma(0));
+  return noiseModel::Diagonal::Sigmas(diagonal->sigmas().replicate(n, 1));
+}
+
+/// Indices of the measurements in each segment, and their fractions u
+map<size_t, vector<size_t> > GroupBySegment(const PoseSpline& spline,
+                                            const vector<double>& times,
+                                            vector<double>* u) {
+  map<size_t, vector<size_t> > segments;
+  u->resize(times.size());
+  for (size_t k = 0; k < times.size(); k++)
+    segments[spline.segment(times[k], &(*u)[k])].push_back(k);
+  return segments;
+}
+
+/// Write the derivative of measurement k w.r.t. the control points into H1..H4
+void SetJacobians(size_t k, const Matrix& H_k, size_t rows,
+                  boost::optional<Matrix&>* H) {
+  for (size_t j = 0; j < 4; j++)
+    if (H[j]) H[j]->block(rows * k, 0, rows, 6) = H_k.block(0, 6 * j, rows, 6);
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+SplinePoseFactor::SplinePoseFactor(Key key0, Key key1, Key key2, Key key3,
+    const vector<double>& u, const vector<Pose3>& measured,
+    const SharedNoiseModel& model)
+    : Base(Stack(model, measured.size()), key0, key1, key2, key3), u_(u),
+      measured_(measured) {
+  if (u.size() != measured.size())
+    throw invalid_argument("SplinePoseFactor: one u per measurement needed");
+}
+
+/* ************************************************************************* */
+void SplinePoseFactor::Add(const PoseSpline& spline, const vector<double>& times,
+    const vector<Pose3>& measured, const SharedNoiseModel& model,
+    NonlinearFactorGraph* graph) {
+  vector<double> u;
+  for (const auto& segment : GroupBySegment(spline, times, &u)) {
+    vector<double> segmentU;
+    vector<Pose3> segmentMeasured;
+    for (size_t k : segment.second) {
+      segmentU.push_back(u[k]);
+      segmentMeasured.push_back(measured[k]);
+    }
+    const size_t i = segment.first;
+    graph->push_back(boost::make_shared<SplinePoseFactor>(spline.key(i),
+        spline.key(i + 1), spline.key(i + 2), spline.key(i + 3), segmentU,
+        segmentMeasured, model));
+  }
+}
+
+/* ************************************************************************* */
+void SplinePoseFactor::print(const string& s,
+                             const KeyFormatter& keyFormatter) const {
+  cout << s << "SplinePoseFactor on " << keyFormatter(key1()) << ","
+       << keyFormatter(key2()) << "," << keyFormatter(key3()) << ","
+       << keyFormatter(key4()) << " with " << measured_.size()
+       << " measurements\n";
+  noiseModel_->print("  noise model: ");
+}
+
+/* ************************************************************************* */
+bool SplinePoseFactor::equals(const NonlinearFactor& expected,
+                              double tol) const {
+  const This* e = dynamic_cast<const This*>(&expected);
+  if (e == NULL || !Base::equals(*e, tol) || u_.size() != e->u_.size())
+    return false;
+  for (size_t k = 0; k < u_.size(); k++)
+    if (std::abs(u_[k] - e->u_[k]) > tol ||
+        !measured_[k].equals(e->measured_[k], tol))
+      return false;
+  return true;
+}
+
+/* ************************************************************************* */
+Vector SplinePoseFactor::evaluateError(const Pose3& T0, const Pose3& T1,
+    const Pose3& T2, const Pose3& T3, boost::optional<Matrix&> H1,
+    boost::optional<Matrix&> H2, boost::optional<Matrix&> H3,
+    boost::optional<Matrix&> H4) const {
+  boost::optional<Matrix&> H[4] = {H1, H2, H3, H4};
+  const bool jacobians = H1 || H2 || H3 || H4;
+  const size_t n = measured_.size();
+  for (size_t j = 0; j < 4; j++)
+    if (H[j]) H[j]->resize(6 * n, 6);
+
+  const PoseSpline::Segment segment(T0, T1, T2, T3, jacobians);
+  Vector error(6 * n);
+  PoseSpline::Matrix624 H_pose;
+  Matrix6 H_between, H_log;
+  for (size_t k = 0; k < n; k++) {
+    if (!jacobians) {
+      error.segment<6>(6 * k) =
+          Pose3::Logmap(measured_[k].between(segment.pose(u_[k])));
+      continue;
+    }
+    const Pose3 pose = segment.pose(u_[k], H_pose);
+    error.segment<6>(6 * k) = Pose3::Logmap(
+        measured_[k].between(pose, boost::none, H_between), H_log);
+    SetJacobians(k, H_log * H_between * H_pose, 6, H);
+  }
+  return error;
+}
+
+/* ************************************************************************* */
+SplinePositionFactor::SplinePositionFactor(Key key0, Key key1, Key key2,
+    Key key3, const vector<double>& u, const vector<Point3>& measured,
+    const vector<Point3>& bodyPoints, const SharedNoiseModel& model)
+    : Base(Stack(model, measured.size()), key0, key1, key2, key3), u_(u),
+      measured_(measured), bodyPoints_(bodyPoints) {
+  if (u.size() != measured.size() || bodyPoints.size() != measured.size())
+    throw invalid_argument(
+        "SplinePositionFactor: one u and body point per measurement needed");
+}
+
+/* ************************************************************************* */
+void SplinePositionFactor::Add(const PoseSpline& spline,
+    const vector<double>& times, const vector<Point3>& measured,
+    const vector<Point3>& bodyPoints, const SharedNoiseModel& model,
+    NonlinearFactorGraph* graph) {
+  vector<double> u;
+  for (const auto& segment : GroupBySegment(spline, times, &u)) {
+    vector<double> segmentU;
+    vector<Point3> segmentMeasured, segmentBodyPoints;
+    for (size_t k : segment.second) {
+      segmentU.push_back(u[k]);
+      segmentMeasured.push_back(measured[k]);
+      segmentBodyPoints.push_back(bodyPoints[k]);
+    }
+    const size_t i = segment.first;
+    graph->push_back(boost::make_shared<SplinePositionFactor>(spline.key(i),
+        spline.key(i + 1), spline.key(i + 2), spline.key(i + 3), segmentU,
+        segmentMeasured, segmentBodyPoints, model));
+  }
+}
+
+/* ************************************************************************* */
+void SplinePositionFactor::print(const string& s,
+                                 const KeyFormatter& keyFormatter) const {
+  cout << s << "SplinePositionFactor on " << keyFormatter(key1()) << ","
+       << keyFormatter(key2()) << "," << keyFormatter(key3()) << ","
+       << keyFormatter(key4()) << " with " << measured_.size()
+       << " measurements\n";
+  noiseModel_->print("  noise model: ");
+}
+
+/* ************************************************************************* */
+bool SplinePositionFactor::equals(const NonlinearFactor& expected,
+                                  double tol) const {
+  const This* e = dynamic_cast<const This*>(&expected);
+  if (e == NULL || !Base::equals(*e, tol) || u_.size() != e->u_.size())
+    return false;
+  for (size_t k = 0; k < u_.size(); k++)
+    if (std::abs(u_[k] - e->u_[k]) > tol ||
+        !traits<Point3>::Equals(measured_[k], e->measured_[k], tol) ||
+        !traits<Point3>::Equals(bodyPoints_[k], e->bodyPoints_[k], tol))
+      return false;
+  return true;
+}
+
+/* ************************************************************************* */
+Vector SplinePositionFactor::evaluateError(const Pose3& T0, const Pose3& T1,
+    const Pose3& T2, const Pose3& T3, boost::optional<Matrix&> H1,
+    boost::optional<Matrix&> H2, boost::optional<Matrix&> H3,
+    boost::optional<Matrix&> H4) const {
+  boost::optional<Matrix&> H[4] = {H1, H2, H3, H4};
+  const bool jacobians = H1 || H2 || H3 || H4;
+  const size_t n = measured_.size();
+  for (size_t j = 0; j < 4; j++)
+    if (H[j]) H[j]->resize(3 * n, 6);
+
+  const PoseSpline::Segment segment(T0, T1, T2, T3, jacobians);
+  Vector error(3 * n);
+  PoseSpline::Matrix624 H_pose;
+  Matrix36 H_point;
+  for (size_t k = 0; k < n; k++) {
+    if (!jacobians) {
+      error.segment<3>(3 * k) =
+          segment.pose(u_[k]).transformFrom(bodyPoints_[k]) - measured_[k];
+      continue;
+    }
+    const Pose3 pose = segment.pose(u_[k], H_pose);
+    error.segment<3>(3 * k) =
+        pose.transformFrom(bodyPoints_[k], H_point) - measured_[k];
+    SetJacobians(k, H_point * H_pose, 3, H);
+  }
+  return error;
+}
+
+} // namespace gtsam
@@ -0,0 +1,170 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    SplineFactor.h
+ * @brief   Factors on the control points of a PoseSpline
+ * @date    October 2026
+ */
+
+#pragma once
+
+#include <gtsam/navigation/PoseSpline.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * Pose measurements at many times in one segment of a PoseSpline, e.g. from
+ * motion capture or high-rate odometry. The error of each measurement is the
+ * Logmap of the spline pose relative to the measured pose. What the
+ * measurements share, the relative poses of the four control points and their
+ * derivatives, is computed once per evaluation.
+ * @addtogroup Navigation
+ */
+class GTSAM_EXPORT SplinePoseFactor
+    : public NoiseModelFactor4<Pose3, Pose3, Pose3, Pose3> {
+ private:
+  typedef NoiseModelFactor4<Pose3, Pose3, Pose3, Pose3> Base;
+
+  std::vector<double> u_;       ///< fraction of the segment of each measurement
+  std::vector<Pose3> measured_;
+
+ public:
+  typedef boost::shared_ptr<SplinePoseFactor> shared_ptr;
+  typedef SplinePoseFactor This;
+
+  /// default constructor - only use for serialization
+  SplinePoseFactor() {}
+
+  virtual ~SplinePoseFactor() {}
+
+  /**
+   * Constructor
+   * @param key0 first of the four control points of the segment
+   * @param u fraction of the segment of each measurement, in [0, 1]
+   * @param measured measured poses
+   * @param model diagonal noise model of a single measurement
+   */
+  SplinePoseFactor(Key key0, Key key1, Key key2, Key key3,
+                   const std::vector<double>& u,
+                   const std::vector<Pose3>& measured,
+                   const SharedNoiseModel& model);
+
+  /**
+   * Add pose measurements at arbitrary times to graph, with one factor per
+   * segment of the spline
+   */
+  static void Add(const PoseSpline& spline, const std::vector<double>& times,
+                  const std::vector<Pose3>& measured,
+                  const SharedNoiseModel& model, NonlinearFactorGraph* graph);
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print
+  virtual void print(const std::string& s, const KeyFormatter& keyFormatter =
+      DefaultKeyFormatter) const;
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const;
+
+  /// Errors of all measurements, stacked
+  Vector evaluateError(const Pose3& T0, const Pose3& T1, const Pose3& T2,
+      const Pose3& T3, boost::optional<Matrix&> H1 = boost::none,
+      boost::optional<Matrix&> H2 = boost::none,
+      boost::optional<Matrix&> H3 = boost::none,
+      boost::optional<Matrix&> H4 = boost::none) const;
+
+  const std::vector<double>& u() const { return u_; }
+  const std::vector<Pose3>& measured() const { return measured_; }
+};
+
+/**
+ * Position measurements of a point on the body, at many times in one segment
+ * of a PoseSpline, e.g. GPS with a lever arm, or lidar points associated with
+ * known map points. The error of each measurement is the difference between
+ * the predicted and measured positions.
+ * @addtogroup Navigation
+ */
+class GTSAM_EXPORT SplinePositionFactor
+    : public NoiseModelFactor4<Pose3, Pose3, Pose3, Pose3> {
+ private:
+  typedef NoiseModelFactor4<Pose3, Pose3, Pose3, Pose3> Base;
+
+  std::vector<double> u_;         ///< fraction of the segment of each measurement
+  std::vector<Point3> measured_;  ///< measured positions, in the world frame
+  std::vector<Point3> bodyPoints_;  ///< measured points, in the body frame
+
+ public:
+  typedef boost::shared_ptr<SplinePositionFactor> shared_ptr;
+  typedef SplinePositionFactor This;
+
+  /// default constructor - only use for serialization
+  SplinePositionFactor() {}
+
+  virtual ~SplinePositionFactor() {}
+
+  /**
+   * Constructor
+   * @param key0 first of the four control points of the segment
+   * @param u fraction of the segment of each measurement, in [0, 1]
+   * @param measured measured positions, in the world frame
+   * @param bodyPoints the points that were measured, in the body frame
+   * @param model diagonal noise model of a single measurement
+   */
+  SplinePositionFactor(Key key0, Key key1, Key key2, Key key3,
+                       const std::vector<double>& u,
+                       const std::vector<Point3>& measured,
+                       const std::vector<Point3>& bodyPoints,
+                       const SharedNoiseModel& model);
+
+  /**
+   * Add position measurements at arbitrary times to graph, with one factor
+   * per segment of the spline
+   */
+  static void Add(const PoseSpline& spline, const std::vector<double>& times,
+                  const std::vector<Point3>& measured,
+                  const std::vector<Point3>& bodyPoints,
+                  const SharedNoiseModel& model, NonlinearFactorGraph* graph);
+
+  /// @return a deep copy of this factor
+  virtual gtsam::NonlinearFactor::shared_ptr clone() const {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new This(*this)));
+  }
+
+  /// print
+  virtual void print(const std::string& s, const KeyFormatter& keyFormatter =
+      DefaultKeyFormatter) const;
+
+  /// equals
+  virtual bool equals(const NonlinearFactor& expected, double tol = 1e-9) const;
+
+  /// Errors of all measurements, stacked
+  Vector evaluateError(const Pose3& T0, const Pose3& T1, const Pose3& T2,
+      const Pose3& T3, boost::optional<Matrix&> H1 = boost::none,
+      boost::optional<Matrix&> H2 = boost::none,
+      boost::optional<Matrix&> H3 = boost::none,
+      boost::optional<Matrix&> H4 = boost::none) const;
+
+  const std::vector<double>& u() const { return u_; }
+  const std::vector<Point3>& measured() const { return measured_; }
+  const std::vector<Point3>& bodyPoints() const { return bodyPoints_; }
+};
+
+} // namespace gtsam
@@ -30,6 +30,17 @@ TangentPreintegration::TangentPreintegration(const boost::shared_ptr<Params>& p,
   resetIntegration();
 }
 
+//------------------------------------------------------------------------------
+TangentPreintegration::TangentPreintegration(const boost::shared_ptr<Params>& p,
+    const Bias& biasHat, double deltaTij, const Vector9& preintegrated,
+    const Matrix93& preintegrated_H_biasAcc,
+    const Matrix93& preintegrated_H_biasOmega) :
+    PreintegrationBase(p, biasHat), preintegrated_(preintegrated),
+    preintegrated_H_biasAcc_(preintegrated_H_biasAcc),
+    preintegrated_H_biasOmega_(preintegrated_H_biasOmega) {
+  deltaTij_ = deltaTij;
+}
+
 //------------------------------------------------------------------------------
 void TangentPreintegration::resetIntegration() {
   deltaTij_ = 0.0;
@@ -102,6 +113,59 @@ Vector9 TangentPreintegration::UpdatePreintegrated(const Vector3& a_body,
   return preintegratedPlus;
 }
 
+//------------------------------------------------------------------------------
+Vector9 TangentPreintegration::UpdatePreintegrated(const Vector3& a_body,
+    const Vector3& w_body, double dt, const Vector9& preintegrated,
+    UpdateJacobians* J) {
+  const auto theta = preintegrated.segment<3>(0);
+  const auto position = preintegrated.segment<3>(3);
+  const auto velocity = preintegrated.segment<3>(6);
+
+  so3::DexpFunctor local(theta);
+  Matrix3 w_tangent_H_theta;
+  const Vector3 w_tangent =
+      local.applyInvDexp(w_body, &w_tangent_H_theta, &J->H);
+  const SO3 R = local.expmap();
+  const Vector3 a_nav = R * a_body;
+  const double dt22 = 0.5 * dt * dt;
+
+  Vector9 preintegratedPlus;
+  preintegratedPlus << theta + w_tangent * dt,
+      position + velocity * dt + a_nav * dt22, velocity + a_nav * dt;
+
+  J->F = I_3x3 + w_tangent_H_theta * dt;
+  J->R = R.matrix();
+  J->G.noalias() = J->R * skewSymmetric(-a_body) * local.dexp();
+  J->dt = dt;
+  return preintegratedPlus;
+}
+
+//------------------------------------------------------------------------------
+void TangentPreintegration::update(const Vector3& measuredAcc,
+    const Vector3& measuredOmega, const double dt, UpdateJacobians* J) {
+  assert(!p().body_P_sensor);
+  const Vector3 acc = biasHat_.correctAccelerometer(measuredAcc);
+  const Vector3 omega = biasHat_.correctGyroscope(measuredOmega);
+
+  deltaTij_ += dt;
+  preintegrated_ = UpdatePreintegrated(acc, omega, dt, preintegrated_, J);
+
+  UpdateBiasJacobians(*J, &preintegrated_H_biasAcc_,
+                      &preintegrated_H_biasOmega_);
+}
+
+//------------------------------------------------------------------------------
+void TangentPreintegration::UpdateBiasJacobians(const UpdateJacobians& J,
+    Matrix93* preintegrated_H_biasAcc, Matrix93* preintegrated_H_biasOmega) {
+  // Same as the dense version: new_H_bias = A * old_H_bias - B (or C)
+  const double dt = J.dt;
+  *preintegrated_H_biasAcc = J.applyA(*preintegrated_H_biasAcc);
+  preintegrated_H_biasAcc->middleRows<3>(3) -= (0.5 * dt * dt) * J.R;
+  preintegrated_H_biasAcc->bottomRows<3>() -= dt * J.R;
+  *preintegrated_H_biasOmega = J.applyA(*preintegrated_H_biasOmega);
+  preintegrated_H_biasOmega->topRows<3>() -= dt * J.H;
+}
+
 //------------------------------------------------------------------------------
 void TangentPreintegration::update(const Vector3& measuredAcc,
     const Vector3& measuredOmega, const double dt, Matrix9* A, Matrix93* B,
@@ -53,6 +53,20 @@ public:
   TangentPreintegration(const boost::shared_ptr<Params>& p,
       const imuBias::ConstantBias& biasHat = imuBias::ConstantBias());
 
+  /**
+   *  Constructor from preintegrated quantities, e.g. integrated elsewhere
+   *  @param p                 Parameters
+   *  @param biasHat           Bias used for preintegration
+   *  @param deltaTij          Time interval from i to j
+   *  @param preintegrated     Preintegrated vector on tangent space at frame i
+   *  @param preintegrated_H_biasAcc    Jacobian w.r.t. acceleration bias
+   *  @param preintegrated_H_biasOmega  Jacobian w.r.t. angular rate bias
+   */
+  TangentPreintegration(const boost::shared_ptr<Params>& p,
+      const imuBias::ConstantBias& biasHat, double deltaTij,
+      const Vector9& preintegrated, const Matrix93& preintegrated_H_biasAcc,
+      const Matrix93& preintegrated_H_biasOmega);
+
   /// Virtual destructor
   virtual ~TangentPreintegration() {
   }
@@ -95,6 +109,51 @@ public:
                                      OptionalJacobian<9, 3> B = boost::none,
                                      OptionalJacobian<9, 3> C = boost::none);
 
+  /**
+   * Nonzero blocks of the Jacobians A, B and C of UpdatePreintegrated:
+   *   A = [F 0 0; G*dt^2/2 I I*dt; G*dt 0 I]
+   *   B = [0; R*dt^2/2; R*dt]
+   *   C = [H*dt; 0; 0]
+   * Propagating a covariance with the blocks takes a few 3x3 products instead
+   * of dense 9x9 ones.
+   */
+  struct UpdateJacobians {
+    Matrix3 F;  ///< theta wrpt theta
+    Matrix3 G;  ///< acceleration in frame i wrpt theta
+    Matrix3 R;  ///< rotation from the body frame to frame i
+    Matrix3 H;  ///< theta rate wrpt angular velocity (inverse of dexp)
+    double dt;
+
+    /// Return A * M for a matrix M with 9 rows
+    template <int N>
+    Eigen::Matrix<double, 9, N> applyA(const Eigen::Matrix<double, 9, N>& M) const {
+      Eigen::Matrix<double, 9, N> AM;
+      const Eigen::Matrix<double, 3, N> GM = G * M.template topRows<3>();
+      AM.template topRows<3>().noalias() = F * M.template topRows<3>();
+      AM.template middleRows<3>(3) = M.template middleRows<3>(3)
+          + dt * M.template bottomRows<3>() + (0.5 * dt * dt) * GM;
+      AM.template bottomRows<3>() = M.template bottomRows<3>() + dt * GM;
+      return AM;
+    }
+
+    /// Return A * P * A^T for a symmetric matrix P
+    Matrix9 propagate(const Matrix9& P) const {
+      const Matrix9 AP = applyA(P);
+      return applyA<9>(AP.transpose());
+    }
+  };
+
+  /// Version of UpdatePreintegrated that returns the Jacobians in block form
+  static Vector9 UpdatePreintegrated(const Vector3& a_body,
+                                     const Vector3& w_body, const double dt,
+                                     const Vector9& preintegrated,
+                                     UpdateJacobians* J);
+
+  /// Update the Jacobians of the preintegrated vector w.r.t. the biases
+  static void UpdateBiasJacobians(const UpdateJacobians& J,
+                                  Matrix93* preintegrated_H_biasAcc,
+                                  Matrix93* preintegrated_H_biasOmega);
+
   /// Update preintegrated measurements and get derivatives
   /// It takes measured quantities in the j frame
   /// Modifies preintegrated quantities in place after correcting for bias and possibly sensor pose
@@ -102,6 +161,11 @@ public:
   void update(const Vector3& measuredAcc, const Vector3& measuredOmega,
       const double dt, Matrix9* A, Matrix93* B, Matrix93* C) override;
 
+  /// Version of update that returns the Jacobians in block form.
+  /// Does not support body_P_sensor, use the dense version when it is set.
+  void update(const Vector3& measuredAcc, const Vector3& measuredOmega,
+      const double dt, UpdateJacobians* J);
+
   /// Given the estimate of the bias, return a NavState tangent vector
   /// summarizing the preintegrated IMU measurements so far
   /// NOTE(frank): implementation is different in two versions
@@ -154,6 +154,31 @@ TEST(CombinedImuFactor, FirstOrderPreIntegratedMeasurements) {
 }
 #endif
 
+/* ************************************************************************* */
+TEST(CombinedImuFactor, IntegrateMeasurementArrays) {
+  auto p = testing::Params();
+  p->biasAccCovariance = 1e-4 * I_3x3;
+  p->biasOmegaCovariance = 2e-4 * I_3x3;
+  p->biasAccOmegaInt = 1e-5 * Matrix6::Ones() + 1e-5 * I_6x6;
+  testing::SomeMeasurements measurements;
+  const size_t n = measurements.size();
+  Matrix accs(3, n), gyros(3, n), dts(1, n);
+  for (size_t k = 0; k < n; k++) {
+    accs.col(k) = measurements[k].acc;
+    gyros.col(k) = measurements[k].gyro;
+    dts(0, k) = measurements[k].dt;
+  }
+  const Bias biasHat(Vector3(0.01, -0.02, 0.03), Vector3(0.001, 0.002, -0.001));
+
+  PreintegratedCombinedMeasurements expected(p, biasHat);
+  testing::integrateMeasurements(measurements, &expected);
+  PreintegratedCombinedMeasurements actual(p, biasHat);
+  actual.integrateMeasurements(accs.data(), gyros.data(), dts.data(), n);
+  EXPECT(expected.equals(actual, 1e-12));
+  EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(),
+                      1e-9 * expected.preintMeasCov().norm()));
+}
+
 /* ************************************************************************* */
 TEST(CombinedImuFactor, PredictPositionAndVelocity) {
   const Bias bias(Vector3(0, 0.1, 0), Vector3(0, 0.1, 0));  // Biases (acc, rot)
@@ -239,6 +239,82 @@ TEST(ImuFactor, MultipleMeasurements) {
   EXPECT(assert_equal(expected,actual));
 }
 
+/* ************************************************************************* */
+TEST(ImuFactor, IntegrateMeasurementArrays) {
+  testing::SomeMeasurements measurements;
+  const size_t n = measurements.size();
+  Matrix accs(3, n), gyros(3, n), dts(1, n);
+  for (size_t k = 0; k < n; k++) {
+    accs.col(k) = measurements[k].acc;
+    gyros.col(k) = measurements[k].gyro;
+    dts(0, k) = measurements[k].dt;
+  }
+  const Bias biasHat(Vector3(0.01, -0.02, 0.03), Vector3(0.001, 0.002, -0.001));
+
+  PreintegratedImuMeasurements expected(testing::Params(), biasHat);
+  testing::integrateMeasurements(measurements, &expected);
+  PreintegratedImuMeasurements actual(testing::Params(), biasHat);
+  actual.integrateMeasurements(accs.data(), gyros.data(), dts.data(), n);
+  EXPECT(assert_equal(expected, actual, 1e-12));
+  EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(),
+                      1e-9 * expected.preintMeasCov().norm()));
+
+  // With a sensor pose, the arrays are integrated one measurement at a time
+  auto p = testing::Params();
+  p->body_P_sensor = Pose3(Rot3::Ypr(0.1, 0.2, 0.3), Point3(0.1, 0, 0.2));
+  PreintegratedImuMeasurements expected2(p, biasHat);
+  testing::integrateMeasurements(measurements, &expected2);
+  PreintegratedImuMeasurements actual2(p, biasHat);
+  actual2.integrateMeasurements(accs, gyros, dts);
+  EXPECT(assert_equal(expected2, actual2));
+
+  dts(0, n / 2) = 0;
+  CHECK_EXCEPTION(actual.integrateMeasurements(accs, gyros, dts),
+                  std::runtime_error);
+}
+
+/* ************************************************************************* */
+TEST(ImuFactor, KeepMeasurements) {
+  testing::SomeMeasurements measurements;
+  PreintegratedImuMeasurements pim(testing::Params());
+  pim.keepMeasurements(0.01);
+  testing::integrateMeasurements(measurements, &pim);
+  CHECK_EXCEPTION(pim.keepMeasurements(0.01), std::logic_error);
+  const ImuFactor factor(X(1), V(1), X(2), V(2), B(1), pim);
+
+  const NavState state_i, state_j = pim.predict(state_i, kZeroBias);
+  const Pose3 x1 = state_i.pose(), x2 = state_j.pose();
+  const Vector3 v1 = state_i.v(), v2 = state_j.v();
+
+  // A small bias change uses the first-order correction
+  const Bias small(Vector3(0.001, 0, 0), Vector3(0, 0.001, 0));
+  EXPECT(assert_equal(pim.computeErrorAndJacobians(x1, v1, x2, v2, small),
+                      factor.evaluateError(x1, v1, x2, v2, small)));
+
+  // A large one re-integrates, as if preintegrated with that bias
+  const Bias large(Vector3(0.2, -0.1, 0.3), Vector3(0.05, 0.1, -0.05));
+  PreintegratedImuMeasurements expected(testing::Params(), large);
+  testing::integrateMeasurements(measurements, &expected);
+  EXPECT(assert_equal(expected, pim.reintegrated(large), 1e-9));
+  Matrix H1, H2, H3, H4, H5, eH5;
+  const Vector expectedError = expected.computeErrorAndJacobians(x1, v1, x2,
+      v2, large, boost::none, boost::none, boost::none, boost::none, eH5);
+  const Vector error = factor.evaluateError(x1, v1, x2, v2, large, H1, H2, H3,
+                                            H4, H5);
+  EXPECT(assert_equal(expectedError, error, 1e-9));
+  EXPECT(assert_equal(eH5, H5, 1e-9));
+  const Vector firstOrderError =
+      pim.computeErrorAndJacobians(x1, v1, x2, v2, large);
+  EXPECT(!equal_with_abs_tol(expectedError, firstOrderError, 1e-6));
+
+  // The re-integration is reused near the same bias
+  const Bias nearLarge(large.accelerometer() + Vector3(0.001, 0, 0),
+                       large.gyroscope());
+  EXPECT(assert_equal(
+      expected.computeErrorAndJacobians(x1, v1, x2, v2, nearLarge),
+      factor.evaluateError(x1, v1, x2, v2, nearLarge), 1e-9));
+}
+
 /* ************************************************************************* */
 TEST(ImuFactor, ErrorAndJacobians) {
   using namespace common;
@@ -0,0 +1,191 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPoseSpline.cpp
+ * @brief   Unit test for PoseSpline and the spline factors
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/PoseSpline.h>
+#include <gtsam/navigation/SplineFactor.h>
+#include <gtsam/navigation/Scenario.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/factorTesting.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::C;
+
+static const Pose3 kT0(Rot3::RzRyRx(0.1, -0.2, 0.3), Point3(1, 2, 3));
+static const Pose3 kT1(Rot3::RzRyRx(0.2, -0.1, 0.4), Point3(1.5, 2, 3.1));
+static const Pose3 kT2(Rot3::RzRyRx(0.4, 0.0, 0.3), Point3(2, 2.3, 3));
+static const Pose3 kT3(Rot3::RzRyRx(0.5, 0.1, 0.2), Point3(2.4, 2.5, 2.9));
+
+static const ConstantTwistScenario kScenario(Vector3(0, 0.1, 0.4),
+                                             Vector3(2, 0, 0));
+
+/* ************************************************************************* */
+TEST(PoseSpline, CumulativeBasis) {
+  EXPECT(assert_equal(Vector4(1, 5.0 / 6, 1.0 / 6, 0),
+                      PoseSpline::CumulativeBasis(0)));
+  EXPECT(assert_equal(Vector4(1, 1, 5.0 / 6, 1.0 / 6),
+                      PoseSpline::CumulativeBasis(1)));
+}
+
+/* ************************************************************************* */
+TEST(PoseSpline, Segment) {
+  // At the knots, the pose only depends on three control points
+  const PoseSpline::Segment segment(kT0, kT1, kT2, kT3, true);
+  const PoseSpline::Segment other(kT0, kT1, kT2, Pose3(), true);
+  EXPECT(assert_equal(other.pose(0), segment.pose(0), 1e-9));
+
+  // Derivatives w.r.t. the control points
+  const double u = 0.3;
+  PoseSpline::Matrix624 H;
+  segment.pose(u, H);
+  const auto f = [u](const Pose3& T0, const Pose3& T1, const Pose3& T2,
+                     const Pose3& T3) {
+    return PoseSpline::Segment(T0, T1, T2, T3).pose(u);
+  };
+  EXPECT(assert_equal(numericalDerivative41<Pose3, Pose3, Pose3, Pose3, Pose3>(
+                          f, kT0, kT1, kT2, kT3),
+                      Matrix(H.block<6, 6>(0, 0)), 1e-7));
+  EXPECT(assert_equal(numericalDerivative42<Pose3, Pose3, Pose3, Pose3, Pose3>(
+                          f, kT0, kT1, kT2, kT3),
+                      Matrix(H.block<6, 6>(0, 6)), 1e-7));
+  EXPECT(assert_equal(numericalDerivative43<Pose3, Pose3, Pose3, Pose3, Pose3>(
+                          f, kT0, kT1, kT2, kT3),
+                      Matrix(H.block<6, 6>(0, 12)), 1e-7));
+  EXPECT(assert_equal(numericalDerivative44<Pose3, Pose3, Pose3, Pose3, Pose3>(
+                          f, kT0, kT1, kT2, kT3),
+                      Matrix(H.block<6, 6>(0, 18)), 1e-7));
+
+  // Derivatives need a segment constructed with them
+  const PoseSpline::Segment withoutJacobians(kT0, kT1, kT2, kT3);
+  CHECK_EXCEPTION(withoutJacobians.pose(u, H), std::logic_error);
+}
+
+/* ************************************************************************* */
+TEST(PoseSpline, ConstantTwist) {
+  // A constant twist is represented exactly
+  const PoseSpline spline(0.5, 0.2, C(0));
+  const Values values = spline.initialize(
+      [](double t) { return kScenario.pose(t); }, 2.0);
+  EXPECT_LONGS_EQUAL(11, values.size());
+  for (double t = 0.5; t < 2.0; t += 0.07)
+    EXPECT(assert_equal(kScenario.pose(t), spline.pose(values, t), 1e-9));
+
+  double u;
+  EXPECT_LONGS_EQUAL(2, spline.segment(0.95, &u));
+  EXPECT_DOUBLES_EQUAL(0.25, u, 1e-9);
+  CHECK_EXCEPTION(spline.segment(0.4, &u), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(SplinePoseFactor, Jacobians) {
+  const vector<double> u = {0.0, 0.3, 0.9};
+  const vector<Pose3> measured = {kT1, kT2.retract(Vector6::Constant(0.01)),
+                                  kT3};
+  const SplinePoseFactor factor(C(0), C(1), C(2), C(3), u, measured,
+                                noiseModel::Diagonal::Sigmas(
+                                    (Vector6() << 1, 1, 1, 2, 2, 2).finished()));
+  EXPECT_LONGS_EQUAL(18, factor.dim());
+
+  Values values;
+  values.insert(C(0), kT0);
+  values.insert(C(1), kT1);
+  values.insert(C(2), kT2);
+  values.insert(C(3), kT3);
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-5, 1e-7);
+
+  // The stacked error is that of each measurement
+  const PoseSpline::Segment segment(kT0, kT1, kT2, kT3);
+  const Vector error = factor.evaluateError(kT0, kT1, kT2, kT3);
+  EXPECT(assert_equal(Pose3::Logmap(measured[1].between(segment.pose(u[1]))),
+                      Vector(error.segment<6>(6)), 1e-9));
+
+  // Only diagonal noise models can be stacked
+  CHECK_EXCEPTION(SplinePoseFactor(C(0), C(1), C(2), C(3), u, measured,
+                                   noiseModel::Gaussian::Information(I_6x6 + Matrix6::Constant(0.1))),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(SplinePositionFactor, Jacobians) {
+  const vector<double> u = {0.1, 0.5};
+  const vector<Point3> measured = {Point3(1, 2, 3), Point3(2, 2, 3)};
+  const vector<Point3> bodyPoints = {Point3(0.1, 0, 0), Point3(0, 0.2, -0.1)};
+  const SplinePositionFactor factor(C(0), C(1), C(2), C(3), u, measured,
+                                    bodyPoints, noiseModel::Unit::Create(3));
+  EXPECT_LONGS_EQUAL(6, factor.dim());
+
+  Values values;
+  values.insert(C(0), kT0);
+  values.insert(C(1), kT1);
+  values.insert(C(2), kT2);
+  values.insert(C(3), kT3);
+  EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-5, 1e-7);
+}
+
+/* ************************************************************************* */
+TEST(SplineFactor, Fit) {
+  // Pose and lever-arm position measurements at times that are not knots
+  const PoseSpline spline(0.0, 0.25, C(0));
+  const double tEnd = 2.0;
+  vector<double> poseTimes, positionTimes;
+  vector<Pose3> poses;
+  vector<Point3> positions, bodyPoints;
+  const Point3 leverArm(0.1, -0.2, 0.3);
+  for (double t = 0.0; t < tEnd; t += 0.1) {
+    poseTimes.push_back(t);
+    poses.push_back(kScenario.pose(t));
+  }
+  for (double t = 0.02; t < tEnd; t += 0.03) {
+    positionTimes.push_back(t);
+    positions.push_back(kScenario.pose(t).transformFrom(leverArm));
+    bodyPoints.push_back(leverArm);
+  }
+
+  NonlinearFactorGraph graph;
+  SplinePoseFactor::Add(spline, poseTimes, poses,
+                        noiseModel::Isotropic::Sigma(6, 0.1), &graph);
+  const size_t nrPoseFactors = graph.size();
+  EXPECT_LONGS_EQUAL(8, nrPoseFactors);
+  SplinePositionFactor::Add(spline, positionTimes, positions, bodyPoints,
+                            noiseModel::Isotropic::Sigma(3, 0.01), &graph);
+  EXPECT_LONGS_EQUAL(16, graph.size());
+
+  // Start from perturbed control points, covering the last measurement
+  const double tLast = max(poseTimes.back(), positionTimes.back());
+  const Values initial = spline.initialize(
+      [](double t) {
+        return kScenario.pose(t).retract(0.05 * Vector6::Constant(sin(7 * t)));
+      },
+      tLast);
+  const Values result =
+      LevenbergMarquardtOptimizer(graph, initial).optimize();
+  EXPECT_DOUBLES_EQUAL(0.0, graph.error(result), 1e-9);
+  for (double t = 0.05; t < tEnd; t += 0.11)
+    EXPECT(assert_equal(kScenario.pose(t), spline.pose(result, t), 1e-5));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,157 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testPreintegrationBatch.cpp
+ * @brief   Unit test for preintegration of many IMU streams at once
+ * @date    October 2026
+ */
+
+#include <gtsam/navigation/PreintegrationBatch.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include "imuFactorTesting.h"
+
+#ifdef GTSAM_TANGENT_PREINTEGRATION
+
+namespace testing {
+// Create default parameters with Z-down and above noise parameters
+static boost::shared_ptr<PreintegrationParams> Params() {
+  auto p = PreintegrationParams::MakeSharedD(kGravity);
+  p->gyroscopeCovariance = kGyroSigma * kGyroSigma * I_3x3;
+  p->accelerometerCovariance = kAccelSigma * kAccelSigma * I_3x3;
+  p->integrationCovariance = 0.0001 * I_3x3;
+  return p;
+}
+
+// Interleaved samples of two streams, stream 1 with twice the rate
+struct TwoStreams {
+  std::vector<size_t> streams;
+  std::vector<double> times, accs, omegas;
+  TwoStreams() {
+    const SomeMeasurements measurements;
+    for (size_t k = 0; k < measurements.size(); k++) {
+      for (size_t s = 0; s < 2; s++) {
+        for (size_t r = 0; r <= s; r++) {
+          const ImuMeasurement& m = measurements[(k + 7 * s + r) % 100];
+          streams.push_back(s);
+          times.push_back(0.01 * (k + 1) - 0.005 * (s - r));
+          const Vector3 acc = m.acc * (1 + s), omega = m.gyro * (1 - 0.5 * s);
+          accs.insert(accs.end(), acc.data(), acc.data() + 3);
+          omegas.insert(omegas.end(), omega.data(), omega.data() + 3);
+        }
+      }
+    }
+  }
+  size_t size() const { return streams.size(); }
+
+  // Integrate the samples of stream s up to time end into pim
+  void integrate(size_t s, double end, double* time,
+                 PreintegratedImuMeasurements* pim) const {
+    for (size_t k = 0; k < size(); k++) {
+      if (streams[k] != s || times[k] <= *time) continue;
+      const double t = std::min(times[k], end);
+      pim->integrateMeasurement(Vector3(&accs[3 * k]), Vector3(&omegas[3 * k]),
+                                t - *time);
+      *time = t;
+      if (t == end) break;
+    }
+  }
+};
+}  // namespace testing
+
+/* ************************************************************************* */
+TEST(PreintegrationBatch, Integrate) {
+  const testing::TwoStreams samples;
+  const Bias bias0, bias1(Vector3(0.01, 0, -0.02), Vector3(0, 0.001, 0));
+
+  PreintegrationBatch batch(testing::Params());
+  EXPECT_LONGS_EQUAL(0, batch.addStream(0.0, bias0));
+  EXPECT_LONGS_EQUAL(1, batch.addStream(0.0, bias1));
+
+  // Integrate in two batches
+  const size_t half = samples.size() / 2;
+  batch.integrate(samples.streams.data(), samples.times.data(),
+                  samples.accs.data(), samples.omegas.data(), half);
+  batch.integrate(samples.streams.data() + half, samples.times.data() + half,
+                  samples.accs.data() + 3 * half,
+                  samples.omegas.data() + 3 * half, samples.size() - half);
+
+  // Compare with separate preintegration of each stream
+  for (size_t s = 0; s < 2; s++) {
+    PreintegratedImuMeasurements expected(testing::Params(), s ? bias1 : bias0);
+    double time = 0.0;
+    samples.integrate(s, 1e9, &time, &expected);
+    const PreintegratedImuMeasurements actual = batch.preintegrated(s);
+    EXPECT(assert_equal(expected, actual, 1e-9));
+    EXPECT(assert_equal(expected.preintMeasCov(), actual.preintMeasCov(),
+                        1e-9 * expected.preintMeasCov().norm()));
+    EXPECT_DOUBLES_EQUAL(time, batch.time(s), 1e-12);
+  }
+
+  // Samples that go back in time are rejected before anything is integrated
+  const size_t streams[] = {0, 1};
+  const double times[] = {2.0, 0.5}, accs[6] = {0}, omegas[6] = {0};
+  const double time0 = batch.time(0);
+  CHECK_EXCEPTION(batch.integrate(streams, times, accs, omegas, 2),
+                  std::runtime_error);
+  EXPECT_DOUBLES_EQUAL(time0, batch.time(0), 0);
+}
+
+/* ************************************************************************* */
+TEST(PreintegrationBatch, Keyframes) {
+  const testing::TwoStreams samples;
+  PreintegrationBatch batch(testing::Params());
+  batch.addStream(0.0);
+  batch.addStream(0.0);
+
+  // Keyframes between samples of stream 0, and at a sample of stream 1
+  batch.addKeyframe(0, 0.333, X(0), V(0), X(1), V(1), B(0));
+  batch.addKeyframe(0, 0.6666, X(1), V(1), X(2), V(2), B(0));
+  batch.addKeyframe(1, 0.5, X(10), V(10), X(11), V(11), B(10));
+  CHECK_EXCEPTION(batch.addKeyframe(1, 0.5, X(11), V(11), X(12), V(12), B(10)),
+                  std::invalid_argument);
+
+  NonlinearFactorGraph factors;
+  batch.integrate(samples.streams.data(), samples.times.data(),
+                  samples.accs.data(), samples.omegas.data(), samples.size(),
+                  &factors);
+  LONGS_EQUAL(3, factors.size());
+
+  // Factors are ordered by stream, then time
+  const double ends[] = {0.333, 0.6666, 0.5};
+  const size_t streamOf[] = {0, 0, 1};
+  double time[] = {0.0, 0.0};
+  for (size_t i = 0; i < 3; i++) {
+    const size_t s = streamOf[i];
+    PreintegratedImuMeasurements pim(testing::Params());
+    samples.integrate(s, ends[i], &time[s], &pim);
+    const Key j = 10 * s + (i % 2);
+    const ImuFactor expected(X(j), V(j), X(j + 1), V(j + 1), B(10 * s), pim);
+    EXPECT(expected.equals(*factors[i], 1e-9));
+  }
+
+  // The rest of the samples is still being integrated
+  PreintegratedImuMeasurements rest(testing::Params());
+  samples.integrate(0, 1e9, &time[0], &rest);
+  EXPECT(assert_equal(rest, batch.preintegrated(0), 1e-9));
+}
+
+#endif
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
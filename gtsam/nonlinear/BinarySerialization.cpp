@@ -0,0 +1,601 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinarySerialization.cpp
+ * @date October 2026
+ * @brief Compact, versioned binary files for graphs, Values and Bayes trees
+ */
+
+#include <gtsam/nonlinear/BinarySerialization.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/linear/HessianFactor.h>
+
+#include <boost/make_shared.hpp>
+
+#include <limits>
+
+using namespace std;
+
+namespace gtsam {
+
+/// LinearContainerFactor as its Gaussian factor and linearization point
+template<>
+struct BinaryCodec<LinearContainerFactor> {
+  static void write(BinaryOutArchive& ar, const LinearContainerFactor& factor) {
+    writeGaussianFactor(ar, factor.factor());
+    ar.write<uint8_t>(factor.hasLinearizationPoint());
+    if (factor.hasLinearizationPoint())
+      writeBinary(ar, *factor.linearizationPoint());
+  }
+  static boost::shared_ptr<LinearContainerFactor> read(BinaryInArchive& ar) {
+    const GaussianFactor::shared_ptr factor = readGaussianFactor(ar);
+    Values linearizationPoint;  // stored with the keys of the factor only
+    if (ar.read<uint8_t>()) readBinary(ar, linearizationPoint);
+    return boost::make_shared<LinearContainerFactor>(factor, linearizationPoint);
+  }
+};
+
+/* ************************************************************************* */
+BinaryRegistry::BinaryRegistry() {
+  registerValue<double>("double");
+  registerValue<Vector>("Vector");
+  registerValue<Matrix>("Matrix");
+  registerValue<Vector2>("Vector2");
+  registerValue<Vector3>("Vector3");
+  registerValue<Vector6>("Vector6");
+  registerValue<Point2>("Point2");
+  registerValue<Point3>("Point3");
+  registerValue<Rot2>("Rot2");
+  registerValue<Rot3>("Rot3");
+  registerValue<Pose2>("Pose2");
+  registerValue<Pose3>("Pose3");
+  registerValue<Cal3_S2>("Cal3_S2");
+  registerValue<Cal3Bundler>("Cal3Bundler");
+  registerFactor<LinearContainerFactor>("LinearContainerFactor");
+  internal::registerSlamFactors(*this);
+}
+
+/* ************************************************************************* */
+BinaryRegistry& BinaryRegistry::Instance() {
+  static BinaryRegistry registry;
+  return registry;
+}
+
+/* ************************************************************************* */
+void BinaryRegistry::add(const type_info& type, const ValueType& valueType) {
+  // With GTSAM_TYPEDEF_POINTS_TO_VECTORS, Point2 is Vector2: keep the first
+  auto inserted = valuesByType_.insert(make_pair(type_index(type), valueType));
+  if (inserted.second)
+    valuesByName_[valueType.name] = &inserted.first->second;
+}
+
+/* ************************************************************************* */
+void BinaryRegistry::add(const type_info& type, const FactorType& factorType) {
+  auto inserted = factorsByType_.insert(make_pair(type_index(type), factorType));
+  if (inserted.second)
+    factorsByName_[factorType.name] = &inserted.first->second;
+}
+
+/* ************************************************************************* */
+const BinaryRegistry::ValueType& BinaryRegistry::valueType(
+    const type_info& type) const {
+  auto it = valuesByType_.find(type_index(type));
+  if (it == valuesByType_.end())
+    throw invalid_argument(string("BinaryRegistry: unregistered value type ") +
+                           type.name());
+  return it->second;
+}
+
+/* ************************************************************************* */
+const BinaryRegistry::ValueType& BinaryRegistry::valueType(
+    const string& name) const {
+  auto it = valuesByName_.find(name);
+  if (it == valuesByName_.end())
+    throw runtime_error("BinaryRegistry: unknown value type " + name);
+  return *it->second;
+}
+
+/* ************************************************************************* */
+const BinaryRegistry::FactorType& BinaryRegistry::factorType(
+    const type_info& type) const {
+  auto it = factorsByType_.find(type_index(type));
+  if (it == factorsByType_.end())
+    throw invalid_argument(string("BinaryRegistry: unregistered factor type ") +
+                           type.name());
+  return it->second;
+}
+
+/* ************************************************************************* */
+const BinaryRegistry::FactorType& BinaryRegistry::factorType(
+    const string& name) const {
+  auto it = factorsByName_.find(name);
+  if (it == factorsByName_.end())
+    throw runtime_error("BinaryRegistry: unknown factor type " + name);
+  return *it->second;
+}
+
+/* ************************************************************************* */
+namespace {
+
+enum NoiseModelKind : uint8_t {
+  NULL_MODEL, UNIT, ISOTROPIC, DIAGONAL, CONSTRAINED, GAUSSIAN, ROBUST
+};
+
+enum EstimatorKind : uint8_t {
+  ESTIMATOR_NULL, ESTIMATOR_FAIR, ESTIMATOR_HUBER, ESTIMATOR_CAUCHY,
+  ESTIMATOR_TUKEY, ESTIMATOR_WELSCH, ESTIMATOR_GEMAN_MCCLURE, ESTIMATOR_DCS,
+  ESTIMATOR_L2_WITH_DEAD_ZONE
+};
+
+enum GaussianFactorKind : uint8_t {
+  NULL_FACTOR, JACOBIAN, HESSIAN, CONDITIONAL
+};
+
+const uint32_t kNullType = numeric_limits<uint32_t>::max();
+
+typedef noiseModel::mEstimator::Base Estimator;
+
+/// Write the estimator kind and parameter, if ESTIMATOR is the type of e
+template<class ESTIMATOR>
+bool writeEstimatorAs(BinaryOutArchive& ar, const Estimator& e,
+                      EstimatorKind kind) {
+  const ESTIMATOR* estimator = dynamic_cast<const ESTIMATOR*>(&e);
+  if (!estimator) return false;
+  ar.write(kind);
+  ar.write<uint8_t>(e.reweightScheme());
+  ar.write(estimator->modelParameter());
+  return true;
+}
+
+void writeEstimator(BinaryOutArchive& ar, const Estimator& e) {
+  using namespace noiseModel::mEstimator;
+  if (dynamic_cast<const Null*>(&e)) {
+    ar.write(ESTIMATOR_NULL);
+    ar.write<uint8_t>(e.reweightScheme());
+    ar.write(0.0);
+  } else if (!writeEstimatorAs<Fair>(ar, e, ESTIMATOR_FAIR) &&
+             !writeEstimatorAs<Huber>(ar, e, ESTIMATOR_HUBER) &&
+             !writeEstimatorAs<Cauchy>(ar, e, ESTIMATOR_CAUCHY) &&
+             !writeEstimatorAs<Tukey>(ar, e, ESTIMATOR_TUKEY) &&
+             !writeEstimatorAs<Welsch>(ar, e, ESTIMATOR_WELSCH) &&
+             !writeEstimatorAs<GemanMcClure>(ar, e, ESTIMATOR_GEMAN_MCCLURE) &&
+             !writeEstimatorAs<DCS>(ar, e, ESTIMATOR_DCS) &&
+             !writeEstimatorAs<L2WithDeadZone>(ar, e, ESTIMATOR_L2_WITH_DEAD_ZONE)) {
+    throw invalid_argument(string("writeNoiseModel: unsupported estimator ") +
+                           typeid(e).name());
+  }
+}
+
+Estimator::shared_ptr readEstimator(BinaryInArchive& ar) {
+  using namespace noiseModel::mEstimator;
+  const uint8_t kind = ar.read<uint8_t>();
+  const Base::ReweightScheme reweight =
+      static_cast<Base::ReweightScheme>(ar.read<uint8_t>());
+  const double c = ar.read<double>();
+  switch (kind) {
+    case ESTIMATOR_NULL: return Null::Create();
+    case ESTIMATOR_FAIR: return Fair::Create(c, reweight);
+    case ESTIMATOR_HUBER: return Huber::Create(c, reweight);
+    case ESTIMATOR_CAUCHY: return Cauchy::Create(c, reweight);
+    case ESTIMATOR_TUKEY: return Tukey::Create(c, reweight);
+    case ESTIMATOR_WELSCH: return Welsch::Create(c, reweight);
+    case ESTIMATOR_GEMAN_MCCLURE: return GemanMcClure::Create(c, reweight);
+    case ESTIMATOR_DCS: return DCS::Create(c, reweight);
+    case ESTIMATOR_L2_WITH_DEAD_ZONE: return L2WithDeadZone::Create(c, reweight);
+  }
+  throw runtime_error("readNoiseModel: unknown estimator");
+}
+
+/// Dimensions of the blocks of a VerticalBlockMatrix, including the last one
+vector<uint64_t> blockDims(const VerticalBlockMatrix& Ab) {
+  vector<uint64_t> dims(Ab.nBlocks());
+  for (DenseIndex i = 0; i < Ab.nBlocks(); ++i) dims[i] = Ab(i).cols();
+  return dims;
+}
+
+void writeDims(BinaryOutArchive& ar, const vector<uint64_t>& dims) {
+  ar.write<uint64_t>(dims.size());
+  ar.writeBytes(dims.data(), dims.size() * sizeof(uint64_t));
+}
+
+vector<uint64_t> readDims(BinaryInArchive& ar) {
+  vector<uint64_t> dims(ar.readCount<uint64_t>());
+  for (uint64_t& dim : dims) dim = ar.read<uint64_t>();
+  return dims;
+}
+
+/// Write the active view of Ab column by column, like writeMatrix
+void writeActiveView(BinaryOutArchive& ar, const VerticalBlockMatrix& Ab) {
+  const VerticalBlockMatrix::constBlock full = Ab.full();
+  ar.write<uint64_t>(full.rows());
+  ar.write<uint64_t>(full.cols());
+  for (DenseIndex j = 0; j < full.cols(); ++j)
+    ar.writeDoubles(full.data() + j * full.outerStride(), full.rows());
+}
+
+/// Read a VerticalBlockMatrix written with blockDims and writeActiveView
+VerticalBlockMatrix readVerticalBlockMatrix(BinaryInArchive& ar) {
+  const vector<uint64_t> dims = readDims(ar);
+  const Eigen::Map<const Matrix> matrix = ar.readMatrix();
+  VerticalBlockMatrix Ab(dims, matrix.rows());
+  if (Ab.cols() != matrix.cols())
+    throw runtime_error("readGaussianFactor: inconsistent block dimensions");
+  Ab.matrix() = matrix;
+  return Ab;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void writeNoiseModel(BinaryOutArchive& ar, const SharedNoiseModel& model) {
+  using namespace noiseModel;
+  if (!model) {
+    ar.write(NULL_MODEL);
+  } else if (const Robust* robust = dynamic_cast<const Robust*>(model.get())) {
+    ar.write(ROBUST);
+    writeEstimator(ar, *robust->robust());
+    writeNoiseModel(ar, robust->noise());
+  } else if (const Constrained* constrained =
+                 dynamic_cast<const Constrained*>(model.get())) {
+    ar.write(CONSTRAINED);
+    ar.writeVector(constrained->sigmas());
+    ar.writeVector(constrained->mu());
+  } else if (dynamic_cast<const Unit*>(model.get())) {
+    ar.write(UNIT);
+    ar.write<uint64_t>(model->dim());
+  } else if (const Isotropic* isotropic =
+                 dynamic_cast<const Isotropic*>(model.get())) {
+    ar.write(ISOTROPIC);
+    ar.write<uint64_t>(model->dim());
+    ar.write(isotropic->sigma());
+  } else if (const Diagonal* diagonal =
+                 dynamic_cast<const Diagonal*>(model.get())) {
+    ar.write(DIAGONAL);
+    ar.writeVector(diagonal->sigmas());
+  } else if (const Gaussian* gaussian =
+                 dynamic_cast<const Gaussian*>(model.get())) {
+    ar.write(GAUSSIAN);
+    ar.writeMatrix(gaussian->R());
+  } else {
+    throw invalid_argument(string("writeNoiseModel: unsupported noise model ") +
+                           typeid(*model).name());
+  }
+}
+
+/* ************************************************************************* */
+SharedNoiseModel readNoiseModel(BinaryInArchive& ar) {
+  using namespace noiseModel;
+  switch (ar.read<uint8_t>()) {
+    case NULL_MODEL:
+      return SharedNoiseModel();
+    case ROBUST: {
+      const mEstimator::Base::shared_ptr estimator = readEstimator(ar);
+      return Robust::Create(estimator, readNoiseModel(ar));
+    }
+    case CONSTRAINED: {
+      const Vector sigmas = ar.readVector();
+      return Constrained::MixedSigmas(ar.readVector(), sigmas);
+    }
+    case UNIT:
+      return Unit::Create(ar.read<uint64_t>());
+    case ISOTROPIC: {
+      const uint64_t dim = ar.read<uint64_t>();
+      return Isotropic::Sigma(dim, ar.read<double>(), false);
+    }
+    case DIAGONAL:
+      return Diagonal::Sigmas(ar.readVector(), false);
+    case GAUSSIAN:
+      return Gaussian::SqrtInformation(ar.readMatrix(), false);
+  }
+  throw runtime_error("readNoiseModel: unknown noise model");
+}
+
+/* ************************************************************************* */
+void writeGaussianFactor(BinaryOutArchive& ar,
+                         const GaussianFactor::shared_ptr& factor) {
+  if (!factor) {
+    ar.write(NULL_FACTOR);
+  } else if (const GaussianConditional* conditional =
+                 dynamic_cast<const GaussianConditional*>(factor.get())) {
+    ar.write(CONDITIONAL);
+    writeKeys(ar, conditional->keys());
+    ar.write<uint64_t>(conditional->nrFrontals());
+    writeDims(ar, blockDims(conditional->matrixObject()));
+    writeActiveView(ar, conditional->matrixObject());
+    writeNoiseModel(ar, conditional->get_model());
+  } else if (const JacobianFactor* jacobian =
+                 dynamic_cast<const JacobianFactor*>(factor.get())) {
+    ar.write(JACOBIAN);
+    writeKeys(ar, jacobian->keys());
+    writeDims(ar, blockDims(jacobian->matrixObject()));
+    writeActiveView(ar, jacobian->matrixObject());
+    writeNoiseModel(ar, jacobian->get_model());
+  } else if (const HessianFactor* hessian =
+                 dynamic_cast<const HessianFactor*>(factor.get())) {
+    ar.write(HESSIAN);
+    writeKeys(ar, hessian->keys());
+    const SymmetricBlockMatrix& info = hessian->info();
+    vector<uint64_t> dims(info.nBlocks());
+    for (DenseIndex i = 0; i < info.nBlocks(); ++i) dims[i] = info.getDim(i);
+    writeDims(ar, dims);
+    ar.writeMatrix(Matrix(info.selfadjointView()));
+  } else {
+    throw invalid_argument(string("writeGaussianFactor: unsupported factor ") +
+                           typeid(*factor).name());
+  }
+}
+
+/* ************************************************************************* */
+GaussianFactor::shared_ptr readGaussianFactor(BinaryInArchive& ar) {
+  switch (ar.read<uint8_t>()) {
+    case NULL_FACTOR:
+      return GaussianFactor::shared_ptr();
+    case CONDITIONAL: {
+      const KeyVector keys = readKeys(ar);
+      const uint64_t nrFrontals = ar.read<uint64_t>();
+      const VerticalBlockMatrix Ab = readVerticalBlockMatrix(ar);
+      const SharedDiagonal model =
+          boost::dynamic_pointer_cast<noiseModel::Diagonal>(readNoiseModel(ar));
+      return boost::make_shared<GaussianConditional>(keys, nrFrontals, Ab, model);
+    }
+    case JACOBIAN: {
+      // Fill in the factor directly, to copy the matrix only once
+      const boost::shared_ptr<JacobianFactor> factor =
+          boost::make_shared<JacobianFactor>();
+      factor->keys() = readKeys(ar);
+      factor->matrixObject() = readVerticalBlockMatrix(ar);
+      factor->get_model() =
+          boost::dynamic_pointer_cast<noiseModel::Diagonal>(readNoiseModel(ar));
+      return factor;
+    }
+    case HESSIAN: {
+      const KeyVector keys = readKeys(ar);
+      const vector<uint64_t> dims = readDims(ar);
+      const Matrix info = ar.readMatrix();
+      return boost::make_shared<HessianFactor>(
+          keys, SymmetricBlockMatrix(dims, info));
+    }
+  }
+  throw runtime_error("readGaussianFactor: unknown factor type");
+}
+
+/* ************************************************************************* */
+void writeKeys(BinaryOutArchive& ar, const KeyVector& keys) {
+  ar.write<uint64_t>(keys.size());
+  ar.writeBytes(keys.data(), keys.size() * sizeof(Key));
+}
+
+/* ************************************************************************* */
+KeyVector readKeys(BinaryInArchive& ar) {
+  KeyVector keys(ar.readCount<Key>());
+  for (Key& key : keys) key = ar.read<Key>();
+  return keys;
+}
+
+/* ************************************************************************* */
+namespace {
+/// Names of the types used in a section, with their index in the section
+template<class TYPE>
+class TypeTable {
+  unordered_map<const TYPE*, uint32_t> indices_;
+  vector<const TYPE*> types_;
+
+public:
+  uint32_t index(const TYPE& type) {
+    auto inserted = indices_.insert(make_pair(&type, uint32_t(types_.size())));
+    if (inserted.second) types_.push_back(&type);
+    return inserted.first->second;
+  }
+
+  void write(BinaryOutArchive& ar) const {
+    ar.write<uint32_t>(types_.size());
+    for (const TYPE* type : types_) ar.writeString(type->name);
+  }
+};
+
+/// Read the table of type names of a section, and look them up
+template<class TYPE, class LOOKUP>
+vector<const TYPE*> readTypeTable(BinaryInArchive& ar, LOOKUP lookup) {
+  vector<const TYPE*> types(ar.read<uint32_t>());
+  for (const TYPE*& type : types) type = &lookup(ar.readString());
+  return types;
+}
+}  // namespace
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const Values& values) {
+  const BinaryRegistry& registry = BinaryRegistry::Instance();
+  TypeTable<BinaryRegistry::ValueType> table;
+  vector<pair<const BinaryRegistry::ValueType*, uint32_t> > types;
+  types.reserve(values.size());
+  for (const auto& keyValue : values) {
+    const BinaryRegistry::ValueType& type =
+        registry.valueType(typeid(keyValue.value));
+    types.push_back(make_pair(&type, table.index(type)));
+  }
+
+  ar.beginSection(BINARY_VALUES);
+  table.write(ar);
+  ar.write<uint64_t>(values.size());
+  size_t i = 0;
+  for (const auto& keyValue : values) {
+    ar.write(keyValue.key);
+    ar.write(types[i].second);
+    types[i].first->write(ar, keyValue.value);
+    ++i;
+  }
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, Values& values) {
+  const BinaryRegistry& registry = BinaryRegistry::Instance();
+  ar.readSection(BINARY_VALUES);
+  const vector<const BinaryRegistry::ValueType*> types =
+      readTypeTable<BinaryRegistry::ValueType>(ar, [&](const string& name)
+          -> const BinaryRegistry::ValueType& { return registry.valueType(name); });
+  values.clear();
+  const uint64_t n = ar.read<uint64_t>();
+  for (uint64_t i = 0; i < n; ++i) {
+    const Key key = ar.read<Key>();
+    const uint32_t type = ar.read<uint32_t>();
+    if (type >= types.size())
+      throw runtime_error("readBinary: corrupt Values");
+    types[type]->read(ar, key, values);
+  }
+}
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const VectorValues& values) {
+  ar.beginSection(BINARY_VECTOR_VALUES);
+  ar.write<uint64_t>(values.size());
+  for (const auto& keyValue : values) {
+    ar.write(keyValue.first);
+    ar.writeVector(keyValue.second);
+  }
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, VectorValues& values) {
+  ar.readSection(BINARY_VECTOR_VALUES);
+  values = VectorValues();
+  const uint64_t n = ar.read<uint64_t>();
+  for (uint64_t i = 0; i < n; ++i) {
+    const Key key = ar.read<Key>();
+    values.insert(key, ar.readVector());
+  }
+}
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const NonlinearFactorGraph& graph) {
+  const BinaryRegistry& registry = BinaryRegistry::Instance();
+  TypeTable<BinaryRegistry::FactorType> table;
+  vector<pair<const BinaryRegistry::FactorType*, uint32_t> > types;
+  types.reserve(graph.size());
+  for (const NonlinearFactor::shared_ptr& factor : graph) {
+    if (!factor) {
+      types.push_back(make_pair(nullptr, kNullType));
+      continue;
+    }
+    const BinaryRegistry::FactorType& type = registry.factorType(typeid(*factor));
+    types.push_back(make_pair(&type, table.index(type)));
+  }
+
+  ar.beginSection(BINARY_NONLINEAR_FACTOR_GRAPH);
+  table.write(ar);
+  ar.write<uint64_t>(graph.size());
+  for (size_t i = 0; i < graph.size(); ++i) {
+    ar.write(types[i].second);
+    if (types[i].first) types[i].first->write(ar, *graph[i]);
+  }
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, NonlinearFactorGraph& graph) {
+  const BinaryRegistry& registry = BinaryRegistry::Instance();
+  ar.readSection(BINARY_NONLINEAR_FACTOR_GRAPH);
+  const vector<const BinaryRegistry::FactorType*> types =
+      readTypeTable<BinaryRegistry::FactorType>(ar, [&](const string& name)
+          -> const BinaryRegistry::FactorType& { return registry.factorType(name); });
+  const uint64_t n = ar.readCount<uint32_t>();  // each starts with its type
+  graph = NonlinearFactorGraph();
+  graph.reserve(n);
+  for (uint64_t i = 0; i < n; ++i) {
+    const uint32_t type = ar.read<uint32_t>();
+    if (type == kNullType) {
+      graph.push_back(NonlinearFactor::shared_ptr());
+    } else if (type < types.size()) {
+      graph.push_back(types[type]->read(ar));
+    } else {
+      throw runtime_error("readBinary: corrupt NonlinearFactorGraph");
+    }
+  }
+}
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const GaussianFactorGraph& graph) {
+  ar.beginSection(BINARY_GAUSSIAN_FACTOR_GRAPH);
+  ar.write<uint64_t>(graph.size());
+  for (const GaussianFactor::shared_ptr& factor : graph)
+    writeGaussianFactor(ar, factor);
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, GaussianFactorGraph& graph) {
+  ar.readSection(BINARY_GAUSSIAN_FACTOR_GRAPH);
+  const uint64_t n = ar.readCount<uint8_t>();  // each starts with its type
+  graph = GaussianFactorGraph();
+  graph.reserve(n);
+  for (uint64_t i = 0; i < n; ++i) graph.push_back(readGaussianFactor(ar));
+}
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const GaussianBayesTree& bayesTree) {
+  ar.beginSection(BINARY_GAUSSIAN_BAYES_TREE);
+  writeBayesTree<GaussianBayesTreeClique>(ar, bayesTree,
+      [](BinaryOutArchive& ar, const GaussianBayesTreeClique& clique) {
+        writeGaussianFactor(ar, clique.conditional());
+      });
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, GaussianBayesTree& bayesTree) {
+  ar.readSection(BINARY_GAUSSIAN_BAYES_TREE);
+  readBayesTree<GaussianBayesTreeClique>(ar, bayesTree,
+      [](BinaryInArchive& ar) {
+        const GaussianConditional::shared_ptr conditional =
+            boost::dynamic_pointer_cast<GaussianConditional>(
+                readGaussianFactor(ar));
+        if (!conditional)
+          throw runtime_error("readBinary: GaussianBayesTree without conditional");
+        return boost::make_shared<GaussianBayesTreeClique>(conditional);
+      });
+}
+
+/* ************************************************************************* */
+void writeBinary(BinaryOutArchive& ar, const VariableIndex& variableIndex) {
+  ar.beginSection(BINARY_VARIABLE_INDEX);
+  ar.write<uint64_t>(variableIndex.nFactors());
+  ar.write<uint64_t>(variableIndex.size());
+  for (const auto& keyFactors : variableIndex) {
+    ar.write(keyFactors.first);
+    ar.write<uint64_t>(keyFactors.second.size());
+    ar.writeBytes(keyFactors.second.data(),
+                  keyFactors.second.size() * sizeof(FactorIndex));
+  }
+  ar.endSection();
+}
+
+/* ************************************************************************* */
+void readBinary(BinaryInArchive& ar, VariableIndex& variableIndex) {
+  ar.readSection(BINARY_VARIABLE_INDEX);
+  variableIndex = VariableIndex();
+  variableIndex.nFactors_ = ar.read<uint64_t>();
+  const uint64_t n = ar.read<uint64_t>();
+  for (uint64_t i = 0; i < n; ++i) {
+    const Key key = ar.read<Key>();
+    FactorIndices& factors = variableIndex.index_[key];
+    factors.resize(ar.readCount<FactorIndex>());
+    for (FactorIndex& factor : factors) {
+      factor = ar.read<FactorIndex>();
+      if (factor >= variableIndex.nFactors_)
+        throw runtime_error("readBinary: corrupt VariableIndex");
+    }
+    variableIndex.nEntries_ += factors.size();
+  }
+}
+
+} // namespace gtsam
@@ -0,0 +1,377 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinarySerialization.h
+ * @date October 2026
+ * @brief Compact, versioned binary files for graphs, Values and Bayes trees
+ *
+ * Unlike the boost archives in serialization.h, the binary format stores
+ * doubles as raw, aligned arrays, and files are read through a memory map.
+ * Polymorphic Values and factors are identified by registered type names:
+ * every section starts with the table of the names it uses, so that a reader
+ * can report types it does not know.
+ *
+ * Example:
+ * \code
+ *   saveBinary(graph, "graph.bin");
+ *   NonlinearFactorGraph loaded;
+ *   loadBinary("graph.bin", loaded);
+ * \endcode
+ */
+
+#pragma once
+
+#include <gtsam/base/BinaryArchive.h>
+#include <gtsam/geometry/Cal3Bundler.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/BayesTree.h>
+#include <gtsam/inference/VariableIndex.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <fstream>
+#include <functional>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+
+namespace gtsam {
+
+/// Tags of the sections written by writeBinary
+enum BinarySectionTag {
+  BINARY_VALUES = 1,
+  BINARY_VECTOR_VALUES = 2,
+  BINARY_NONLINEAR_FACTOR_GRAPH = 3,
+  BINARY_GAUSSIAN_FACTOR_GRAPH = 4,
+  BINARY_GAUSSIAN_BAYES_TREE = 5,
+  BINARY_VARIABLE_INDEX = 6,
+  BINARY_ISAM2_CHECKPOINT = 7,
+  BINARY_SFM_DATA = 8
+};
+
+/**
+ * Encoding of a type in the binary format, with members
+ * \code
+ *   static void write(BinaryOutArchive& ar, const T& value);
+ *   static T read(BinaryInArchive& ar);  // or boost::shared_ptr<T> for factors
+ * \endcode
+ * Specialize it to register a value or factor type with BinaryRegistry.
+ */
+template<class T>
+struct BinaryCodec;
+
+/// Eigen matrices and vectors, fixed-size ones without their size
+template<int Rows, int Cols>
+struct BinaryCodec<Eigen::Matrix<double, Rows, Cols> > {
+  typedef Eigen::Matrix<double, Rows, Cols> T;
+  typedef std::integral_constant<bool,
+      Rows != Eigen::Dynamic && Cols != Eigen::Dynamic> Fixed;
+  static void write(BinaryOutArchive& ar, const T& A) { write(ar, A, Fixed()); }
+  static T read(BinaryInArchive& ar) { return read(ar, Fixed()); }
+private:
+  static void write(BinaryOutArchive& ar, const T& A, std::true_type) { ar.writeFixed(A); }
+  static void write(BinaryOutArchive& ar, const T& A, std::false_type) { ar.writeMatrix(A); }
+  static T read(BinaryInArchive& ar, std::true_type) { return ar.readFixed<T>(); }
+  static T read(BinaryInArchive& ar, std::false_type) { return ar.readMatrix(); }
+};
+
+template<>
+struct BinaryCodec<double> {
+  static void write(BinaryOutArchive& ar, double x) { ar.write(x); }
+  static double read(BinaryInArchive& ar) { return ar.read<double>(); }
+};
+
+#ifndef GTSAM_TYPEDEF_POINTS_TO_VECTORS
+template<>
+struct BinaryCodec<Point2> {
+  static void write(BinaryOutArchive& ar, const Point2& p) { ar.writeFixed(p); }
+  static Point2 read(BinaryInArchive& ar) { return Point2(ar.readFixed<Vector2>()); }
+};
+
+template<>
+struct BinaryCodec<Point3> {
+  static void write(BinaryOutArchive& ar, const Point3& p) { ar.writeFixed(p); }
+  static Point3 read(BinaryInArchive& ar) { return Point3(ar.readFixed<Vector3>()); }
+};
+#endif
+
+/// Rot2 as cos and sin, to be exact
+template<>
+struct BinaryCodec<Rot2> {
+  static void write(BinaryOutArchive& ar, const Rot2& R) {
+    ar.writeFixed(Vector2(R.c(), R.s()));
+  }
+  static Rot2 read(BinaryInArchive& ar) {
+    const Vector2 cs = ar.readFixed<Vector2>();
+    return Rot2::fromCosSin(cs(0), cs(1));
+  }
+};
+
+/// Rot3 as a rotation matrix
+template<>
+struct BinaryCodec<Rot3> {
+  static void write(BinaryOutArchive& ar, const Rot3& R) { ar.writeFixed(R.matrix()); }
+  static Rot3 read(BinaryInArchive& ar) { return Rot3(ar.readFixed<Matrix3>()); }
+};
+
+template<>
+struct BinaryCodec<Pose2> {
+  static void write(BinaryOutArchive& ar, const Pose2& pose) {
+    ar.writeFixed(Vector4(pose.x(), pose.y(), pose.rotation().c(),
+                          pose.rotation().s()));
+  }
+  static Pose2 read(BinaryInArchive& ar) {
+    const Vector4 v = ar.readFixed<Vector4>();
+    return Pose2(Rot2::fromCosSin(v(2), v(3)), Point2(v(0), v(1)));
+  }
+};
+
+/// Pose3 as the rotation matrix followed by the translation
+template<>
+struct BinaryCodec<Pose3> {
+  static void write(BinaryOutArchive& ar, const Pose3& pose) {
+    ar.writeFixed(pose.matrix().topRows<3>());
+  }
+  static Pose3 read(BinaryInArchive& ar) {
+    const Matrix34 T = ar.readFixed<Matrix34>();
+    return Pose3(Rot3(T.leftCols<3>().eval()), Point3(T.col(3)));
+  }
+};
+
+/// Cal3_S2 as fx, fy, s, u0, v0
+template<>
+struct BinaryCodec<Cal3_S2> {
+  static void write(BinaryOutArchive& ar, const Cal3_S2& K) { ar.writeFixed(K.vector()); }
+  static Cal3_S2 read(BinaryInArchive& ar) { return Cal3_S2(ar.readFixed<Vector5>()); }
+};
+
+/// Cal3Bundler as f, k1, k2, u0, v0
+template<>
+struct BinaryCodec<Cal3Bundler> {
+  static void write(BinaryOutArchive& ar, const Cal3Bundler& K) {
+    ar.writeFixed((Vector5() << K.fx(), K.k1(), K.k2(), K.u0(), K.v0()).finished());
+  }
+  static Cal3Bundler read(BinaryInArchive& ar) {
+    const Vector5 v = ar.readFixed<Vector5>();
+    return Cal3Bundler(v(0), v(1), v(2), v(3), v(4));
+  }
+};
+
+/**
+ * The value and factor types that can be written to the binary format, by
+ * their type name in the files. Geometry types and the common SLAM factors
+ * are registered on first use; other types can be added with registerValue
+ * and registerFactor, given a BinaryCodec. Registration is not thread-safe,
+ * and should be done before any reading or writing.
+ */
+class GTSAM_EXPORT BinaryRegistry {
+public:
+
+  /// Reads and writes the values of one type in Values
+  struct ValueType {
+    std::string name;
+    std::function<void(BinaryOutArchive&, const Value&)> write;
+    std::function<void(BinaryInArchive&, Key, Values&)> read;
+  };
+
+  /// Reads and writes one type of nonlinear factor
+  struct FactorType {
+    std::string name;
+    std::function<void(BinaryOutArchive&, const NonlinearFactor&)> write;
+    std::function<NonlinearFactor::shared_ptr(BinaryInArchive&)> read;
+  };
+
+private:
+
+  std::unordered_map<std::type_index, ValueType> valuesByType_;
+  std::unordered_map<std::string, const ValueType*> valuesByName_;
+  std::unordered_map<std::type_index, FactorType> factorsByType_;
+  std::unordered_map<std::string, const FactorType*> factorsByName_;
+
+  BinaryRegistry();
+
+  void add(const std::type_info& type, const ValueType& valueType);
+  void add(const std::type_info& type, const FactorType& factorType);
+
+public:
+
+  /// The registry used by the functions below
+  static BinaryRegistry& Instance();
+
+  /// Register the value type T, stored in Values as GenericValue<T>
+  template<class T>
+  void registerValue(const std::string& name) {
+    ValueType valueType;
+    valueType.name = name;
+    valueType.write = [](BinaryOutArchive& ar, const Value& value) {
+      BinaryCodec<T>::write(ar, static_cast<const GenericValue<T>&>(value).value());
+    };
+    valueType.read = [](BinaryInArchive& ar, Key key, Values& values) {
+      values.insert(key, BinaryCodec<T>::read(ar));
+    };
+    add(typeid(GenericValue<T>), valueType);
+  }
+
+  /// Register the factor type FACTOR
+  template<class FACTOR>
+  void registerFactor(const std::string& name) {
+    FactorType factorType;
+    factorType.name = name;
+    factorType.write = [](BinaryOutArchive& ar, const NonlinearFactor& factor) {
+      BinaryCodec<FACTOR>::write(ar, static_cast<const FACTOR&>(factor));
+    };
+    factorType.read = [](BinaryInArchive& ar) -> NonlinearFactor::shared_ptr {
+      return BinaryCodec<FACTOR>::read(ar);
+    };
+    add(typeid(FACTOR), factorType);
+  }
+
+  /// The registered value type stored as type, throws if unknown
+  const ValueType& valueType(const std::type_info& type) const;
+
+  /// The registered value type with the given name, throws if unknown
+  const ValueType& valueType(const std::string& name) const;
+
+  /// The registered factor type of type, throws if unknown
+  const FactorType& factorType(const std::type_info& type) const;
+
+  /// The registered factor type with the given name, throws if unknown
+  const FactorType& factorType(const std::string& name) const;
+};
+
+namespace internal {
+/// Register the factors of gtsam/slam, see slam/BinaryFactors.cpp
+void registerSlamFactors(BinaryRegistry& registry);
+}
+
+/// @name Building blocks, for classes that write their own sections
+/// @{
+
+/// Write a noise model, which may be null
+GTSAM_EXPORT void writeNoiseModel(BinaryOutArchive& ar, const SharedNoiseModel& model);
+
+/// Read a noise model written with writeNoiseModel
+GTSAM_EXPORT SharedNoiseModel readNoiseModel(BinaryInArchive& ar);
+
+/// Write a Jacobian, Hessian or conditional Gaussian factor, which may be null
+GTSAM_EXPORT void writeGaussianFactor(BinaryOutArchive& ar,
+                                      const GaussianFactor::shared_ptr& factor);
+
+/// Read a Gaussian factor written with writeGaussianFactor
+GTSAM_EXPORT GaussianFactor::shared_ptr readGaussianFactor(BinaryInArchive& ar);
+
+/// Write keys, with their number
+GTSAM_EXPORT void writeKeys(BinaryOutArchive& ar, const KeyVector& keys);
+
+/// Read keys written with writeKeys
+GTSAM_EXPORT KeyVector readKeys(BinaryInArchive& ar);
+
+/**
+ * Write the cliques of a Bayes tree in pre-order, each with the index of its
+ * parent, and with writeClique for the contents of the clique.
+ */
+template<class CLIQUE>
+void writeBayesTree(BinaryOutArchive& ar, const BayesTree<CLIQUE>& bayesTree,
+    const std::function<void(BinaryOutArchive&, const CLIQUE&)>& writeClique) {
+  typedef boost::shared_ptr<CLIQUE> sharedClique;
+  std::vector<std::pair<sharedClique, int64_t> > cliques;
+  std::vector<std::pair<sharedClique, int64_t> > stack;
+  for (auto it = bayesTree.roots().rbegin(); it != bayesTree.roots().rend(); ++it)
+    stack.push_back(std::make_pair(*it, int64_t(-1)));
+  while (!stack.empty()) {
+    const std::pair<sharedClique, int64_t> entry = stack.back();
+    stack.pop_back();
+    const int64_t index = cliques.size();
+    cliques.push_back(entry);
+    const auto& children = entry.first->children;
+    for (auto it = children.rbegin(); it != children.rend(); ++it)
+      stack.push_back(std::make_pair(*it, index));
+  }
+  ar.write<uint64_t>(cliques.size());
+  for (const auto& entry : cliques) {
+    ar.write(entry.second);
+    writeClique(ar, *entry.first);
+  }
+}
+
+/**
+ * Read the cliques of a Bayes tree written with writeBayesTree, where
+ * readClique creates a clique from its contents.
+ */
+template<class CLIQUE>
+void readBayesTree(BinaryInArchive& ar, BayesTree<CLIQUE>& bayesTree,
+    const std::function<boost::shared_ptr<CLIQUE>(BinaryInArchive&)>& readClique) {
+  typedef boost::shared_ptr<CLIQUE> sharedClique;
+  bayesTree.clear();
+  const uint64_t n = ar.readCount<int64_t>();  // each starts with its parent
+  std::vector<sharedClique> cliques;
+  cliques.reserve(n);
+  for (uint64_t i = 0; i < n; ++i) {
+    const int64_t parent = ar.read<int64_t>();
+    if (parent >= static_cast<int64_t>(i))
+      throw std::runtime_error("readBayesTree: corrupt clique order");
+    const sharedClique clique = readClique(ar);
+    bayesTree.addClique(clique, parent < 0 ? sharedClique() : cliques[parent]);
+    cliques.push_back(clique);
+  }
+}
+
+/// @}
+
+/// @name Sections
+/// @{
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const Values& values);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, Values& values);
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const VectorValues& values);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, VectorValues& values);
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const NonlinearFactorGraph& graph);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, NonlinearFactorGraph& graph);
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const GaussianFactorGraph& graph);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, GaussianFactorGraph& graph);
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const GaussianBayesTree& bayesTree);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, GaussianBayesTree& bayesTree);
+
+GTSAM_EXPORT void writeBinary(BinaryOutArchive& ar, const VariableIndex& variableIndex);
+GTSAM_EXPORT void readBinary(BinaryInArchive& ar, VariableIndex& variableIndex);
+
+/// @}
+
+/// Write obj to a binary file, returns false if the file cannot be opened
+template<class T>
+bool saveBinary(const T& obj, const std::string& filename) {
+  std::ofstream os(filename.c_str(), std::ios::binary);
+  if (!os.is_open()) return false;
+  BinaryOutArchive ar(os);
+  writeBinary(ar, obj);
+  return true;
+}
+
+/// Read obj from a binary file, returns false if the file cannot be opened
+template<class T>
+bool loadBinary(const std::string& filename, T& obj) {
+  if (!std::ifstream(filename.c_str()).good()) return false;
+  BinaryInArchive ar(filename);
+  readBinary(ar, obj);
+  return true;
+}
+
+} // namespace gtsam
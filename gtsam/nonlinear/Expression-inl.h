@@ -190,28 +190,31 @@ template<typename T>
 T Expression<T>::valueAndJacobianMap(const Values& values,
     internal::JacobianMap& jacobians) const {
   // The following piece of code is absolutely crucial for performance.
-  // We allocate a block of memory on the stack, which can be done at runtime
-  // with modern C++ compilers. The traceExecution then fills this memory
-  // with an execution trace, made up entirely of "Record" structs, see
-  // the FunctionalNode class in expression-inl.h
-  size_t size = traceSize();
-
-  // Windows does not support variable length arrays, so memory must be dynamically
-  // allocated on Visual Studio. For more information see the issue below
-  // https://bitbucket.org/gtborg/gtsam/issue/178/vlas-unsupported-in-visual-studio
-#ifdef _MSC_VER
-  auto traceStorage = static_cast<internal::ExecutionTraceStorage*>(_aligned_malloc(size, internal::TraceAlignment));
-#else
-  internal::ExecutionTraceStorage traceStorage[size];
-#endif
+  // The traceExecution fills a block of memory with an execution trace, made
+  // up entirely of "Record" structs, see the FunctionalNode class in
+  // expression-inl.h. The memory comes from a thread-local arena that is
+  // reused by all evaluations, so there is no allocation per call, and deep
+  // expressions do not overflow small (e.g., worker thread) stacks.
+  internal::TraceArena::Allocation traceStorage(traceSize());
 
   internal::ExecutionTrace<T> trace;
-  T value(this->traceExecution(values, trace, traceStorage));
+  T value(this->traceExecution(values, trace, traceStorage.data()));
   trace.startReverseAD1(jacobians);
 
-#ifdef _MSC_VER
-  _aligned_free(traceStorage);
-#endif
+  return value;
+}
+
+template<typename T>
+template<int N>
+T Expression<T>::valueAndJacobianForward(const Values& values,
+    Eigen::Matrix<double, traits<T>::dimension, N>& H) const {
+  // Same trace as in valueAndJacobianMap, but the Jacobians are propagated
+  // from the leaf up, and have N columns rather than traits<T>::dimension rows
+  internal::TraceArena::Allocation traceStorage(traceSize());
+
+  internal::ExecutionTrace<T> trace;
+  T value(this->traceExecution(values, trace, traceStorage.data()));
+  trace.forwardAD1(H);
 
   return value;
 }
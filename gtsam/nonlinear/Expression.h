@@ -36,6 +36,7 @@ namespace gtsam {
 // Forward declares
 class Values;
 template<typename T> class ExpressionFactor;
+template<typename T> class ExpressionFactorGroup;
 
 namespace internal {
 template<typename T> class ExecutionTrace;
@@ -198,8 +199,17 @@ protected:
   T valueAndJacobianMap(const Values& values,
       internal::JacobianMap& jacobians) const;
 
+  /**
+   * Return value and the Jacobian with respect to the single key of the
+   * expression, forward AD version. H has to be sized, N is the key dimension.
+   */
+  template<int N>
+  T valueAndJacobianForward(const Values& values,
+      Eigen::Matrix<double, traits<T>::dimension, N>& H) const;
+
   // be very selective on who can access these private methods:
   friend class ExpressionFactor<T> ;
+  friend class ExpressionFactorGroup<T>;
   friend class internal::ExpressionNode<T>;
 
   // and add tests
@@ -21,17 +21,30 @@
 
 #include <gtsam/nonlinear/Expression.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/linear/FixedWhitener.h>
 #include <gtsam/base/Testable.h>
 #include <numeric>
 
 namespace gtsam {
 
+namespace internal {
+/// Type-independent interface of ExpressionFactor, to analyze expression graphs
+class ExpressionFactorBase {
+public:
+  virtual ~ExpressionFactorBase() {}
+
+  /// Register the nodes of the expression in a SubexpressionCache
+  virtual void registerSubexpressions(SubexpressionCache& cache) const = 0;
+};
+} // namespace internal
+
 /**
 
  * Factor that supports arbitrary expressions via AD
  */
 template<typename T>
-class ExpressionFactor: public NoiseModelFactor {
+class ExpressionFactor: public NoiseModelFactor,
+                        public internal::ExpressionFactorBase {
   BOOST_CONCEPT_ASSERT((IsTestable<T>));
 
 protected:
@@ -42,6 +55,8 @@ protected:
   T measured_;  ///< the measurement to be compared with the expression
   Expression<T> expression_;  ///< the expression that is AD enabled
   FastVector<int> dims_;      ///< dimensions of the Jacobian matrices
+  bool forwardAD_;  ///< use forward rather than reverse AD in linearize
+  noiseModel::FixedWhitener<Dim> whitener_;  ///< noiseModel_, resolved once
 
 
  public:
@@ -56,7 +71,7 @@ protected:
    */
   ExpressionFactor(const SharedNoiseModel& noiseModel,  //
                    const T& measurement, const Expression<T>& expression)
-      : NoiseModelFactor(noiseModel), measured_(measurement) {
+      : NoiseModelFactor(noiseModel), measured_(measurement), forwardAD_(false) {
     initialize(expression);
   }
 
@@ -99,6 +114,11 @@ protected:
     }
   }
 
+  /// Register the nodes of the expression in a SubexpressionCache
+  virtual void registerSubexpressions(internal::SubexpressionCache& cache) const {
+    if (expression_.root()) expression_.root()->registerSubexpressions(cache);
+  }
+
   virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
     // Only linearize if the factor is active
     if (!active(x))
@@ -123,16 +143,14 @@ protected:
     Ab.matrix().setZero();
 
     // Get value and Jacobians, writing directly into JacobianFactor
-    T value = expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
+    T value = forwardAD_ ? valueAndJacobianForward(x, Ab)
+                         : expression_.valueAndJacobianMap(x, jacobianMap); // <<< Reverse AD happens here !
 
     // Evaluate error and set RHS vector b
     Ab(size()).col(0) = traits<T>::Local(value, measured_);
 
     // Whiten the corresponding system, Ab already contains RHS
-    if (noiseModel_) {
-      Vector b = Ab(size()).col(0);  // need b to be valid for Robust noise models
-      noiseModel_->WhitenSystem(Ab.matrix(), b);
-    }
+    whitener_.whitenSystem(Ab.matrix());
 
     return factor;
   }
@@ -144,12 +162,12 @@ protected:
   }
 
 protected:
- ExpressionFactor() {}
+ ExpressionFactor() : forwardAD_(false) {}
  /// Default constructor, for serialization
 
  /// Constructor for serializable derived classes
  ExpressionFactor(const SharedNoiseModel& noiseModel, const T& measurement)
-     : NoiseModelFactor(noiseModel), measured_(measurement) {
+     : NoiseModelFactor(noiseModel), measured_(measurement), forwardAD_(false) {
    // Not properly initialized yet, need to call initialize
  }
 
@@ -176,6 +194,36 @@ protected:
      expression_.dims(keyedDims);
      for (Key key : keys_) dims_.push_back(keyedDims[key]);
    }
+
+   // Resolve the type of the noise model once, to whiten without virtual calls
+   whitener_ = noiseModel::FixedWhitener<Dim>(noiseModel_);
+
+   // Reverse AD multiplies Jacobians with Dim rows through the trace, forward
+   // AD Jacobians with as many columns as the input dimension. For a single
+   // key of lower dimension than the measurement, forward AD does less work.
+   forwardAD_ = Dim != Eigen::Dynamic && expression_.traceSize() > 0 &&
+                keys_.size() == 1 && dims_[0] < Dim &&
+                dims_[0] <= internal::CallRecordMaxVirtualStaticCols;
+ }
+
+ /// Forward AD with a fixed-size Jacobian, for keys up to dimension 6
+ T valueAndJacobianForward(const Values& x, VerticalBlockMatrix& Ab) const {
+   switch (dims_[0]) {
+     case 1: return valueAndJacobianForward<1>(x, Ab);
+     case 2: return valueAndJacobianForward<2>(x, Ab);
+     case 3: return valueAndJacobianForward<3>(x, Ab);
+     case 4: return valueAndJacobianForward<4>(x, Ab);
+     case 5: return valueAndJacobianForward<5>(x, Ab);
+     default: return valueAndJacobianForward<6>(x, Ab);
+   }
+ }
+
+ template <int N>
+ T valueAndJacobianForward(const Values& x, VerticalBlockMatrix& Ab) const {
+   Eigen::Matrix<double, Dim, N> H;
+   const T value = expression_.valueAndJacobianForward(x, H);
+   Ab(0) = H;
+   return value;
  }
 
  /// Recreate expression from keys_ and measured_, used in load below.
@@ -0,0 +1,69 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ *  @file  ExpressionFactorGraph.cpp
+ *  @brief Linearization of expression graphs with shared sub-expressions
+ *  @date October 2026
+ */
+
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
+#include <gtsam/base/timing.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+namespace gtsam {
+
+/* ************************************************************************* */
+GaussianFactorGraph::shared_ptr ExpressionFactorGraph::linearizeShared(
+    const Values& values, SharingStatistics* statistics) const {
+  gttic(ExpressionFactorGraph_linearizeShared);
+
+  // Find the expression nodes that are reached more than once
+  internal::SubexpressionCache cache;
+  for (const sharedFactor& factor : factors_) {
+    const internal::ExpressionFactorBase* expressionFactor =
+        dynamic_cast<const internal::ExpressionFactorBase*>(factor.get());
+    if (expressionFactor) expressionFactor->registerSubexpressions(cache);
+  }
+  cache.removeUnshared();
+
+  GaussianFactorGraph::shared_ptr linearFG =
+      boost::make_shared<GaussianFactorGraph>();
+  linearFG->resize(size());
+
+  // The cache has to be current on every thread that evaluates expressions
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+      [&](const tbb::blocked_range<size_t>& range) {
+        internal::SubexpressionCache::Scope scope(&cache);
+        for (size_t i = range.begin(); i != range.end(); ++i)
+          if (factors_[i]) (*linearFG)[i] = factors_[i]->linearize(values);
+      });
+#else
+  internal::SubexpressionCache::Scope scope(&cache);
+  for (size_t i = 0; i < size(); ++i)
+    if (factors_[i]) (*linearFG)[i] = factors_[i]->linearize(values);
+#endif
+
+  if (statistics) {
+    statistics->sharedSubexpressions = cache.size();
+    statistics->evaluations = cache.evaluations();
+    statistics->uses = cache.uses();
+  }
+  return linearFG;
+}
+
+} // namespace gtsam
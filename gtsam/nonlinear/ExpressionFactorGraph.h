@@ -20,6 +20,7 @@
 
 #include <gtsam/nonlinear/ExpressionFactor.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
 
 namespace gtsam {
 
@@ -46,6 +47,37 @@ public:
     push_back(boost::allocate_shared<F>(Eigen::aligned_allocator<F>(), R, z, h));
   }
 
+  /// @}
+  /// @name Linearization with shared sub-expressions
+  /// @{
+
+  /// Statistics of linearizeShared
+  struct SharingStatistics {
+    size_t sharedSubexpressions;  ///< sub-expressions used more than once
+    size_t evaluations;           ///< evaluations of shared sub-expressions
+    size_t uses;                  ///< uses of shared sub-expressions
+
+    SharingStatistics() : sharedSubexpressions(0), evaluations(0), uses(0) {}
+
+    /// Fraction of the uses of shared sub-expressions served from the cache
+    double reuseRatio() const {
+      return uses > 0 ? 1.0 - double(evaluations) / double(uses) : 0.0;
+    }
+  };
+
+  /**
+   * Linearize, evaluating every sub-expression that is shared by several
+   * ExpressionFactors (or several times within one) only once. Shared
+   * sub-expressions are the expression nodes with more than one parent, e.g.,
+   * a transformFrom(x, ...) Expression that is used in several factors.
+   * Other factors are linearized as usual. The result is the same as that of
+   * linearize, up to round-off.
+   * @param values the linearization point
+   * @param statistics optional, returns how much work was shared
+   */
+  GTSAM_EXPORT GaussianFactorGraph::shared_ptr linearizeShared(
+      const Values& values, SharingStatistics* statistics = nullptr) const;
+
   /// @}
 };
 
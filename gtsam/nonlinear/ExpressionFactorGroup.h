@@ -0,0 +1,257 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ExpressionFactorGroup.h
+ * @date October 2026
+ * @brief Many expression factors that share one expression
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/linear/FixedWhitener.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace gtsam {
+
+/**
+ * A group of factors that all predict their measurement with the same
+ * expression, and only differ in their keys and measurement. For example,
+ * all the projection factors of a bundle adjustment problem:
+ * \code
+ *   Expression<Point2> prediction =
+ *       uncalibrate(K, project(transformTo(Pose3_('x', 0), Point3_('l', 0))));
+ *   ExpressionFactorGroup<Point2> group(model, prediction);
+ *   group.add(list_of(X(i))(L(j)), measured_ij);
+ * \endcode
+ * The keys of the expression are placeholders: member factors substitute
+ * their own keys for them, in the sorted order of the placeholder keys.
+ *
+ * The expression is stored once, and the keys and measurements of all members
+ * are stored in flat arrays. linearize() evaluates all members in a single,
+ * parallel loop, with the Jacobian layout resolved once for the whole group.
+ * With a Robust noise model (Block reweighting), the M-estimator weights of
+ * all members are computed in one batched call.
+ */
+template<typename T>
+class ExpressionFactorGroup {
+  BOOST_CONCEPT_ASSERT((IsTestable<T>));
+
+protected:
+
+  static const int Dim = traits<T>::dimension;
+
+  SharedNoiseModel noiseModel_;       ///< noise model shared by all members
+  Expression<T> expression_;          ///< expression on the placeholder keys
+  KeyVector slots_;                   ///< placeholder keys, sorted
+  FastVector<int> dims_;              ///< dimensions of the Jacobian matrices
+  boost::shared_ptr<noiseModel::Robust> robust_;  ///< if batched reweighting
+  noiseModel::FixedWhitener<Dim> whitener_;  ///< Gaussian part of the model
+
+  KeyVector keys_;  ///< keys of all members, slots_.size() per member
+  std::vector<T, Eigen::aligned_allocator<T> > measured_;  ///< measurements
+
+public:
+
+  typedef boost::shared_ptr<ExpressionFactorGroup<T> > shared_ptr;
+
+  /**
+   * Constructor
+   *   @param noiseModel the noise model shared by all members
+   *   @param expression predicts the measurement, on placeholder keys
+   */
+  ExpressionFactorGroup(const SharedNoiseModel& noiseModel,
+      const Expression<T>& expression) :
+      noiseModel_(noiseModel), expression_(expression) {
+    if (!noiseModel_)
+      throw std::invalid_argument("ExpressionFactorGroup: no NoiseModel.");
+    if (noiseModel_->dim() != Dim)
+      throw std::invalid_argument(
+          "ExpressionFactorGroup was created with a NoiseModel of incorrect dimension.");
+    boost::tie(slots_, dims_) = expression_.keysAndDims();
+
+    // A robust model reweights each member by the norm of its whitened error:
+    // whiten all members first, then compute their weights in one batched call
+    robust_ = boost::dynamic_pointer_cast<noiseModel::Robust>(noiseModel_);
+    if (robust_ &&
+        robust_->robust()->reweightScheme() != noiseModel::mEstimator::Base::Block)
+      robust_.reset();
+    whitener_ = noiseModel::FixedWhitener<Dim>(
+        robust_ ? robust_->noise() : noiseModel_);
+  }
+
+  /**
+   * Add a member factor
+   *   @param keys the keys substituted for the placeholder keys, in the
+   *   order of placeholderKeys()
+   *   @param measured the measurement of this member
+   */
+  void add(const KeyVector& keys, const T& measured) {
+    if (keys.size() != slots_.size())
+      throw std::invalid_argument(
+          "ExpressionFactorGroup::add: wrong number of keys.");
+    KeyVector sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+      throw std::invalid_argument(
+          "ExpressionFactorGroup::add: keys must be distinct.");
+    keys_.insert(keys_.end(), keys.begin(), keys.end());
+    measured_.push_back(measured);
+  }
+
+  /// Reserve storage for n members
+  void reserve(size_t n) {
+    keys_.reserve(n * slots_.size());
+    measured_.reserve(n);
+  }
+
+  /// Number of member factors
+  size_t size() const { return measured_.size(); }
+
+  /// Whether the group has no members
+  bool empty() const { return measured_.empty(); }
+
+  /// The placeholder keys of the expression, in sorted order
+  const KeyVector& placeholderKeys() const { return slots_; }
+
+  /// The keys of member i
+  KeyVector keys(size_t i) const {
+    return KeyVector(keys_.begin() + i * slots_.size(),
+                     keys_.begin() + (i + 1) * slots_.size());
+  }
+
+  /// The measurement of member i
+  const T& measured(size_t i) const { return measured_.at(i); }
+
+  /// The shared noise model
+  const SharedNoiseModel& noiseModel() const { return noiseModel_; }
+
+  /// The total error of all members, 0.5 * sum of squared whitened errors
+  double error(const Values& x) const {
+    Values local = placeholderValues(x);
+    std::vector<Value*> slotValues = slotPointers(&local);
+    double total = 0.0;
+    for (size_t i = 0; i < size(); ++i) {
+      substitute(x, i, slotValues);
+      const T value = expression_.value(local);
+      total += 0.5 * noiseModel_->distance(
+          -traits<T>::Local(value, measured_[i]));
+    }
+    return total;
+  }
+
+  /**
+   * Linearize all members into a GaussianFactorGraph with one JacobianFactor
+   * per member, in the order the members were added.
+   */
+  GaussianFactorGraph::shared_ptr linearize(const Values& x) const {
+    gttic(ExpressionFactorGroup_linearize);
+    GaussianFactorGraph::shared_ptr linearFG =
+        boost::make_shared<GaussianFactorGraph>();
+    linearFG->resize(size());
+    if (empty()) return linearFG;
+
+#ifdef GTSAM_USE_TBB
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, size()),
+        [&](const tbb::blocked_range<size_t>& range) {
+          linearizeRange(x, range.begin(), range.end(), *linearFG);
+        });
+#else
+    linearizeRange(x, 0, size(), *linearFG);
+#endif
+    return linearFG;
+  }
+
+protected:
+
+  /// Values on the placeholder keys, initialized from the first member
+  Values placeholderValues(const Values& x) const {
+    Values local;
+    if (!empty())
+      for (size_t s = 0; s < slots_.size(); ++s)
+        local.insert(slots_[s], x.at(keys_[s]));
+    return local;
+  }
+
+  /// Pointers to the placeholder values in local, in the order of slots_
+  std::vector<Value*> slotPointers(Values* local) const {
+    std::vector<Value*> slotValues;
+    slotValues.reserve(slots_.size());
+    for (Key slot : slots_)
+      slotValues.push_back(&local->find(slot)->value);
+    return slotValues;
+  }
+
+  /// Copy the values of member i into the placeholder values, in place
+  void substitute(const Values& x, size_t i,
+      const std::vector<Value*>& slotValues) const {
+    const Key* keys = &keys_[i * slots_.size()];
+    for (size_t s = 0; s < slots_.size(); ++s) {
+      const Value& value = x.at(keys[s]);
+      if (typeid(value) != typeid(*slotValues[s]))
+        throw ValuesIncorrectType(keys[s], typeid(value), typeid(*slotValues[s]));
+      *slotValues[s] = value;
+    }
+  }
+
+  /// Linearize members [begin, end) into the corresponding slots of linearFG
+  void linearizeRange(const Values& x, size_t begin, size_t end,
+      GaussianFactorGraph& linearFG) const {
+    // In case noise model is constrained, we need to provide a noise model
+    SharedDiagonal unitModel;
+    if (noiseModel_->isConstrained())
+      unitModel = boost::static_pointer_cast<noiseModel::Constrained>(
+          noiseModel_)->unit();
+
+    Vector norms(robust_ ? end - begin : 0);
+
+    Values local = placeholderValues(x);
+    std::vector<Value*> slotValues = slotPointers(&local);
+    for (size_t i = begin; i < end; ++i) {
+      substitute(x, i, slotValues);
+
+      // Member keys are in slot order, so blocks line up with the slots
+      boost::shared_ptr<JacobianFactor> factor(
+          new JacobianFactor(keys(i), dims_, Dim, unitModel));
+      VerticalBlockMatrix& Ab = factor->matrixObject();
+      internal::JacobianMap jacobianMap(slots_, Ab);
+      Ab.matrix().setZero();
+      const T value = expression_.valueAndJacobianMap(local, jacobianMap);
+
+      Ab(slots_.size()).col(0) = traits<T>::Local(value, measured_[i]);
+      const double norm = whitener_.whitenSystem(Ab.matrix(), robust_ != nullptr);
+      if (robust_) norms(i - begin) = norm;
+      linearFG[i] = factor;
+    }
+
+    if (robust_) {
+      Vector sqrtWeights(end - begin);
+      robust_->robust()->sqrtWeights(norms.data(), sqrtWeights.data(), end - begin);
+      for (size_t i = begin; i < end; ++i)
+        boost::static_pointer_cast<JacobianFactor>(linearFG[i])
+            ->matrixObject().matrix() *= sqrtWeights(i - begin);
+    }
+  }
+};
+
+} // namespace gtsam
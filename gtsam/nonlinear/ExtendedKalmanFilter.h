@@ -38,6 +38,9 @@ namespace gtsam {
  *
  * The class provides a "predict" and "update" function to perform these steps independently.
  * TODO: a "predictAndUpdate" that combines both steps for some computational savings.
+ *
+ * For fixed-size VALUEs, FixedExtendedKalmanFilter takes the same factors and
+ * works on their Jacobians directly, without a factor graph per step.
  * \nosubgrouping
  */
 
@@ -0,0 +1,205 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    FixedExtendedKalmanFilter.h
+ * @brief   Extended Kalman filter on fixed-size Jacobians of nonlinear factors
+ * @date    October 2026
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/NonlinearFactor.h>
+
+#include <stdexcept>
+
+namespace gtsam {
+
+/**
+ * Extended Kalman filter that uses the same motion and measurement factors as
+ * ExtendedKalmanFilter, but calls their evaluateError directly instead of
+ * linearizing them into a GaussianFactorGraph and eliminating it.
+ *
+ * The state is a VALUE of fixed dimension N with an NxN covariance in its
+ * tangent space, and the Kalman equations are done on fixed-size matrices.
+ * Workspaces for measurements, whose dimension is only known at run time, are
+ * kept between steps, so a step allocates nothing once they are large enough,
+ * except in the factor itself (the error vector and Jacobians it returns).
+ *
+ * The linearization is that of ExtendedKalmanFilter: the motion factor is
+ * linearized with both of its states at the current estimate, and the
+ * covariance is not transported when the estimate is retracted. Only Gaussian
+ * noise models are supported. The square-root information matrices of the last
+ * motion and the last measurement noise model are cached separately, so a
+ * filter that alternates predict and update with the same two models does not
+ * recompute them.
+ */
+template <class VALUE>
+class FixedExtendedKalmanFilter {
+  BOOST_CONCEPT_ASSERT((IsManifold<VALUE>));
+
+ public:
+  enum { N = traits<VALUE>::dimension };
+  BOOST_STATIC_ASSERT_MSG(N != Eigen::Dynamic,
+                          "FixedExtendedKalmanFilter needs a fixed-size VALUE");
+
+  typedef VALUE T;
+  typedef Eigen::Matrix<double, N, 1> VectorN;
+  typedef Eigen::Matrix<double, N, N> MatrixN;
+
+  typedef NoiseModelFactor2<VALUE, VALUE> MotionFactor;
+  typedef NoiseModelFactor1<VALUE> MeasurementFactor;
+
+ private:
+  typedef Eigen::Matrix<double, Eigen::Dynamic, N> MatrixXN;
+
+  T x_;        ///< current estimate
+  MatrixN P_;  ///< covariance in the tangent space at x_
+
+  // Workspaces, reused by all steps
+  Matrix H1_, H2_;           ///< Jacobians returned by evaluateError
+  /// A noise model and its square-root information matrix
+  struct SqrtInformation {
+    SharedNoiseModel model;
+    Matrix R;
+  };
+  SqrtInformation motionR_;       ///< for the last motion noise model
+  SqrtInformation measurementR_;  ///< for the last measurement noise model
+  MatrixXN A_, Kt_;          ///< whitened Jacobian and transposed gain
+  Vector b_;                 ///< whitened error
+  Matrix S_;                 ///< innovation covariance
+
+  /// Square-root information matrix of model, cached in the given slot
+  static const Matrix& sqrtInformation(const SharedNoiseModel& model,
+                                       SqrtInformation& cache) {
+    if (model != cache.model) {
+      const noiseModel::Gaussian::shared_ptr gaussian =
+          boost::dynamic_pointer_cast<noiseModel::Gaussian>(model);
+      if (!gaussian || gaussian->isConstrained())
+        throw std::invalid_argument(
+            "FixedExtendedKalmanFilter: noise models must be Gaussian");
+      cache.R = gaussian->R();
+      cache.model = model;
+    }
+    return cache.R;
+  }
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// @name Standard Constructors
+  /// @{
+
+  /// Construct from an initial estimate and its covariance
+  FixedExtendedKalmanFilter(const T& x_initial, const MatrixN& P_initial)
+      : x_(x_initial), P_(P_initial) {
+    reserve(N);
+  }
+
+  /// Construct from an initial estimate and its covariance, as noise model
+  FixedExtendedKalmanFilter(const T& x_initial,
+                            const noiseModel::Gaussian::shared_ptr& P_initial)
+      : x_(x_initial), P_(P_initial->covariance()) {
+    reserve(N);
+  }
+
+  /// @}
+  /// @name Testable
+  /// @{
+
+  /// print
+  void print(const std::string& s = "") const {
+    std::cout << s << "\n";
+    traits<T>::Print(x_, s + "x");
+    std::cout << s << "P:\n" << P_ << std::endl;
+  }
+
+  /// @}
+  /// @name Interface
+  /// @{
+
+  /// Make the workspaces large enough for measurements of dimension dim
+  void reserve(size_t dim) {
+    const Eigen::Index m = static_cast<Eigen::Index>(dim);
+    if (A_.rows() >= m) return;
+    A_.resize(m, N);
+    Kt_.resize(m, N);
+    b_.resize(m);
+    S_.resize(m, m);
+  }
+
+  /**
+   * Predict x_ through a motion factor with key1 for the previous state and
+   * key2 for the next, whose error dimension must be N
+   */
+  T predict(const MotionFactor& motionFactor) {
+    if (motionFactor.dim() != N)
+      throw std::invalid_argument(
+          "FixedExtendedKalmanFilter::predict: motion factor dimension must "
+          "be the state dimension");
+    const Matrix& W = sqrtInformation(motionFactor.noiseModel(), motionR_);
+    const Vector error = motionFactor.evaluateError(x_, x_, H1_, H2_);
+
+    // Whitened linear model A1 dx1 + A2 dx2 + b = noise, solved for dx2
+    MatrixN A1, A2;
+    VectorN b;
+    A1.noalias() = W * H1_;
+    A2.noalias() = W * H2_;
+    b.noalias() = W * error;
+    const Eigen::PartialPivLU<MatrixN> lu(A2);
+    const MatrixN M = lu.solve(A1), A2inv = lu.inverse();
+    const MatrixN P = M * P_ * M.transpose() + A2inv * A2inv.transpose();
+    P_ = 0.5 * (P + P.transpose());
+    const VectorN delta = -lu.solve(b);
+    x_ = traits<T>::Retract(x_, delta);
+    return x_;
+  }
+
+  /// Update x_ with a unary measurement factor
+  T update(const MeasurementFactor& measurementFactor) {
+    const Matrix& W = sqrtInformation(measurementFactor.noiseModel(),
+                                      measurementR_);
+    const Vector error = measurementFactor.evaluateError(x_, H1_);
+    const Eigen::Index m = error.size();
+    reserve(m);
+    Eigen::Block<MatrixXN, Eigen::Dynamic, N> A = A_.topRows(m),
+                                              Kt = Kt_.topRows(m);
+    Eigen::Ref<Vector> b = b_.head(m);
+    Eigen::Ref<Matrix> S = S_.topLeftCorner(m, m);
+
+    // Whitened linear model A dx + b = noise, and gain K = P A' (A P A' + I)^-1
+    A.noalias() = W * H1_;
+    b.noalias() = W * error;
+    Kt.noalias() = A * P_;
+    S.noalias() = Kt * A.transpose();
+    S.diagonal().array() += 1.0;
+    const Eigen::LLT<Eigen::Ref<Matrix> > llt(S);
+    llt.solveInPlace(Kt);
+
+    // Joseph form, which keeps P_ symmetric positive definite
+    const MatrixN I_KA = MatrixN::Identity() - Kt.transpose() * A;
+    const MatrixN P = I_KA * P_ * I_KA.transpose() + Kt.transpose() * Kt;
+    P_ = 0.5 * (P + P.transpose());
+    const VectorN delta = -Kt.transpose() * b;
+    x_ = traits<T>::Retract(x_, delta);
+    return x_;
+  }
+
+  /// Current estimate, predicted (after predict) or posterior (after update)
+  const T& x() const { return x_; }
+
+  /// Covariance of the current estimate, in its tangent space
+  const MatrixN& P() const { return P_; }
+
+  /// @}
+};
+
+}  // namespace gtsam
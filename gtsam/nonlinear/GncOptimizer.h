@@ -0,0 +1,211 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file GncOptimizer.h
+ * @date October 2026
+ * @brief Graduated non-convexity for graphs with robust noise models
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/linear/NoiseModel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <type_traits>
+#include <utility>
+
+namespace gtsam {
+
+/**
+ * Parameters of a GncOptimizer, with the parameters of the inner optimizer
+ * that is run at every stage.
+ */
+template <class INNER_PARAMS>
+struct GncParams {
+  typedef INNER_PARAMS InnerParams;
+
+  InnerParams inner;  ///< parameters of the inner optimizer
+  double muInit;      ///< initial control parameter, or 0 to derive it from the initial residuals (default: 0)
+  double muStep;      ///< factor by which mu decreases at every stage (default: 1.4)
+  size_t maxStages;   ///< maximum number of stages, the last one is always at mu = 1 (default: 100)
+
+  GncParams(const InnerParams& innerParams = InnerParams())
+      : inner(innerParams), muInit(0.0), muStep(1.4), maxStages(100) {}
+};
+
+/**
+ * Graduated non-convexity (Yang et al., RA-L 2020) for factor graphs whose
+ * NoiseModelFactors use Robust noise models with GemanMcClure or Tukey
+ * estimators. The estimators are first made (almost) convex by scaling their
+ * parameter c with sqrt(mu), for a large control parameter mu, and mu is then
+ * decreased to 1, at which point the original problem is solved. Every stage
+ * runs the inner optimizer, warm-started from the result of the previous one.
+ *
+ * The estimators are changed in place rather than cloning the graph, and are
+ * restored when optimize() returns. The elimination ordering is computed once
+ * and shared by all stages, as the structure of the graph does not change.
+ * Other factors, including robust factors with other estimators, are
+ * optimized as they are.
+ */
+template <class INNER_OPTIMIZER = LevenbergMarquardtOptimizer>
+class GncOptimizer {
+public:
+
+  typedef INNER_OPTIMIZER InnerOptimizer;
+  typedef typename std::decay<decltype(
+      std::declval<InnerOptimizer>().params())>::type InnerParams;
+  typedef GncParams<InnerParams> Params;
+
+protected:
+
+  /// An estimator of the graph, with its original parameter
+  struct Kernel {
+    noiseModel::mEstimator::GemanMcClure::shared_ptr gemanMcClure;
+    noiseModel::mEstimator::Tukey::shared_ptr tukey;
+    double c;
+
+    void scale(double s) const {
+      if (gemanMcClure) gemanMcClure->setModelParameter(c * s);
+      else tukey->setModelParameter(c * s);
+    }
+  };
+
+  /// A robust factor of the graph, used to find the initial mu
+  struct Threshold {
+    size_t factor;
+    double c;
+    double convexity;  ///< the estimator is convex for |r| < c / sqrt(convexity)
+  };
+
+  /// Restores the original estimators, also when an exception is thrown
+  struct Restore {
+    const std::vector<Kernel>& kernels;
+    ~Restore() {
+      for (const Kernel& kernel : kernels) kernel.scale(1.0);
+    }
+  };
+
+  const NonlinearFactorGraph graph_;
+  Values values_;
+  Params params_;
+  std::vector<Kernel> kernels_;
+  std::vector<Threshold> thresholds_;
+  size_t stages_, iterations_;
+
+public:
+
+  /**
+   * Constructor
+   * @param graph The nonlinear factor graph, whose estimators are changed
+   * during optimize()
+   * @param initialValues The initial variable assignments
+   * @param params The parameters
+   */
+  GncOptimizer(const NonlinearFactorGraph& graph, const Values& initialValues,
+               const Params& params = Params())
+      : graph_(graph), values_(initialValues), params_(params), stages_(0),
+        iterations_(0) {
+    std::set<const void*> visited;
+    for (size_t i = 0; i < graph_.size(); ++i) {
+      const NoiseModelFactor::shared_ptr factor =
+          boost::dynamic_pointer_cast<NoiseModelFactor>(graph_[i]);
+      if (!factor) continue;
+      const noiseModel::Robust::shared_ptr robust =
+          boost::dynamic_pointer_cast<noiseModel::Robust>(factor->noiseModel());
+      if (!robust) continue;
+
+      Kernel kernel;
+      kernel.gemanMcClure = boost::dynamic_pointer_cast<
+          noiseModel::mEstimator::GemanMcClure>(robust->robust());
+      kernel.tukey = boost::dynamic_pointer_cast<
+          noiseModel::mEstimator::Tukey>(robust->robust());
+      if (kernel.gemanMcClure)
+        kernel.c = kernel.gemanMcClure->modelParameter();
+      else if (kernel.tukey)
+        kernel.c = kernel.tukey->modelParameter();
+      else
+        continue;
+
+      const Threshold threshold = {i, kernel.c, kernel.gemanMcClure ? 3.0 : 5.0};
+      thresholds_.push_back(threshold);
+      // Estimators may be shared by many noise models, scale them only once
+      if (visited.insert(robust->robust().get()).second)
+        kernels_.push_back(kernel);
+    }
+
+    // All stages eliminate in the same order
+    if (!params_.inner.ordering)
+      params_.inner.ordering =
+          Ordering::Create(params_.inner.orderingType, graph_);
+  }
+
+  /**
+   * Run all stages, and return the solution of the original problem. If mu
+   * has not reached 1 when only one of maxStages is left, that stage is run at
+   * mu = 1, so the result never comes from a convexified problem.
+   */
+  const Values& optimize() {
+    const Restore restore = {kernels_};
+    const size_t maxStages = std::max<size_t>(params_.maxStages, 1);
+    double mu = std::max(initialMu(), 1.0);
+    for (stages_ = 0;;) {
+      if (stages_ + 1 == maxStages) mu = 1.0;
+      for (const Kernel& kernel : kernels_) kernel.scale(std::sqrt(mu));
+      InnerOptimizer optimizer(graph_, values_, params_.inner);
+      values_ = optimizer.optimize();
+      iterations_ += optimizer.iterations();
+      ++stages_;
+      if (mu == 1.0) break;
+      mu = std::max(mu / params_.muStep, 1.0);
+    }
+    return values_;
+  }
+
+  /// The current estimate
+  const Values& values() const { return values_; }
+
+  /// The number of stages run by optimize()
+  size_t stages() const { return stages_; }
+
+  /// The total number of iterations of the inner optimizer
+  size_t iterations() const { return iterations_; }
+
+  /// The number of distinct robust estimators that are graduated
+  size_t numKernels() const { return kernels_.size(); }
+
+protected:
+
+  /**
+   * The control parameter at which all initial residuals are in the convex
+   * region of their (scaled) estimator, unless given by the parameters.
+   */
+  double initialMu() const {
+    if (params_.muInit > 0.0) return params_.muInit;
+    double mu = 1.0;
+    for (const Threshold& threshold : thresholds_) {
+      const NoiseModelFactor& factor =
+          static_cast<const NoiseModelFactor&>(*graph_[threshold.factor]);
+      const noiseModel::Robust& robust =
+          static_cast<const noiseModel::Robust&>(*factor.noiseModel());
+      const double r2 =
+          robust.noise()->distance(factor.unwhitenedError(values_));
+      mu = std::max(mu, threshold.convexity * r2 / (threshold.c * threshold.c));
+    }
+    return mu;
+  }
+};
+
+} // namespace gtsam
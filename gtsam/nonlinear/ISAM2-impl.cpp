@@ -22,10 +22,19 @@
 #include <gtsam/inference/Symbol.h>  // for selective linearization thresholds
 #include <gtsam/nonlinear/ISAM2-impl.h>
 
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 #include <boost/range/adaptors.hpp>
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -156,4 +165,191 @@ VectorValues DeltaImpl::ComputeGradientSearch(const VectorValues& gradAtZero,
   return step * gradAtZero;
 }
 
+/* ************************************************************************* */
+namespace internal {
+/// Tests variable deltas against ISAM2Params::relinearizeThreshold
+class RelinearizationCheck {
+  const double* threshold_;
+  const FastMap<char, Vector>* thresholds_;
+
+ public:
+  explicit RelinearizationCheck(
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold)
+      : threshold_(boost::get<double>(&relinearizeThreshold)),
+        thresholds_(
+            boost::get<FastMap<char, Vector> >(&relinearizeThreshold)) {}
+
+  /// Whether the delta of variable \c var is above the threshold
+  bool operator()(Key var, const Vector& deltaVar) const {
+    if (threshold_) return deltaVar.lpNorm<Eigen::Infinity>() >= *threshold_;
+
+    // Find the threshold for this variable type
+    const Vector& threshold = thresholds_->find(Symbol(var).chr())->second;
+
+    // Verify the threshold vector matches the actual variable size
+    if (threshold.rows() != deltaVar.rows())
+      throw std::invalid_argument(
+          "Relinearization threshold vector dimensionality for '" +
+          std::string(1, Symbol(var).chr()) +
+          "' passed into iSAM2 parameters does not match actual variable "
+          "dimensionality.");
+
+    return (deltaVar.array().abs() > threshold.array()).any();
+  }
+};
+
+#ifdef GTSAM_USE_TBB
+typedef tbb::enumerable_thread_specific<KeyVector> ThreadKeyVectors;
+
+// Subtrees are checked in parallel, each thread appending to its own vector
+static void checkRelinearizationRecursive(const RelinearizationCheck& check,
+                                          const VectorValues& delta,
+                                          const ISAM2::sharedClique& clique,
+                                          ThreadKeyVectors* relinKeys) {
+  // Check the current clique for relinearization
+  bool relinearize = false;
+  KeyVector& localKeys = relinKeys->local();
+  for (Key var : *clique->conditional()) {
+    if (check(var, delta[var])) {
+      localKeys.push_back(var);
+      relinearize = true;
+    }
+  }
+
+  // If this node was relinearized, also check its children
+  if (relinearize) {
+    const auto& children = clique->children;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, children.size()),
+                      [&](const tbb::blocked_range<size_t>& range) {
+                        for (size_t i = range.begin(); i != range.end(); ++i)
+                          checkRelinearizationRecursive(check, delta,
+                                                        children[i], relinKeys);
+                      });
+  }
+}
+#else
+static void checkRelinearizationRecursive(const RelinearizationCheck& check,
+                                          const VectorValues& delta,
+                                          const ISAM2::sharedClique& clique,
+                                          KeySet* relinKeys) {
+  // Check the current clique for relinearization
+  bool relinearize = false;
+  for (Key var : *clique->conditional()) {
+    if (check(var, delta[var])) {
+      relinKeys->insert(var);
+      relinearize = true;
+    }
+  }
+
+  // If this node was relinearized, also check its children
+  if (relinearize) {
+    for (const ISAM2::sharedClique& child : clique->children)
+      checkRelinearizationRecursive(check, delta, child, relinKeys);
+  }
+}
+#endif
+}  // namespace internal
+
+/* ************************************************************************* */
+KeySet UpdateImpl::CheckRelinearizationPartial(
+    const ISAM2::Roots& roots, const VectorValues& delta,
+    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) {
+  const internal::RelinearizationCheck check(relinearizeThreshold);
+#ifdef GTSAM_USE_TBB
+  internal::ThreadKeyVectors threadKeys;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, roots.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        internal::checkRelinearizationRecursive(
+                            check, delta, roots[i], &threadKeys);
+                    });
+
+  // Merge the per-thread keys, sorted so the set is built in linear time
+  KeyVector relinKeys;
+  for (const KeyVector& keys : threadKeys)
+    relinKeys.insert(relinKeys.end(), keys.begin(), keys.end());
+  std::sort(relinKeys.begin(), relinKeys.end());
+  return KeySet(relinKeys.begin(), relinKeys.end());
+#else
+  KeySet relinKeys;
+  for (const ISAM2::sharedClique& root : roots)
+    internal::checkRelinearizationRecursive(check, delta, root, &relinKeys);
+  return relinKeys;
+#endif
+}
+
+/* ************************************************************************* */
+KeySet UpdateImpl::CheckRelinearizationFull(
+    const VectorValues& delta,
+    const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) {
+  const internal::RelinearizationCheck check(relinearizeThreshold);
+  KeySet relinKeys;
+#ifdef GTSAM_USE_TBB
+  // Flatten the delta so the variables can be tested in parallel
+  KeyVector keys;
+  std::vector<const Vector*> deltas;
+  keys.reserve(delta.size());
+  deltas.reserve(delta.size());
+  for (const VectorValues::KeyValuePair& key_delta : delta) {
+    keys.push_back(key_delta.first);
+    deltas.push_back(&key_delta.second);
+  }
+
+  std::vector<char> above(keys.size());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, keys.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        above[i] = check(keys[i], *deltas[i]);
+                    });
+
+  KeyVector sortedKeys;
+  for (size_t i = 0; i < keys.size(); ++i)
+    if (above[i]) sortedKeys.push_back(keys[i]);
+  std::sort(sortedKeys.begin(), sortedKeys.end());
+  relinKeys.insert(sortedKeys.begin(), sortedKeys.end());
+#else
+  // The delta is sorted by key, so append at the end
+  for (const VectorValues::KeyValuePair& key_delta : delta)
+    if (check(key_delta.first, key_delta.second))
+      relinKeys.insert(relinKeys.end(), key_delta.first);
+#endif
+  return relinKeys;
+}
+
+/* ************************************************************************* */
+void UpdateImpl::ExpmapMasked(const VectorValues& delta, const KeySet& mask,
+                              Values* theta) {
+  gttic(ExpmapMasked);
+  assert(theta->size() == delta.size());
+
+  // Visit only the masked variables, looking each up once, instead of
+  // walking all of theta and delta
+  std::vector<std::pair<Value*, const Vector*> > masked;
+  masked.reserve(mask.size());
+  for (Key var : mask) {
+    Values::iterator key_value = theta->find(var);
+    assert(key_value != theta->end());
+    const Vector& deltaVar = delta.at(var);
+    assert(static_cast<size_t>(deltaVar.size()) == key_value->value.dim());
+    assert(deltaVar.allFinite());
+    masked.emplace_back(&key_value->value, &deltaVar);
+  }
+
+  auto retract = [&masked](size_t i) {
+    Value& value = *masked[i].first;
+    Value* retracted = value.retract_(*masked[i].second);
+    value = *retracted;
+    retracted->deallocate_();
+  };
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, masked.size()),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        retract(i);
+                    });
+#else
+  for (size_t i = 0; i < masked.size(); ++i) retract(i);
+#endif
+}
+
 }  // namespace gtsam
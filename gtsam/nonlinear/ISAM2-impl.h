@@ -39,6 +39,7 @@ using namespace boost::adaptors;
 #include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace gtsam {
 
@@ -247,61 +248,6 @@ struct GTSAM_EXPORT UpdateImpl {
     }
   }
 
-  static void CheckRelinearizationRecursiveMap(
-      const FastMap<char, Vector>& thresholds, const VectorValues& delta,
-      const ISAM2::sharedClique& clique, KeySet* relinKeys) {
-    // Check the current clique for relinearization
-    bool relinearize = false;
-    for (Key var : *clique->conditional()) {
-      // Find the threshold for this variable type
-      const Vector& threshold = thresholds.find(Symbol(var).chr())->second;
-
-      const Vector& deltaVar = delta[var];
-
-      // Verify the threshold vector matches the actual variable size
-      if (threshold.rows() != deltaVar.rows())
-        throw std::invalid_argument(
-            "Relinearization threshold vector dimensionality for '" +
-            std::string(1, Symbol(var).chr()) +
-            "' passed into iSAM2 parameters does not match actual variable "
-            "dimensionality.");
-
-      // Check for relinearization
-      if ((deltaVar.array().abs() > threshold.array()).any()) {
-        relinKeys->insert(var);
-        relinearize = true;
-      }
-    }
-
-    // If this node was relinearized, also check its children
-    if (relinearize) {
-      for (const ISAM2::sharedClique& child : clique->children) {
-        CheckRelinearizationRecursiveMap(thresholds, delta, child, relinKeys);
-      }
-    }
-  }
-
-  static void CheckRelinearizationRecursiveDouble(
-      double threshold, const VectorValues& delta,
-      const ISAM2::sharedClique& clique, KeySet* relinKeys) {
-    // Check the current clique for relinearization
-    bool relinearize = false;
-    for (Key var : *clique->conditional()) {
-      double maxDelta = delta[var].lpNorm<Eigen::Infinity>();
-      if (maxDelta >= threshold) {
-        relinKeys->insert(var);
-        relinearize = true;
-      }
-    }
-
-    // If this node was relinearized, also check its children
-    if (relinearize) {
-      for (const ISAM2::sharedClique& child : clique->children) {
-        CheckRelinearizationRecursiveDouble(threshold, delta, child, relinKeys);
-      }
-    }
-  }
-
   /**
    * Find the set of variables to be relinearized according to
    * relinearizeThreshold. This check is performed recursively, starting at
@@ -317,19 +263,7 @@ struct GTSAM_EXPORT UpdateImpl {
    */
   static KeySet CheckRelinearizationPartial(
       const ISAM2::Roots& roots, const VectorValues& delta,
-      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) {
-    KeySet relinKeys;
-    for (const ISAM2::sharedClique& root : roots) {
-      if (relinearizeThreshold.type() == typeid(double))
-        CheckRelinearizationRecursiveDouble(
-            boost::get<double>(relinearizeThreshold), delta, root, &relinKeys);
-      else if (relinearizeThreshold.type() == typeid(FastMap<char, Vector>))
-        CheckRelinearizationRecursiveMap(
-            boost::get<FastMap<char, Vector> >(relinearizeThreshold), delta,
-            root, &relinKeys);
-    }
-    return relinKeys;
-  }
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold);
 
   /**
    * Find the set of variables to be relinearized according to
@@ -344,38 +278,58 @@ struct GTSAM_EXPORT UpdateImpl {
    */
   static KeySet CheckRelinearizationFull(
       const VectorValues& delta,
-      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) {
-    KeySet relinKeys;
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold);
 
+  /**
+   * How far the delta of a variable exceeds relinearizeThreshold, as the
+   * largest ratio of a delta component to its threshold.  Used to prioritize
+   * relinearization when it is limited by maxRelinearizeKeys.
+   */
+  static double RelinearizationPriority(
+      Key key, const Vector& deltaVar,
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold) {
     if (const double* threshold = boost::get<double>(&relinearizeThreshold)) {
-      for (const VectorValues::KeyValuePair& key_delta : delta) {
-        double maxDelta = key_delta.second.lpNorm<Eigen::Infinity>();
-        if (maxDelta >= *threshold) relinKeys.insert(key_delta.first);
-      }
-    } else if (const FastMap<char, Vector>* thresholds =
-                   boost::get<FastMap<char, Vector> >(&relinearizeThreshold)) {
-      for (const VectorValues::KeyValuePair& key_delta : delta) {
-        const Vector& threshold =
-            thresholds->find(Symbol(key_delta.first).chr())->second;
-        if (threshold.rows() != key_delta.second.rows())
-          throw std::invalid_argument(
-              "Relinearization threshold vector dimensionality for '" +
-              std::string(1, Symbol(key_delta.first).chr()) +
-              "' passed into iSAM2 parameters does not match actual variable "
-              "dimensionality.");
-        if ((key_delta.second.array().abs() > threshold.array()).any())
-          relinKeys.insert(key_delta.first);
-      }
+      const double maxDelta = deltaVar.lpNorm<Eigen::Infinity>();
+      return *threshold > 0.0 ? maxDelta / *threshold : maxDelta;
     }
+    const FastMap<char, Vector>& thresholds =
+        boost::get<FastMap<char, Vector> >(relinearizeThreshold);
+    const Vector& threshold = thresholds.find(Symbol(key).chr())->second;
+    return (deltaVar.array().abs() / threshold.array()).maxCoeff();
+  }
 
-    return relinKeys;
+  /**
+   * Keep only the \c maxKeys variables of \c relinKeys with the largest
+   * RelinearizationPriority, ties broken by key.
+   * @return The number of variables removed from \c relinKeys
+   */
+  static size_t LimitRelinearizeKeys(
+      const VectorValues& delta,
+      const ISAM2Params::RelinearizationThreshold& relinearizeThreshold,
+      size_t maxKeys, KeySet* relinKeys) {
+    if (relinKeys->size() <= maxKeys) return 0;
+    gttic(LimitRelinearizeKeys);
+
+    std::vector<std::pair<double, Key> > priorities;
+    priorities.reserve(relinKeys->size());
+    for (Key key : *relinKeys)
+      priorities.emplace_back(
+          -RelinearizationPriority(key, delta[key], relinearizeThreshold), key);
+    std::nth_element(priorities.begin(), priorities.begin() + maxKeys,
+                     priorities.end());
+
+    const size_t deferred = relinKeys->size() - maxKeys;
+    relinKeys->clear();
+    for (size_t i = 0; i < maxKeys; ++i) relinKeys->insert(priorities[i].second);
+    return deferred;
   }
 
   // Mark keys in \Delta above threshold \beta:
   KeySet gatherRelinearizeKeys(const ISAM2::Roots& roots,
                                const VectorValues& delta,
                                const KeySet& fixedVariables,
-                               KeySet* markedKeys) const {
+                               KeySet* markedKeys,
+                               size_t* variablesDeferred) const {
     gttic(gatherRelinearizeKeys);
     // J=\{\Delta_{j}\in\Delta|\Delta_{j}\geq\beta\}.
     KeySet relinKeys =
@@ -396,6 +350,14 @@ struct GTSAM_EXPORT UpdateImpl {
       }
     }
 
+    // Relinearize the variables furthest above the threshold first, and leave
+    // the rest for later updates
+    *variablesDeferred = 0;
+    if (updateParams_.maxRelinearizeKeys)
+      *variablesDeferred =
+          LimitRelinearizeKeys(delta, params_.relinearizeThreshold,
+                               *updateParams_.maxRelinearizeKeys, &relinKeys);
+
     // Add the variables being relinearized to the marked keys
     markedKeys->insert(relinKeys.begin(), relinKeys.end());
     return relinKeys;
@@ -442,29 +404,7 @@ struct GTSAM_EXPORT UpdateImpl {
    * \param mask Mask on linear indices, only \c true entries are expmapped
    */
   static void ExpmapMasked(const VectorValues& delta, const KeySet& mask,
-                           Values* theta) {
-    gttic(ExpmapMasked);
-    assert(theta->size() == delta.size());
-    Values::iterator key_value;
-    VectorValues::const_iterator key_delta;
-#ifdef GTSAM_USE_TBB
-    for (key_value = theta->begin(); key_value != theta->end(); ++key_value) {
-      key_delta = delta.find(key_value->key);
-#else
-    for (key_value = theta->begin(), key_delta = delta.begin();
-         key_value != theta->end(); ++key_value, ++key_delta) {
-      assert(key_value->key == key_delta->first);
-#endif
-      Key var = key_value->key;
-      assert(static_cast<size_t>(delta[var].size()) == key_value->value.dim());
-      assert(delta[var].allFinite());
-      if (mask.exists(var)) {
-        Value* retracted = key_value->value.retract_(delta[var]);
-        key_value->value = *retracted;
-        retracted->deallocate_();
-      }
-    }
-  }
+                           Values* theta);
 
   // Linearize new factors
   void linearizeNewFactors(const NonlinearFactorGraph& newFactors,
@@ -37,14 +37,25 @@ namespace gtsam {
 template class BayesTree<ISAM2Clique>;
 
 /* ************************************************************************* */
-ISAM2::ISAM2(const ISAM2Params& params) : params_(params), update_count_(0) {
+ISAM2::ISAM2(const ISAM2Params& params)
+    : params_(params),
+      update_count_(0),
+      variablesDeferred_(0),
+      estimateView_(boost::make_shared<ISAM2EstimateView>()),
+      checkpoint_(0),
+      lastCliqueId_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
 }
 
 /* ************************************************************************* */
-ISAM2::ISAM2() : update_count_(0) {
+ISAM2::ISAM2()
+    : update_count_(0),
+      variablesDeferred_(0),
+      estimateView_(boost::make_shared<ISAM2EstimateView>()),
+      checkpoint_(0),
+      lastCliqueId_(0) {
   if (params_.optimizationParams.type() == typeid(ISAM2DoglegParams))
     doglegDelta_ =
         boost::get<ISAM2DoglegParams>(params_.optimizationParams).initialDelta;
@@ -167,6 +178,9 @@ void ISAM2::recalculate(const ISAM2UpdateParams& updateParams,
 
     // Update replaced keys mask (accumulates until back-substitution happens)
     deltaReplacedMask_.insert(affectedKeysSet.begin(), affectedKeysSet.end());
+
+    if (params_.cacheMarginalCovariances)
+      invalidateMarginalCovariances(affectedKeysSet);
   }
 }
 
@@ -389,6 +403,8 @@ void ISAM2::removeVariables(const KeySet& unusedKeys) {
     Base::nodes_.unsafe_erase(key);
     theta_.erase(key);
     fixedVariables_.erase(key);
+    trackedMarginalKeys_.erase(key);
+    marginalCovariances_.erase(key);
   }
 }
 
@@ -420,9 +436,12 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   ISAM2Result result(params_.enableDetailedResults);
   UpdateImpl update(params_, updateParams);
 
+  // Check relinearization on periodic steps. Variables deferred by an earlier
+  // update are still above the threshold, and are picked up then.
+  const bool relinearize = update.relinarizationNeeded(update_count_);
+
   // Update delta if we need it to check relinearization later
-  if (update.relinarizationNeeded(update_count_))
-    updateDelta(updateParams.forceFullSolve);
+  if (relinearize) updateDelta(updateParams.forceFullSolve);
 
   // 1. Add any new factors \Factors:=\Factors\cup\Factors'.
   update.pushBackFactors(newFactors, &nonlinearFactors_, &linearFactors_,
@@ -444,10 +463,11 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
 
   KeySet relinKeys;
   result.variablesRelinearized = 0;
-  if (update.relinarizationNeeded(update_count_)) {
+  if (relinearize) {
     // 4. Mark keys in \Delta above threshold \beta:
     relinKeys = update.gatherRelinearizeKeys(roots_, delta_, fixedVariables_,
-                                             &result.markedKeys);
+                                             &result.markedKeys,
+                                             &result.variablesDeferred);
     update.recordRelinearizeDetail(relinKeys, result.details());
     if (!relinKeys.empty()) {
       // 5. Mark cliques that involve marked variables \Theta_{J} and ancestors.
@@ -457,6 +477,7 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
       UpdateImpl::ExpmapMasked(delta_, relinKeys, &theta_);
     }
     result.variablesRelinearized = result.markedKeys.size();
+    variablesDeferred_ = result.variablesDeferred;
   }
 
   // 7. Linearize new factors
@@ -469,6 +490,8 @@ ISAM2Result ISAM2::update(const NonlinearFactorGraph& newFactors,
   recalculate(updateParams, relinKeys, &result);
   if (!result.unusedKeys.empty()) removeVariables(result.unusedKeys);
   result.cliques = this->nodes().size();
+  if (params_.cacheMarginalCovariances) updateMarginalCovariances();
+  if (params_.publishEstimate) publishEstimate(relinKeys);
 
   if (params_.evaluateNonlinearError)
     update.error(nonlinearFactors_, calculateEstimate(), &result.errorAfter);
@@ -640,6 +663,7 @@ void ISAM2::marginalizeLeaves(
         originalKeys.swap(cg->keys());
         cg->keys().assign(originalKeys.begin() + nToRemove, originalKeys.end());
         cg->nrFrontals() -= nToRemove;
+        clique->checkpointId_ = 0;  // changed in place, see saveCheckpoint
 
         // Add to factorIndicesToRemove any factors involved in frontals of
         // current clique
@@ -694,6 +718,7 @@ void ISAM2::marginalizeLeaves(
 
   // Remove the marginalized variables
   removeVariables(KeySet(leafKeys.begin(), leafKeys.end()));
+  if (params_.publishEstimate) publishEstimate(KeySet());
 }
 
 /* ************************************************************************* */
@@ -759,6 +784,16 @@ void ISAM2::updateDelta(bool forceFullSolve) const {
   }
 }
 
+/* ************************************************************************* */
+void ISAM2::publishEstimate(const KeySet& relinKeys) {
+  gttic(publishEstimate);
+  // update() is the only writer, so reading our own pointer needs no atomics
+  auto view = boost::make_shared<ISAM2EstimateView>(
+      *estimateView_, theta_, getDelta(), relinKeys, update_count_);
+  boost::atomic_store(&estimateView_,
+                      ISAM2EstimateView::shared_ptr(std::move(view)));
+}
+
 /* ************************************************************************* */
 Values ISAM2::calculateEstimate() const {
   gttic(ISAM2_calculateEstimate);
@@ -782,11 +817,69 @@ Values ISAM2::calculateBestEstimate() const {
 
 /* ************************************************************************* */
 Matrix ISAM2::marginalCovariance(Key key) const {
+  auto cached = marginalCovariances_.find(key);
+  if (cached != marginalCovariances_.end()) return cached->second;
   return marginalFactor(key, params_.getEliminationFunction())
       ->information()
       .inverse();
 }
 
+/* ************************************************************************* */
+void ISAM2::trackMarginalCovariances(const KeyVector& keys) {
+  if (!params_.cacheMarginalCovariances)
+    throw std::invalid_argument(
+        "ISAM2::trackMarginalCovariances requires "
+        "ISAM2Params::cacheMarginalCovariances to be enabled");
+  trackedMarginalKeys_.insert(keys.begin(), keys.end());
+  updateMarginalCovariances();
+}
+
+/* ************************************************************************* */
+void ISAM2::untrackMarginalCovariances(const KeyVector& keys) {
+  for (Key key : keys) {
+    trackedMarginalKeys_.erase(key);
+    marginalCovariances_.erase(key);
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::invalidateMarginalCovariances(const KeySet& reeliminatedKeys) {
+  gttic(invalidateMarginalCovariances);
+  // The marginal on a variable depends on every clique on its path to the
+  // root. Removing the top always removes the root of the touched tree, so
+  // every cached marginal in that tree is stale, and only those in untouched
+  // trees survive.
+  for (auto it = marginalCovariances_.begin();
+       it != marginalCovariances_.end();) {
+    bool stale = true;
+    auto node = nodes_.find(it->first);
+    if (node != nodes_.end()) {
+      sharedClique clique = node->second;
+      while (!clique->isRoot()) clique = clique->parent();
+      stale = reeliminatedKeys.exists(clique->conditional()->front());
+    }
+    if (stale)
+      it = marginalCovariances_.erase(it);
+    else
+      ++it;
+  }
+}
+
+/* ************************************************************************* */
+void ISAM2::updateMarginalCovariances() {
+  gttic(updateMarginalCovariances);
+  // Separator marginals cached in the cliques are shared between the tracked
+  // keys, so each clique on their paths to the root is only marginalized once
+  // per update.
+  for (Key key : trackedMarginalKeys_) {
+    if (marginalCovariances_.count(key) || !nodes_.exists(key)) continue;
+    marginalCovariances_[key] =
+        marginalFactor(key, params_.getEliminationFunction())
+            ->information()
+            .inverse();
+  }
+}
+
 /* ************************************************************************* */
 const VectorValues& ISAM2::getDelta() const {
   if (!deltaReplacedMask_.empty()) updateDelta();
@@ -22,15 +22,20 @@
 
 #include <gtsam/linear/GaussianBayesTree.h>
 #include <gtsam/nonlinear/ISAM2Clique.h>
+#include <gtsam/nonlinear/ISAM2EstimateView.h>
 #include <gtsam/nonlinear/ISAM2Params.h>
 #include <gtsam/nonlinear/ISAM2Result.h>
 #include <gtsam/nonlinear/ISAM2UpdateParams.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <unordered_map>
 #include <vector>
 
 namespace gtsam {
 
+class BinaryInArchive;
+class BinaryOutArchive;
+
 /**
  * @addtogroup ISAM2
  * Implementation of the full ISAM2 algorithm for incremental nonlinear
@@ -96,6 +101,35 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   int update_count_;  ///< Counter incremented every update(), used to determine
                       ///< periodic relinearization
 
+  /** Number of variables above the relinearization threshold that the last
+   * relinearization step deferred, see ISAM2UpdateParams::maxRelinearizeKeys */
+  size_t variablesDeferred_;
+
+  /** Keys whose marginal covariances are kept up to date, see
+   * ISAM2Params::cacheMarginalCovariances */
+  KeySet trackedMarginalKeys_;
+
+  /** Cached marginal covariances of the tracked keys that are currently in the
+   * Bayes tree */
+  std::unordered_map<Key, Matrix> marginalCovariances_;
+
+  /** The most recently published estimate, see ISAM2Params::publishEstimate.
+   * Only accessed through boost::atomic_load and boost::atomic_store so that
+   * readers on other threads never block on update(). */
+  ISAM2EstimateView::shared_ptr estimateView_;
+
+  /** Number of the last checkpoint saved or restored, 0 if none, see
+   * saveCheckpoint */
+  mutable uint64_t checkpoint_;
+
+  /** Largest id given to a clique in a checkpoint */
+  mutable uint64_t lastCliqueId_;
+
+  /** The nonlinear and linear factors at the last checkpoint, to find the
+   * slots that changed since */
+  mutable NonlinearFactorGraph checkpointFactors_;
+  mutable GaussianFactorGraph checkpointLinearFactors_;
+
  public:
   using This = ISAM2;                       ///< This class
   using Base = BayesTree<ISAM2Clique>;      ///< The BayesTree base class
@@ -236,9 +270,44 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
    */
   const Value& calculateEstimate(Key key) const;
 
-  /** Return marginal on any variable as a covariance matrix */
+  /** Return the estimate published by the last update, see
+   * ISAM2Params::publishEstimate.  This is the only method that may be called
+   * from other threads while update() or marginalizeLeaves() run.  The
+   * returned view is immutable and remains valid for as long as it is held.
+   */
+  ISAM2EstimateView::shared_ptr estimateView() const {
+    return boost::atomic_load(&estimateView_);
+  }
+
+  /** Return marginal on any variable as a covariance matrix.  If the key is
+   * tracked (see trackMarginalCovariances()) the cached covariance is returned
+   * instead of eliminating the clique marginal. */
   Matrix marginalCovariance(Key key) const;
 
+  /** Register keys whose marginal covariances are kept up to date across
+   * updates.  Requires ISAM2Params::cacheMarginalCovariances.  Keys that are
+   * not in the system yet are picked up by the update that adds them.
+   */
+  void trackMarginalCovariances(const KeyVector& keys);
+
+  /** Stop keeping the marginal covariances of the given keys up to date */
+  void untrackMarginalCovariances(const KeyVector& keys);
+
+  /// Access the keys whose marginal covariances are kept up to date
+  const KeySet& getTrackedMarginalKeys() const { return trackedMarginalKeys_; }
+
+  /// Check whether an up-to-date marginal covariance is cached for the key
+  bool hasTrackedMarginalCovariance(Key key) const {
+    return marginalCovariances_.count(key) > 0;
+  }
+
+  /** Return the cached marginal covariance of a tracked key, without any
+   * elimination.  Throws std::out_of_range if no covariance is cached for it.
+   */
+  const Matrix& trackedMarginalCovariance(Key key) const {
+    return marginalCovariances_.at(key);
+  }
+
   /// @name Public members for non-typical usage
   /// @{
 
@@ -266,6 +335,42 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
 
   const ISAM2Params& params() const { return params_; }
 
+  /** Number of calls to update() so far */
+  int getUpdateCount() const { return update_count_; }
+
+  /** Number of variables whose relinearization the last relinearization step
+   * deferred, see ISAM2UpdateParams::maxRelinearizeKeys */
+  size_t getVariablesDeferred() const { return variablesDeferred_; }
+
+  /// @name Checkpoints
+  /// @{
+
+  /**
+   * Save the complete state of this ISAM2 in the binary format (see
+   * BinarySerialization.h), so that restoreCheckpoint continues exactly as if
+   * all updates had been replayed. The parameters are not saved: restore into
+   * an ISAM2 created with the same parameters. All variable and factor types
+   * have to be registered with BinaryRegistry.
+   *
+   * An incremental checkpoint only contains the cliques and factors that
+   * changed since the last checkpoint saved or restored by this ISAM2, and
+   * is restored on top of that one. Other state, such as theta and delta, is
+   * always saved in full.
+   */
+  void saveCheckpoint(BinaryOutArchive& ar, bool incremental = false) const;
+
+  /**
+   * Restore the state saved by saveCheckpoint. An incremental checkpoint
+   * requires that the previous checkpoint in its chain was restored last,
+   * and throws std::runtime_error otherwise.
+   */
+  void restoreCheckpoint(BinaryInArchive& ar);
+
+  /** Number of the last checkpoint saved or restored, 0 if none */
+  uint64_t getCheckpoint() const { return checkpoint_; }
+
+  /// @}
+
   /** prints out clique statistics */
   void printStats() const { getCliqueData().getStats().print(); }
 
@@ -315,6 +420,16 @@ class GTSAM_EXPORT ISAM2 : public BayesTree<ISAM2Clique> {
   void removeVariables(const KeySet& unusedKeys);
 
   void updateDelta(bool forceFullSolve = false) const;
+
+  /// Drop cached marginal covariances whose path to the root was re-eliminated
+  void invalidateMarginalCovariances(const KeySet& reeliminatedKeys);
+
+  /// Compute the missing marginal covariances of the tracked keys
+  void updateMarginalCovariances();
+
+  /// Publish a new estimate view, relinKeys had their linearization point
+  /// changed since the last publication
+  void publishEstimate(const KeySet& relinKeys);
 };  // ISAM2
 
 /// traits
@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2AsyncUpdater.cpp
+ * @brief   Runs ISAM2::update() on a worker thread, returning futures.
+ * @date    October 2026
+ */
+
+#include <gtsam/nonlinear/ISAM2AsyncUpdater.h>
+
+#include <utility>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ISAM2AsyncUpdater::ISAM2AsyncUpdater(ISAM2& isam, size_t maxPendingUpdates)
+    : isam_(isam),
+      maxPendingUpdates_(maxPendingUpdates > 0 ? maxPendingUpdates : 1),
+      busy_(false),
+      stop_(false) {
+  worker_ = thread(&ISAM2AsyncUpdater::run, this);
+}
+
+/* ************************************************************************* */
+ISAM2AsyncUpdater::~ISAM2AsyncUpdater() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    stop_ = true;
+  }
+  jobQueued_.notify_all();
+  worker_.join();
+}
+
+/* ************************************************************************* */
+future<ISAM2Result> ISAM2AsyncUpdater::update(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const ISAM2UpdateParams& updateParams) {
+  unique_lock<mutex> lock(mutex_);
+  jobTaken_.wait(lock, [this] { return jobs_.size() < maxPendingUpdates_; });
+  return enqueue(newFactors, newTheta, updateParams);
+}
+
+/* ************************************************************************* */
+bool ISAM2AsyncUpdater::tryUpdate(const NonlinearFactorGraph& newFactors,
+                                  const Values& newTheta,
+                                  const ISAM2UpdateParams& updateParams,
+                                  future<ISAM2Result>* result) {
+  lock_guard<mutex> lock(mutex_);
+  if (jobs_.size() >= maxPendingUpdates_) return false;
+  *result = enqueue(newFactors, newTheta, updateParams);
+  return true;
+}
+
+/* ************************************************************************* */
+void ISAM2AsyncUpdater::waitUntilIdle() {
+  unique_lock<mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+}
+
+/* ************************************************************************* */
+size_t ISAM2AsyncUpdater::pendingUpdates() const {
+  lock_guard<mutex> lock(mutex_);
+  return jobs_.size();
+}
+
+/* ************************************************************************* */
+// Called with mutex_ held
+future<ISAM2Result> ISAM2AsyncUpdater::enqueue(
+    const NonlinearFactorGraph& newFactors, const Values& newTheta,
+    const ISAM2UpdateParams& updateParams) {
+  jobs_.emplace_back();
+  Job& job = jobs_.back();
+  job.newFactors = newFactors;
+  job.newTheta = newTheta;
+  job.updateParams = updateParams;
+  future<ISAM2Result> result = job.result.get_future();
+  jobQueued_.notify_one();
+  return result;
+}
+
+/* ************************************************************************* */
+void ISAM2AsyncUpdater::run() {
+  unique_lock<mutex> lock(mutex_);
+  while (true) {
+    jobQueued_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+    // Only stop once every queued update has been run
+    if (jobs_.empty()) break;
+
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    busy_ = true;
+    jobTaken_.notify_all();
+    lock.unlock();
+
+    try {
+      job.result.set_value(
+          isam_.update(job.newFactors, job.newTheta, job.updateParams));
+    } catch (...) {
+      job.result.set_exception(current_exception());
+    }
+
+    lock.lock();
+    busy_ = false;
+    if (jobs_.empty()) idle_.notify_all();
+  }
+}
+
+}  // namespace gtsam
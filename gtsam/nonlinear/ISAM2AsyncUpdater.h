@@ -0,0 +1,124 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2AsyncUpdater.h
+ * @brief   Runs ISAM2::update() on a worker thread, returning futures.
+ * @date    October 2026
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * Asynchronous front-end for ISAM2.  Calls to update() are queued and executed
+ * in order on a worker thread, and return a std::future for the ISAM2Result.
+ * The caller copies the new factors and values into a job, blocking while
+ * maxPendingUpdates jobs are already waiting (back-pressure), and can assemble
+ * the next batch while the worker runs ISAM2::update() on earlier ones.
+ *
+ * Each job is one unmodified call to ISAM2::update(), so results are the same
+ * as calling it synchronously with the same sequence of arguments.
+ *
+ * The wrapped ISAM2 must outlive this object.  While updates are pending, it
+ * may only be accessed through ISAM2::estimateView(); call waitUntilIdle()
+ * before using it directly.
+ */
+class GTSAM_EXPORT ISAM2AsyncUpdater {
+ private:
+  /// A queued call to ISAM2::update()
+  struct Job {
+    NonlinearFactorGraph newFactors;
+    Values newTheta;
+    ISAM2UpdateParams updateParams;
+    std::promise<ISAM2Result> result;
+  };
+
+  ISAM2& isam_;
+  const size_t maxPendingUpdates_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable jobQueued_;  ///< Signals the worker
+  std::condition_variable jobTaken_;   ///< Signals blocked callers
+  std::condition_variable idle_;       ///< Signals waitUntilIdle()
+  std::deque<Job> jobs_;
+  bool busy_;
+  bool stop_;
+
+  std::thread worker_;
+
+ public:
+  /**
+   * Start the worker thread.
+   * @param isam The ISAM2 instance to update
+   * @param maxPendingUpdates Number of queued updates after which update()
+   * blocks until the worker catches up
+   */
+  explicit ISAM2AsyncUpdater(ISAM2& isam, size_t maxPendingUpdates = 1);
+
+  /// Finish all queued updates and stop the worker thread
+  ~ISAM2AsyncUpdater();
+
+  ISAM2AsyncUpdater(const ISAM2AsyncUpdater&) = delete;
+  ISAM2AsyncUpdater& operator=(const ISAM2AsyncUpdater&) = delete;
+
+  /**
+   * Queue a call to ISAM2::update(), blocking while maxPendingUpdates calls are
+   * already queued.  Exceptions thrown by the update are rethrown from the
+   * returned future.
+   */
+  std::future<ISAM2Result> update(
+      const NonlinearFactorGraph& newFactors = NonlinearFactorGraph(),
+      const Values& newTheta = Values(),
+      const ISAM2UpdateParams& updateParams = ISAM2UpdateParams());
+
+  /**
+   * Queue a call to ISAM2::update() only if fewer than maxPendingUpdates calls
+   * are queued.
+   * @return false, without queueing anything, if the queue is full
+   */
+  bool tryUpdate(const NonlinearFactorGraph& newFactors,
+                 const Values& newTheta,
+                 const ISAM2UpdateParams& updateParams,
+                 std::future<ISAM2Result>* result);
+
+  /// Block until every queued update has finished
+  void waitUntilIdle();
+
+  /// Number of queued updates that have not started yet
+  size_t pendingUpdates() const;
+
+  /// Access the latest published estimate, see ISAM2::estimateView()
+  ISAM2EstimateView::shared_ptr estimateView() const {
+    return isam_.estimateView();
+  }
+
+ private:
+  std::future<ISAM2Result> enqueue(const NonlinearFactorGraph& newFactors,
+                                   const Values& newTheta,
+                                   const ISAM2UpdateParams& updateParams);
+
+  void run();
+};
+
+}  // namespace gtsam
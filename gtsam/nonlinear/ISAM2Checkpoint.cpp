@@ -0,0 +1,258 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2Checkpoint.cpp
+ * @date    October 2026
+ * @brief   Saving and restoring the state of ISAM2 in the binary format
+ */
+
+#include <gtsam/nonlinear/BinarySerialization.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/ISAM2-impl.h>
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+void writeKeySet(BinaryOutArchive& ar, const KeySet& keys) {
+  writeKeys(ar, KeyVector(keys.begin(), keys.end()));
+}
+
+KeySet readKeySet(BinaryInArchive& ar) {
+  const KeyVector keys = readKeys(ar);
+  return KeySet(keys.begin(), keys.end());
+}
+
+/**
+ * Write the size of graph, and the factors in the slots that differ from
+ * previous, with their indices. All slots are written unless incremental.
+ */
+template <class GRAPH>
+void writeChangedFactors(BinaryOutArchive& ar, const GRAPH& graph,
+                         const GRAPH& previous, bool incremental) {
+  vector<uint64_t> indices;
+  GRAPH changed;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    if (!incremental || i >= previous.size() || graph[i] != previous[i]) {
+      indices.push_back(i);
+      changed.push_back(graph[i]);
+    }
+  }
+  ar.write<uint64_t>(graph.size());
+  ar.write<uint64_t>(indices.size());
+  ar.writeBytes(indices.data(), indices.size() * sizeof(uint64_t));
+  writeBinary(ar, changed);
+}
+
+/// Read the slots written by writeChangedFactors into graph
+template <class GRAPH>
+void readChangedFactors(BinaryInArchive& ar, GRAPH* graph) {
+  const uint64_t size = ar.read<uint64_t>();
+  vector<uint64_t> indices(ar.read<uint64_t>());
+  for (uint64_t& index : indices) {
+    index = ar.read<uint64_t>();
+    if (index >= size)
+      throw runtime_error("ISAM2::restoreCheckpoint: corrupt factor index");
+  }
+  GRAPH changed;
+  readBinary(ar, changed);
+  if (changed.size() != indices.size())
+    throw runtime_error("ISAM2::restoreCheckpoint: corrupt factors");
+  graph->resize(size);
+  for (size_t k = 0; k < indices.size(); ++k)
+    (*graph)[indices[k]] = changed[k];
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void ISAM2::saveCheckpoint(BinaryOutArchive& ar, bool incremental) const {
+  gttic(ISAM2_saveCheckpoint);
+  if (incremental && checkpoint_ == 0)
+    throw invalid_argument(
+        "ISAM2::saveCheckpoint: an incremental checkpoint needs a previous "
+        "checkpoint");
+
+  ar.beginSection(BINARY_ISAM2_CHECKPOINT);
+  ar.write<uint64_t>(checkpoint_ + 1);
+  ar.write<uint64_t>(incremental ? checkpoint_ : 0);
+
+  writeBinary(ar, theta_);
+  writeBinary(ar, variableIndex_);
+  writeBinary(ar, delta_);
+  writeBinary(ar, deltaNewton_);
+  writeBinary(ar, RgProd_);
+  writeKeySet(ar, deltaReplacedMask_);
+  writeChangedFactors(ar, nonlinearFactors_, checkpointFactors_, incremental);
+  writeChangedFactors(ar, linearFactors_, checkpointLinearFactors_,
+                      incremental);
+  ar.write<uint8_t>(doglegDelta_.is_initialized());
+  ar.write(doglegDelta_ ? *doglegDelta_ : 0.0);
+  writeKeySet(ar, fixedVariables_);
+  ar.write<int64_t>(update_count_);
+  ar.write<uint64_t>(variablesDeferred_);
+  writeKeySet(ar, trackedMarginalKeys_);
+  KeyVector covarianceKeys;
+  for (const auto& keyCovariance : marginalCovariances_)
+    covarianceKeys.push_back(keyCovariance.first);
+  std::sort(covarianceKeys.begin(), covarianceKeys.end());
+  writeKeys(ar, covarianceKeys);
+  for (Key key : covarianceKeys) ar.writeMatrix(marginalCovariances_.at(key));
+
+  // Cliques that were saved before are written as their id only. Ids are
+  // assigned once the whole checkpoint has been written.
+  uint64_t lastCliqueId = lastCliqueId_;
+  vector<pair<const Clique*, uint64_t> > newIds;
+  writeBayesTree<Clique>(ar, *this, [&](BinaryOutArchive& ar,
+                                        const Clique& clique) {
+    uint64_t id = clique.checkpointId_;
+    const bool stored = !incremental || id == 0;
+    if (id == 0) {
+      id = ++lastCliqueId;
+      newIds.push_back(make_pair(&clique, id));
+    }
+    ar.write(id);
+    ar.write<uint8_t>(stored);
+    if (stored) {
+      writeGaussianFactor(ar, clique.conditional());
+      writeGaussianFactor(ar, clique.cachedFactor_);
+      ar.writeVector(clique.gradientContribution_);
+    }
+  });
+  ar.endSection();
+
+  for (const auto& cliqueId : newIds)
+    cliqueId.first->checkpointId_ = cliqueId.second;
+  lastCliqueId_ = lastCliqueId;
+  checkpointFactors_ = nonlinearFactors_;
+  checkpointLinearFactors_ = linearFactors_;
+  ++checkpoint_;
+}
+
+/* ************************************************************************* */
+void ISAM2::restoreCheckpoint(BinaryInArchive& ar) {
+  gttic(ISAM2_restoreCheckpoint);
+  ar.readSection(BINARY_ISAM2_CHECKPOINT);
+  const uint64_t checkpoint = ar.read<uint64_t>();
+  const uint64_t base = ar.read<uint64_t>();
+  const bool incremental = base != 0;
+  if (incremental && base != checkpoint_)
+    throw runtime_error("ISAM2::restoreCheckpoint: checkpoint " +
+                        to_string(checkpoint) + " follows checkpoint " +
+                        to_string(base) + ", but the last one restored is " +
+                        to_string(checkpoint_));
+
+  // Read everything before changing this ISAM2, so that it is left unchanged
+  // if the checkpoint is corrupt
+  Values theta;
+  readBinary(ar, theta);
+  VariableIndex variableIndex;
+  readBinary(ar, variableIndex);
+  VectorValues delta, deltaNewton, RgProd;
+  readBinary(ar, delta);
+  readBinary(ar, deltaNewton);
+  readBinary(ar, RgProd);
+  const KeySet deltaReplacedMask = readKeySet(ar);
+  NonlinearFactorGraph nonlinearFactors;
+  GaussianFactorGraph linearFactors;
+  if (incremental) {
+    nonlinearFactors = checkpointFactors_;
+    linearFactors = checkpointLinearFactors_;
+  }
+  readChangedFactors(ar, &nonlinearFactors);
+  readChangedFactors(ar, &linearFactors);
+  const bool hasDoglegDelta = ar.read<uint8_t>();
+  const double doglegDelta = ar.read<double>();
+  const KeySet fixedVariables = readKeySet(ar);
+  const int64_t updateCount = ar.read<int64_t>();
+  const uint64_t variablesDeferred = ar.read<uint64_t>();
+  const KeySet trackedMarginalKeys = readKeySet(ar);
+  std::unordered_map<Key, Matrix> marginalCovariances;
+  for (Key key : readKeys(ar)) marginalCovariances[key] = ar.readMatrix();
+
+  // Cliques that were not saved again are copied from the current tree
+  std::unordered_map<uint64_t, sharedClique> cliquesById;
+  if (incremental) {
+    for (const auto& keyClique : nodes_)
+      cliquesById[keyClique.second->checkpointId_] = keyClique.second;
+  }
+  uint64_t lastCliqueId = lastCliqueId_;
+  ISAM2BayesTree bayesTree;
+  readBayesTree<Clique>(ar, bayesTree, [&](BinaryInArchive& ar) {
+    const uint64_t id = ar.read<uint64_t>();
+    GaussianConditional::shared_ptr conditional;
+    GaussianFactor::shared_ptr cachedFactor;
+    Vector gradientContribution;
+    if (ar.read<uint8_t>()) {
+      conditional = boost::dynamic_pointer_cast<GaussianConditional>(
+          readGaussianFactor(ar));
+      if (!conditional)
+        throw runtime_error("ISAM2::restoreCheckpoint: clique without conditional");
+      cachedFactor = readGaussianFactor(ar);
+      gradientContribution = ar.readVector();
+    } else {
+      auto existing = cliquesById.find(id);
+      if (existing == cliquesById.end())
+        throw runtime_error("ISAM2::restoreCheckpoint: missing clique " +
+                            to_string(id));
+      conditional = existing->second->conditional();
+      cachedFactor = existing->second->cachedFactor_;
+      gradientContribution = existing->second->gradientContribution_;
+    }
+    auto clique = boost::make_shared<Clique>();
+    clique->setEliminationResult(make_pair(conditional, cachedFactor));
+    clique->gradientContribution_ = gradientContribution;
+    clique->checkpointId_ = id;
+    lastCliqueId = std::max(lastCliqueId, id);
+    return clique;
+  });
+
+  clear();
+  for (const sharedClique& root : bayesTree.roots()) insertRoot(root);
+  theta_ = theta;
+  variableIndex_ = variableIndex;
+  delta_ = delta;
+  deltaNewton_ = deltaNewton;
+  RgProd_ = RgProd;
+  deltaReplacedMask_ = deltaReplacedMask;
+  nonlinearFactors_ = nonlinearFactors;
+  linearFactors_ = linearFactors;
+  if (hasDoglegDelta)
+    doglegDelta_ = doglegDelta;
+  else
+    doglegDelta_ = boost::none;
+  fixedVariables_ = fixedVariables;
+  update_count_ = updateCount;
+  variablesDeferred_ = variablesDeferred;
+  trackedMarginalKeys_ = trackedMarginalKeys;
+  marginalCovariances_ = marginalCovariances;
+
+  checkpoint_ = checkpoint;
+  lastCliqueId_ = lastCliqueId;
+  checkpointFactors_ = nonlinearFactors_;
+  checkpointLinearFactors_ = linearFactors_;
+
+  if (params_.publishEstimate) {
+    estimateView_ = boost::make_shared<ISAM2EstimateView>();
+    publishEstimate(KeySet());
+  }
+}
+
+}  // namespace gtsam
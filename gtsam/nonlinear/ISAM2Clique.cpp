@@ -35,6 +35,7 @@ void ISAM2Clique::setEliminationResult(
     const FactorGraphType::EliminationResult& eliminationResult) {
   conditional_ = eliminationResult.first;
   cachedFactor_ = eliminationResult.second;
+  checkpointId_ = 0;
   // Compute gradient contribution
   gradientContribution_.resize(conditional_->cols() - 1);
   // Rewrite -(R * P')'*d   as   -(d' * R * P')'   for computational speed
@@ -45,19 +45,22 @@ class GTSAM_EXPORT ISAM2Clique
 
   Base::FactorType::shared_ptr cachedFactor_;
   Vector gradientContribution_;
+  /// Id of this clique in ISAM2 checkpoints, 0 if its contents were not saved
+  mutable uint64_t checkpointId_;
 #ifdef USE_BROKEN_FAST_BACKSUBSTITUTE
   mutable FastMap<Key, VectorValues::iterator> solnPointers_;
 #endif
 
   /// Default constructor
-  ISAM2Clique() : Base() {}
+  ISAM2Clique() : Base(), checkpointId_(0) {}
 
   /// Copy constructor, does *not* copy solution pointers as these are invalid
   /// in different trees.
   ISAM2Clique(const ISAM2Clique& other)
       : Base(other),
         cachedFactor_(other.cachedFactor_),
-        gradientContribution_(other.gradientContribution_) {}
+        gradientContribution_(other.gradientContribution_),
+        checkpointId_(other.checkpointId_) {}
 
   /// Assignment operator, does *not* copy solution pointers as these are
   /// invalid in different trees.
@@ -65,6 +68,7 @@ class GTSAM_EXPORT ISAM2Clique
     Base::operator=(other);
     cachedFactor_ = other.cachedFactor_;
     gradientContribution_ = other.gradientContribution_;
+    checkpointId_ = other.checkpointId_;
     return *this;
   }
 
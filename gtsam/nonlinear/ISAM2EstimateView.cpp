@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2EstimateView.cpp
+ * @brief   Immutable snapshot of the iSAM2 estimate, for concurrent readers.
+ * @date    October 2026
+ */
+
+#include <gtsam/base/timing.h>
+#include <gtsam/nonlinear/ISAM2EstimateView.h>
+
+#include <boost/make_shared.hpp>
+
+#include <utility>
+
+using namespace std;
+
+namespace gtsam {
+
+/* ************************************************************************* */
+ISAM2EstimateView::ISAM2EstimateView(const ISAM2EstimateView& previous,
+                                     const Values& theta,
+                                     const VectorValues& delta,
+                                     const KeySet& relinearizedKeys,
+                                     size_t updateCount)
+    : updateCount_(updateCount) {
+  gttic(ISAM2EstimateView);
+  // Values and entries are both sorted by key, so walk them in lockstep and
+  // append with an end() hint.
+  Entries::const_iterator prev = previous.entries_.begin();
+  for (Values::const_iterator key_value = theta.begin();
+       key_value != theta.end(); ++key_value) {
+    const Key j = key_value->key;
+    const Vector& d = delta.at(j);
+    while (prev != previous.entries_.end() && prev->first < j) ++prev;
+
+    if (prev != previous.entries_.end() && prev->first == j &&
+        !relinearizedKeys.exists(j) && *prev->second.delta == d) {
+      entries_.insert(entries_.end(), *prev);
+    } else {
+      // retract_ allocates from the Value pool, so release it the same way
+      Entry entry;
+      entry.estimate.reset(key_value->value.retract_(d),
+                           [](const Value* value) { value->deallocate_(); });
+      entry.delta = boost::make_shared<const Vector>(d);
+      entries_.insert(entries_.end(), make_pair(j, entry));
+    }
+  }
+}
+
+/* ************************************************************************* */
+const ISAM2EstimateView::Entry& ISAM2EstimateView::entry(const char* operation,
+                                                         Key j) const {
+  Entries::const_iterator item = entries_.find(j);
+  if (item == entries_.end()) throw ValuesKeyDoesNotExist(operation, j);
+  return item->second;
+}
+
+/* ************************************************************************* */
+const Value& ISAM2EstimateView::at(Key j) const {
+  return *entry("at", j).estimate;
+}
+
+/* ************************************************************************* */
+const Vector& ISAM2EstimateView::delta(Key j) const {
+  return *entry("delta", j).delta;
+}
+
+/* ************************************************************************* */
+KeyVector ISAM2EstimateView::keys() const {
+  KeyVector result;
+  result.reserve(entries_.size());
+  for (const auto& key_entry : entries_) result.push_back(key_entry.first);
+  return result;
+}
+
+/* ************************************************************************* */
+Values ISAM2EstimateView::values() const {
+  Values result;
+  for (const auto& key_entry : entries_)
+    result.insert(key_entry.first, *key_entry.second.estimate);
+  return result;
+}
+
+/* ************************************************************************* */
+VectorValues ISAM2EstimateView::deltas() const {
+  VectorValues result;
+  for (const auto& key_entry : entries_)
+    result.insert(key_entry.first, *key_entry.second.delta);
+  return result;
+}
+
+}  // namespace gtsam
@@ -0,0 +1,121 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    ISAM2EstimateView.h
+ * @brief   Immutable snapshot of the iSAM2 estimate, for concurrent readers.
+ * @date    October 2026
+ */
+
+// \callgraph
+
+#pragma once
+
+#include <gtsam/base/FastMap.h>
+#include <gtsam/linear/VectorValues.h>
+#include <gtsam/nonlinear/Values.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace gtsam {
+
+/**
+ * @addtogroup ISAM2
+ * An immutable snapshot of the ISAM2 estimate, published by ISAM2::update()
+ * when ISAM2Params::publishEstimate is enabled.  Views are never modified after
+ * publication, so any number of threads may read them while ISAM2 continues to
+ * update.  Each view shares the estimate of every variable whose linearization
+ * point and delta did not change with the previous view, so publication only
+ * retracts the variables that moved and readers never copy the whole Values.
+ */
+class GTSAM_EXPORT ISAM2EstimateView {
+ public:
+  typedef boost::shared_ptr<const ISAM2EstimateView> shared_ptr;
+  typedef boost::shared_ptr<const Value> sharedValue;
+  typedef boost::shared_ptr<const Vector> sharedVector;
+
+  /// The estimate and delta of a single variable
+  struct Entry {
+    sharedValue estimate;  ///< Linearization point retracted by delta
+    sharedVector delta;    ///< Delta the estimate was computed from
+  };
+  typedef FastMap<Key, Entry> Entries;
+
+ private:
+  Entries entries_;
+  size_t updateCount_;
+
+ public:
+  /// Create an empty view
+  ISAM2EstimateView() : updateCount_(0) {}
+
+  /**
+   * Create the view following \c previous.  Variables that are not in
+   * \c relinearizedKeys and whose delta is unchanged share their estimate with
+   * \c previous, all others are retracted from \c theta.
+   * @param previous The previously published view
+   * @param theta The current linearization point
+   * @param delta The current delta, must contain every key in \c theta
+   * @param relinearizedKeys Keys whose linearization point changed since
+   * \c previous was published
+   * @param updateCount The ISAM2 update counter this view corresponds to
+   */
+  ISAM2EstimateView(const ISAM2EstimateView& previous, const Values& theta,
+                    const VectorValues& delta, const KeySet& relinearizedKeys,
+                    size_t updateCount);
+
+  /// Number of the ISAM2::update() call that published this view
+  size_t updateCount() const { return updateCount_; }
+
+  /// Number of variables in the view
+  size_t size() const { return entries_.size(); }
+
+  /// Whether the view contains no variables
+  bool empty() const { return entries_.empty(); }
+
+  /// Check whether a variable with the given key exists
+  bool exists(Key j) const { return entries_.find(j) != entries_.end(); }
+
+  /// Access the estimate of a variable as a Value
+  const Value& at(Key j) const;
+
+  /// Access the estimate of a variable, throws ValuesIncorrectType if the
+  /// type does not match
+  template <typename ValueType>
+  const ValueType& at(Key j) const {
+    const Value& value = at(j);
+    try {
+      return dynamic_cast<const GenericValue<ValueType>&>(value).value();
+    } catch (std::bad_cast&) {
+      throw ValuesIncorrectType(j, typeid(value), typeid(ValueType));
+    }
+  }
+
+  /// Access the delta the estimate of a variable was computed from
+  const Vector& delta(Key j) const;
+
+  /// Access the shared estimate and delta of all variables
+  const Entries& entries() const { return entries_; }
+
+  /// Return the keys of all variables, in order
+  KeyVector keys() const;
+
+  /// Copy the estimate into a Values
+  Values values() const;
+
+  /// Copy the deltas into a VectorValues
+  VectorValues deltas() const;
+
+ private:
+  const Entry& entry(const char* operation, Key j) const;
+};
+
+}  // namespace gtsam
@@ -223,6 +223,25 @@ struct GTSAM_EXPORT ISAM2Params {
   /// cost of having to search for slots every time a factor is added.
   bool findUnusedFactorSlots;
 
+  /** Keep the marginal covariances of the keys registered with
+   * ISAM2::trackMarginalCovariances() up to date across updates (default:
+   * false). ISAM2::marginalCovariance() then returns the cached covariance of
+   * a tracked key without any elimination.
+   *
+   * An update re-eliminates the root of every tree it touches, which changes
+   * the marginals of all variables in that tree, so the cost is
+   * O(tracked keys) marginal computations per update. Only tracked keys in
+   * trees the update did not touch keep their cached covariance.
+   */
+  bool cacheMarginalCovariances;
+
+  /** Publish an immutable ISAM2EstimateView after every update (default:
+   * false). Other threads can then read a consistent estimate through
+   * ISAM2::estimateView() while update() runs, at the cost of updating the
+   * delta and retracting the variables that moved on every update.
+   */
+  bool publishEstimate;
+
   /**
    * Specify parameters as constructor arguments
    * See the documentation of member variables above.
@@ -246,7 +265,9 @@ struct GTSAM_EXPORT ISAM2Params {
         keyFormatter(_keyFormatter),
         enableDetailedResults(_enableDetailedResults),
         enablePartialRelinearizationCheck(false),
-        findUnusedFactorSlots(false) {}
+        findUnusedFactorSlots(false),
+        cacheMarginalCovariances(false),
+        publishEstimate(false) {}
 
   /// print iSAM2 parameters
   void print(const std::string& str = "") const {
@@ -288,6 +309,9 @@ struct GTSAM_EXPORT ISAM2Params {
          << enablePartialRelinearizationCheck << "\n";
     cout << "findUnusedFactorSlots:             " << findUnusedFactorSlots
          << "\n";
+    cout << "cacheMarginalCovariances:          " << cacheMarginalCovariances
+         << "\n";
+    cout << "publishEstimate:                   " << publishEstimate << "\n";
     cout.flush();
   }
 
@@ -312,6 +336,8 @@ struct GTSAM_EXPORT ISAM2Params {
   bool isEnablePartialRelinearizationCheck() const {
     return enablePartialRelinearizationCheck;
   }
+  bool isCacheMarginalCovariances() const { return cacheMarginalCovariances; }
+  bool isPublishEstimate() const { return publishEstimate; }
 
   void setOptimizationParams(OptimizationParams optimizationParams) {
     this->optimizationParams = optimizationParams;
@@ -344,6 +370,12 @@ struct GTSAM_EXPORT ISAM2Params {
       bool enablePartialRelinearizationCheck) {
     this->enablePartialRelinearizationCheck = enablePartialRelinearizationCheck;
   }
+  void setCacheMarginalCovariances(bool cacheMarginalCovariances) {
+    this->cacheMarginalCovariances = cacheMarginalCovariances;
+  }
+  void setPublishEstimate(bool publishEstimate) {
+    this->publishEstimate = publishEstimate;
+  }
 
   GaussianFactorGraph::Eliminate getEliminationFunction() const {
     return factorization == CHOLESKY
@@ -75,6 +75,13 @@ struct ISAM2Result {
    */
   size_t variablesRelinearized;
 
+  /** The number of variables that were above the relinearization threshold
+   * but were not relinearized, because the update was limited by
+   * ISAM2UpdateParams::maxRelinearizeKeys.  These are still above the
+   * threshold, so they are checked again on the next relinearization step.
+   */
+  size_t variablesDeferred;
+
   /** The number of variables that were reeliminated as parts of the Bayes'
    * Tree were recalculated, due to new factors.  When loop closures occur,
    * this count will be large as the new loop-closing factors will tend to
@@ -157,7 +164,8 @@ struct ISAM2Result {
    * Detail for information about the results data stored here. */
   boost::optional<DetailedResults> detail;
 
-  explicit ISAM2Result(bool enableDetailedResults = false) {
+  explicit ISAM2Result(bool enableDetailedResults = false)
+      : variablesDeferred(0) {
     if (enableDetailedResults) detail.reset(DetailedResults());
   }
 
@@ -169,11 +177,13 @@ struct ISAM2Result {
     using std::cout;
     cout << str << "  Reelimintated: " << variablesReeliminated
          << "  Relinearized: " << variablesRelinearized
+         << "  Deferred: " << variablesDeferred
          << "  Cliques: " << cliques << std::endl;
   }
 
   /** Getters and Setters */
   size_t getVariablesRelinearized() const { return variablesRelinearized; }
+  size_t getVariablesDeferred() const { return variablesDeferred; }
   size_t getVariablesReeliminated() const { return variablesReeliminated; }
   size_t getCliques() const { return cliques; }
 };
@@ -53,6 +53,16 @@ struct ISAM2UpdateParams {
    * interval (Params::relinearizeSkip). */
   bool force_relinearize{false};
 
+  /** An optional budget on the number of variables relinearized for being
+   * above the relinearization threshold.  When more variables exceed the
+   * threshold, only those with the largest delta relative to the threshold are
+   * relinearized, and the rest are deferred to the following relinearization
+   * steps (see ISAM2Result::variablesDeferred).  This bounds the
+   * relinearization a single update does after a loop closure, at the cost of
+   * a slower convergence.  It does not bound re-elimination: the variables
+   * involved in new factors, and their ancestors, are re-eliminated anyway. */
+  boost::optional<size_t> maxRelinearizeKeys{boost::none};
+
   /** An optional set of new Keys that are now affected by factors,
    * indexed by factor indices (as returned by ISAM2::update()).
    * Use when working with smart factors. For example:
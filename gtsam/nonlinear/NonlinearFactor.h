@@ -22,6 +22,7 @@
 
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/linear/NoiseModel.h>
+#include <gtsam/linear/FixedWhitener.h>
 #include <gtsam/linear/JacobianFactor.h>
 #include <gtsam/inference/Factor.h>
 #include <gtsam/base/OptionalJacobian.h>
@@ -40,6 +41,19 @@ namespace gtsam {
 
 using boost::assign::cref_list_of;
 
+namespace internal {
+/// traits<VALUE>::dimension, or Eigen::Dynamic if the traits do not define it
+template<class VALUE, class = void>
+struct FixedDimension {
+  enum { value = Eigen::Dynamic };
+};
+
+template<class VALUE>
+struct FixedDimension<VALUE, decltype(void(traits<VALUE>::dimension))> {
+  enum { value = traits<VALUE>::dimension };
+};
+} // namespace internal
+
 /* ************************************************************************* */
 
 /**
@@ -241,6 +255,35 @@ public:
    */
   boost::shared_ptr<GaussianFactor> linearize(const Values& x) const;
 
+protected:
+
+  /**
+   * Linearize as above, whitening with a FixedWhitener resolved from
+   * noiseModel_ ahead of time, for factors whose error dimension D is known at
+   * compile time. Models that are not whitened inline use linearize.
+   */
+  template<int D>
+  boost::shared_ptr<GaussianFactor> linearizeWhitened(const Values& x,
+      const noiseModel::FixedWhitener<D>& whitener) const {
+    if (whitener.kind() == noiseModel::FixedWhitener<D>::VIRTUAL)
+      return NoiseModelFactor::linearize(x);
+    if (!active(x))
+      return boost::shared_ptr<JacobianFactor>();
+
+    std::vector<Matrix> A(size());
+    Vector b = -unwhitenedError(x, A);
+    whitener.whitenSystem(A, b);
+
+    std::vector<std::pair<Key, Matrix> > terms(size());
+    for (size_t j = 0; j < size(); ++j) {
+      terms[j].first = keys()[j];
+      terms[j].second.swap(A[j]);
+    }
+    return GaussianFactor::shared_ptr(new JacobianFactor(terms, b));
+  }
+
+public:
+
 #ifdef GTSAM_ALLOW_DEPRECATED_SINCE_V4
   /// @name Deprecated
   /// @{
@@ -64,6 +64,7 @@ struct ConvertToDynamicIf<false> {
  * (needed so that a trace can keep Record pointers) and templating (needed for efficient matrix
  * multiplication). The "hack" is to implement N differently sized reverse AD methods, and select
  * the appropriate version with the dispatch method reverseAD2 below.
+ * Forward AD works the same way, with N differently sized forwardAD methods.
  */
 template<int Cols>
 struct CallRecord {
@@ -98,6 +99,15 @@ struct CallRecord {
     _reverseAD3(dFdT, jacobians);
   }
 
+  // Dispatch the forward AD calls issued by ExecutionTrace::forwardAD1
+  // J is the Jacobian of the value of this record with respect to the N-dimensional
+  // input of the expression, filled in by the _forwardAD3 method of the same size.
+  // Only N = 1..CallRecordMaxVirtualStaticCols and Eigen::Dynamic are supported.
+  template <int N>
+  inline void forwardAD2(Eigen::Matrix<double, Cols, N>& J) const {
+    _forwardAD3(J);
+  }
+
   virtual ~CallRecord() {
   }
 
@@ -123,6 +133,14 @@ private:
       JacobianMap& jacobians) const = 0;
   virtual void _reverseAD3(const Eigen::Matrix<double, 5, Cols> & dFdT,
       JacobianMap& jacobians) const = 0;
+
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, Eigen::Dynamic>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 1>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 2>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 3>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 4>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 5>& J) const = 0;
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 6>& J) const = 0;
 };
 
 /**
@@ -132,6 +150,12 @@ private:
  */
 const int CallRecordMaxVirtualStaticRows = 5;
 
+/**
+ * CallRecordMaxVirtualStaticCols tells for which input dimensions (1..6) there are
+ * separate virtual forwardAD methods with fixed-size Jacobians.
+ */
+const int CallRecordMaxVirtualStaticCols = 6;
+
 /**
  * The CallRecordImplementor implements the CallRecord interface for a Derived class by
  * delegating to its corresponding (templated) non-virtual methods.
@@ -183,6 +207,30 @@ private:
       JacobianMap& jacobians) const {
     derived().reverseAD4(dFdT, jacobians);
   }
+
+  // Called from base class non-virtual inline method forwardAD2
+  // Calls non-virtual function forwardAD4, implemented in Derived (ExpressionNode::Record)
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, Eigen::Dynamic>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 1>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 2>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 3>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 4>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 5>& J) const {
+    derived().forwardAD4(J);
+  }
+  virtual void _forwardAD3(Eigen::Matrix<double, Cols, 6>& J) const {
+    derived().forwardAD4(J);
+  }
 };
 
 } // namespace internal
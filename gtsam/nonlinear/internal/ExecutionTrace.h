@@ -169,6 +169,22 @@ class ExecutionTrace {
       content.ptr->reverseAD2(dTdA, jacobians);
   }
 
+  /**
+   *  *** Forward AD, for expressions with a single key ***
+   * Fill in J, the Jacobian of the value with respect to the key: the identity for
+   * the Leaf, zero for a Constant, or propagated from the leaves by the Record.
+   * J has to be sized already, N is its number of columns, the dimension of the key.
+   */
+  template<int N>
+  void forwardAD1(Eigen::Matrix<double, Dim, N>& J) const {
+    if (kind == Leaf)
+      J.setIdentity();
+    else if (kind == Function)
+      content.ptr->forwardAD2(J);
+    else
+      J.setZero();
+  }
+
   /// Define type so we can apply it as a meta-function
   typedef ExecutionTrace<T> type;
 };
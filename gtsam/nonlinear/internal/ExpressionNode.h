@@ -21,6 +21,8 @@
 
 #include <gtsam/nonlinear/internal/ExecutionTrace.h>
 #include <gtsam/nonlinear/internal/CallRecord.h>
+#include <gtsam/nonlinear/internal/SubexpressionCache.h>
+#include <gtsam/nonlinear/internal/TraceArena.h>
 #include <gtsam/nonlinear/Values.h>
 
 #include <typeinfo>       // operator typeid
@@ -51,6 +53,66 @@ T upAligned(T value, unsigned requiredAlignment = TraceAlignment) {
   return upAlign(value, requiredAlignment);
 }
 
+/// Forward AD into an argument of dimension rows, returns its Jacobian
+template<class A, int N>
+Eigen::Matrix<double, traits<A>::dimension, N> forwardJacobian(
+    const ExecutionTrace<A>& trace, DenseIndex rows, DenseIndex cols) {
+  Eigen::Matrix<double, traits<A>::dimension, N> J;
+  J.resize(rows, cols);
+  trace.forwardAD1(J);
+  return J;
+}
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Record of a shared sub-expression, evaluated once in a SubexpressionCache.
+ * Reverse AD chains the incoming Jacobian with the cached Jacobians.
+ */
+template<class T>
+struct CachedRecord: public CallRecordImplementor<CachedRecord<T>,
+    traits<T>::dimension> {
+
+  const CachedSubexpression<T>* cached;
+
+  explicit CachedRecord(const CachedSubexpression<T>& c) : cached(&c) {}
+
+  /// Print to std::cout
+  void print(const std::string& indent) const {
+    static const Eigen::IOFormat kMatlabFormat(0, 1, " ", "; ", "", "", "[", "]");
+    std::cout << indent << "CachedRecord {" << std::endl;
+    for (size_t i = 0; i < cached->keys.size(); i++)
+      std::cout << indent << "  D(" << cached->keys[i] << ") = "
+                << cached->H.middleCols(cached->offsets[i], cached->dims[i])
+                       .format(kMatlabFormat) << std::endl;
+    std::cout << indent << "}" << std::endl;
+  }
+
+  /// Start the reverse AD process, the cached Jacobians are the result
+  void startReverseAD4(JacobianMap& jacobians) const {
+    for (size_t i = 0; i < cached->keys.size(); i++)
+      jacobians(cached->keys[i]) +=
+          cached->H.middleCols(cached->offsets[i], cached->dims[i]);
+  }
+
+  /// Given df/dT, multiply in the cached dT/dA for every key
+  template<typename MatrixType>
+  void reverseAD4(const MatrixType & dFdT, JacobianMap& jacobians) const {
+    for (size_t i = 0; i < cached->keys.size(); i++)
+      jacobians(cached->keys[i]) +=
+          dFdT * cached->H.middleCols(cached->offsets[i], cached->dims[i]);
+  }
+
+  /// Forward AD: the cached Jacobian is with respect to the single key, if any
+  template<int N>
+  void forwardAD4(Eigen::Matrix<double, traits<T>::dimension, N>& J) const {
+    if (cached->keys.empty())
+      J.setZero();
+    else
+      J = cached->H;
+  }
+};
+
 //-----------------------------------------------------------------------------
 
 /**
@@ -100,6 +162,7 @@ public:
   virtual void dims(std::map<Key, int>& map) const {
   }
 
+
   // Return size needed for memory buffer in traceExecution
   size_t traceSize() const {
     return traceSize_;
@@ -108,9 +171,70 @@ public:
   /// Return value
   virtual T value(const Values& values) const = 0;
 
-  /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  /// Register this node and its shared children in a SubexpressionCache
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+  }
+
+  /**
+   * Construct an execution trace for reverse AD.
+   * If a SubexpressionCache is current on this thread and this node is shared,
+   * the node is evaluated only once, and the trace refers to the cached result.
+   */
+  T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+      ExecutionTraceStorage* traceStorage) const {
+    if (SubexpressionCache* cache = SubexpressionCache::Current())
+      if (CachedSubexpression<T>* cached = cache->find<T>(this))
+        return traceCached(values, trace, traceStorage, *cache, *cached);
+    return _traceExecution(values, trace, traceStorage);
+  }
+
+protected:
+
+  /// Construct an execution trace for reverse AD, implemented by derived nodes
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* traceStorage) const = 0;
+
+private:
+
+  /// Use the cached value and Jacobians, evaluating them on first use
+  T traceCached(const Values& values, ExecutionTrace<T>& trace,
+      ExecutionTraceStorage* ptr, SubexpressionCache& cache,
+      CachedSubexpression<T>& cached) const {
+    std::call_once(cached.evaluated, [&] {
+      evaluateCached(values, cached);
+      cache.countEvaluation();
+    });
+    ++cached.uses;
+    assert(traceSize_ >= sizeof(CachedRecord<T>));
+    trace.setFunction(new (ptr) CachedRecord<T>(cached));
+    return cached.value;
+  }
+
+  /// Evaluate the value and the Jacobians with respect to all keys
+  void evaluateCached(const Values& values, CachedSubexpression<T>& cached) const {
+    std::map<Key, int> map;
+    dims(map);
+    cached.keys.clear();
+    cached.dims.clear();
+    cached.offsets.clear();
+    DenseIndex offset = 0;
+    for (const auto& key_dim : map) {
+      cached.keys.push_back(key_dim.first);
+      cached.dims.push_back(key_dim.second);
+      cached.offsets.push_back(offset);
+      offset += key_dim.second;
+    }
+
+    // Same as Expression::valueAndJacobianMap, but for this node only
+    TraceArena::Allocation traceStorage(traceSize_);
+    ExecutionTrace<T> trace;
+    cached.value = _traceExecution(values, trace, traceStorage.data());
+    VerticalBlockMatrix Ab(cached.dims, traits<T>::GetDimension(cached.value));
+    Ab.matrix().setZero();
+    JacobianMap jacobians(cached.keys, Ab);
+    trace.startReverseAD1(jacobians);
+    cached.H = Ab.range(0, cached.keys.size());
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -145,7 +269,7 @@ public:
   }
 
   /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* traceStorage) const {
     return constant_;
   }
@@ -190,13 +314,14 @@ public:
     map[key_] = traits<T>::dimension;
   }
 
+
   /// Return value
   virtual T value(const Values& values) const {
     return values.at<T>(key_);
   }
 
   /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* traceStorage) const {
     trace.setLeaf(key_);
     return values.at<T>(key_);
@@ -266,6 +391,14 @@ public:
     expression1_->dims(map);
   }
 
+
+  /// Register this node, and its children the first time it is reached
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+    if (cache.addReference<T>(this)) {
+      expression1_->registerSubexpressions(cache);
+    }
+  }
+
   // Inner Record Class
   struct Record: public CallRecordImplementor<Record, traits<T>::dimension> {
 
@@ -302,10 +435,17 @@ public:
     void reverseAD4(const MatrixType & dFdT, JacobianMap& jacobians) const {
       trace1.reverseAD1(dFdT * dTdA1, jacobians);
     }
+
+    /// Forward AD: multiply dT/dA into the Jacobian of the argument
+    template<int N>
+    void forwardAD4(Eigen::Matrix<double, traits<T>::dimension, N>& J) const {
+      J.noalias() = dTdA1 * forwardJacobian<A1, N>(
+          trace1, traits<A1>::GetDimension(value1), J.cols());
+    }
   };
 
   /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
 
@@ -382,6 +522,15 @@ public:
     expression2_->dims(map);
   }
 
+
+  /// Register this node, and its children the first time it is reached
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+    if (cache.addReference<T>(this)) {
+      expression1_->registerSubexpressions(cache);
+      expression2_->registerSubexpressions(cache);
+    }
+  }
+
   // Inner Record Class
   struct Record: public CallRecordImplementor<Record, traits<T>::dimension> {
 
@@ -421,10 +570,19 @@ public:
       trace1.reverseAD1(dFdT * dTdA1, jacobians);
       trace2.reverseAD1(dFdT * dTdA2, jacobians);
     }
+
+    /// Forward AD: sum dT/dA times the Jacobian of every argument
+    template<int N>
+    void forwardAD4(Eigen::Matrix<double, traits<T>::dimension, N>& J) const {
+      J.noalias() = dTdA1 * forwardJacobian<A1, N>(
+          trace1, traits<A1>::GetDimension(value1), J.cols());
+      J.noalias() += dTdA2 * forwardJacobian<A2, N>(
+          trace2, traits<A2>::GetDimension(value2), J.cols());
+    }
   };
 
   /// Construct an execution trace for reverse AD, see UnaryExpression for explanation
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
       ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record(values, *expression1_, *expression2_, ptr);
@@ -493,6 +651,16 @@ public:
     expression3_->dims(map);
   }
 
+
+  /// Register this node, and its children the first time it is reached
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+    if (cache.addReference<T>(this)) {
+      expression1_->registerSubexpressions(cache);
+      expression2_->registerSubexpressions(cache);
+      expression3_->registerSubexpressions(cache);
+    }
+  }
+
   // Inner Record Class
   struct Record: public CallRecordImplementor<Record, traits<T>::dimension> {
 
@@ -539,10 +707,21 @@ public:
       trace2.reverseAD1(dFdT * dTdA2, jacobians);
       trace3.reverseAD1(dFdT * dTdA3, jacobians);
     }
+
+    /// Forward AD: sum dT/dA times the Jacobian of every argument
+    template<int N>
+    void forwardAD4(Eigen::Matrix<double, traits<T>::dimension, N>& J) const {
+      J.noalias() = dTdA1 * forwardJacobian<A1, N>(
+          trace1, traits<A1>::GetDimension(value1), J.cols());
+      J.noalias() += dTdA2 * forwardJacobian<A2, N>(
+          trace2, traits<A2>::GetDimension(value2), J.cols());
+      J.noalias() += dTdA3 * forwardJacobian<A3, N>(
+          trace3, traits<A3>::GetDimension(value3), J.cols());
+    }
   };
 
   /// Construct an execution trace for reverse AD, see UnaryExpression for explanation
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
                            ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record(values, *expression1_, *expression2_, *expression3_, ptr);
@@ -592,6 +771,14 @@ class ScalarMultiplyNode : public ExpressionNode<T> {
     expression_->dims(map);
   }
 
+
+  /// Register this node, and its children the first time it is reached
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+    if (cache.addReference<T>(this)) {
+      expression_->registerSubexpressions(cache);
+    }
+  }
+
   // Inner Record Class
   struct Record : public CallRecordImplementor<Record, traits<T>::dimension> {
     static const int Dim = traits<T>::dimension;
@@ -619,10 +806,17 @@ class ScalarMultiplyNode : public ExpressionNode<T> {
     void reverseAD4(const MatrixType& dFdT, JacobianMap& jacobians) const {
       trace.reverseAD1(dFdT * scalar_dTdA, jacobians);
     }
+
+    /// Forward AD: scale the Jacobian of the argument
+    template<int N>
+    void forwardAD4(Eigen::Matrix<double, Dim, N>& J) const {
+      trace.forwardAD1(J);
+      J *= scalar_dTdA;
+    }
   };
 
   /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
                            ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record();
@@ -685,6 +879,15 @@ class BinarySumNode : public ExpressionNode<T> {
     expression2_->dims(map);
   }
 
+
+  /// Register this node, and its children the first time it is reached
+  virtual void registerSubexpressions(SubexpressionCache& cache) const {
+    if (cache.addReference<T>(this)) {
+      expression1_->registerSubexpressions(cache);
+      expression2_->registerSubexpressions(cache);
+    }
+  }
+
   // Inner Record Class
   struct Record : public CallRecordImplementor<Record, traits<T>::dimension> {
     ExecutionTrace<T> trace1;
@@ -712,10 +915,17 @@ class BinarySumNode : public ExpressionNode<T> {
       trace1.reverseAD1(dFdT, jacobians);
       trace2.reverseAD1(dFdT, jacobians);
     }
+
+    /// Forward AD: add the Jacobians of both terms
+    template<int N>
+    void forwardAD4(Eigen::Matrix<double, traits<T>::dimension, N>& J) const {
+      trace1.forwardAD1(J);
+      J += forwardJacobian<T, N>(trace2, J.rows(), J.cols());
+    }
   };
 
   /// Construct an execution trace for reverse AD
-  virtual T traceExecution(const Values& values, ExecutionTrace<T>& trace,
+  virtual T _traceExecution(const Values& values, ExecutionTrace<T>& trace,
                            ExecutionTraceStorage* ptr) const {
     assert(reinterpret_cast<size_t>(ptr) % TraceAlignment == 0);
     Record* record = new (ptr) Record();
@@ -0,0 +1,159 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SubexpressionCache.h
+ * @date October 2026
+ * @brief Cache of sub-expressions shared by several expressions
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/base/FastVector.h>
+#include <gtsam/base/Manifold.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace gtsam {
+namespace internal {
+
+template<class T> struct CachedSubexpression;
+
+/**
+ * A SubexpressionCache holds the value and Jacobians of the sub-expressions
+ * that appear more than once in a set of expressions, for example a
+ * transformFrom(pose, ...) used by several factors. It is used in two phases:
+ *  - register the expression trees with ExpressionNode::registerSubexpressions.
+ *    Expression nodes are hash-consed on their address, i.e., every node that
+ *    is reached from more than one parent gets one entry, and its children are
+ *    only visited once. Unshared nodes are dropped by removeUnshared().
+ *  - while a Scope is active on a thread, ExpressionNode::traceExecution
+ *    evaluates a shared node once, with its Jacobians with respect to its
+ *    keys, and every further use chains these Jacobians in reverse AD.
+ * Entries are filled in concurrently, but must all be registered before.
+ * A cache is only valid for a single linearization point.
+ */
+class SubexpressionCache {
+public:
+
+  /// Type-erased entry, see CachedSubexpression<T>
+  struct Entry {
+    std::once_flag evaluated;    ///< value and Jacobians computed
+    std::atomic<size_t> uses;    ///< number of times the result was used
+    size_t references;           ///< number of parents of the node
+    Entry() : uses(0), references(1) {}
+    virtual ~Entry() {}
+  };
+
+private:
+
+  std::unordered_map<const void*, std::unique_ptr<Entry> > entries_;
+  std::atomic<size_t> evaluations_;
+
+public:
+
+  SubexpressionCache() : evaluations_(0) {}
+
+  /**
+   * Register a reference to an expression node, of value type T.
+   * @return true if this is the first reference, and the children of the node
+   * should be registered as well.
+   */
+  template<class T>
+  bool addReference(const void* node);
+
+  /// Drop the entries of nodes that are referenced only once
+  void removeUnshared() {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->second->references < 2)
+        it = entries_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+  /// Return the entry for a node, or nullptr if the node is not shared
+  template<class T>
+  CachedSubexpression<T>* find(const void* node) const;
+
+  /// Count one evaluation of a shared node
+  void countEvaluation() { ++evaluations_; }
+
+  /// Number of shared sub-expressions
+  size_t size() const { return entries_.size(); }
+
+  /// Number of shared sub-expressions that were evaluated
+  size_t evaluations() const { return evaluations_; }
+
+  /// Number of times a cached result was used, including the first time
+  size_t uses() const {
+    size_t total = 0;
+    for (const auto& entry : entries_) total += entry.second->uses;
+    return total;
+  }
+
+  /// The cache used by expressions evaluated on this thread, or nullptr
+  static SubexpressionCache*& Current() {
+    static thread_local SubexpressionCache* current = nullptr;
+    return current;
+  }
+
+  /// Make a cache current on this thread during the lifetime of the Scope
+  class Scope {
+    SubexpressionCache* previous_;
+  public:
+    explicit Scope(SubexpressionCache* cache) : previous_(Current()) {
+      Current() = cache;
+    }
+    ~Scope() { Current() = previous_; }
+  };
+};
+
+/**
+ * Value and Jacobians of a shared sub-expression of value type T, with respect
+ * to all the keys of the sub-expression.
+ */
+template<class T>
+struct CachedSubexpression: public SubexpressionCache::Entry {
+  static const int Dim = traits<T>::dimension;
+  T value;
+  KeyVector keys;
+  FastVector<int> dims;
+  FastVector<DenseIndex> offsets;  ///< first column of each key in H
+  Eigen::Matrix<double, Dim, Eigen::Dynamic> H;
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+template<class T>
+bool SubexpressionCache::addReference(const void* node) {
+  std::unique_ptr<Entry>& entry = entries_[node];
+  if (entry) {
+    ++entry->references;
+    return false;
+  }
+  entry.reset(new CachedSubexpression<T>());
+  return true;
+}
+
+template<class T>
+CachedSubexpression<T>* SubexpressionCache::find(const void* node) const {
+  if (entries_.empty()) return nullptr;
+  auto it = entries_.find(node);
+  if (it == entries_.end()) return nullptr;
+  return static_cast<CachedSubexpression<T>*>(it->second.get());
+}
+
+} // namespace internal
+} // namespace gtsam
@@ -0,0 +1,140 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file TraceArena.h
+ * @date October 2026
+ * @brief Thread-local memory for expression execution traces
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/internal/ExecutionTrace.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace gtsam {
+namespace internal {
+
+/**
+ * A TraceArena hands out aligned ExecutionTraceStorage for expression
+ * evaluation. Memory is allocated on the heap in blocks that are kept for the
+ * lifetime of the arena, so after warm-up evaluation does not allocate, and
+ * deep expressions do not need large stacks (as a variable length array does).
+ *
+ * Allocations are released in reverse order, by Allocation going out of scope,
+ * which allows nested evaluations (see SubexpressionCache). Blocks are never
+ * moved, so earlier allocations stay valid when the arena grows.
+ */
+class TraceArena {
+
+  struct Block {
+    void* memory;                  ///< as returned by malloc
+    ExecutionTraceStorage* data;   ///< aligned start of the block
+    size_t capacity, used;         ///< in units of ExecutionTraceStorage
+  };
+
+  std::vector<Block> blocks_;
+  size_t current_;  ///< index of the block allocations are taken from
+
+  enum { kMinimumBlockSize = 1024 };
+
+  TraceArena() : current_(0) {}
+  TraceArena(const TraceArena&) = delete;
+  TraceArena& operator=(const TraceArena&) = delete;
+
+  /// Find (or add) a block with room for n elements, from current_ onwards
+  Block& reserve(size_t n) {
+    while (current_ < blocks_.size()) {
+      Block& block = blocks_[current_];
+      if (block.capacity - block.used >= n) return block;
+      if (block.used == 0) {
+        // An unused block that is too small can be replaced
+        std::free(block.memory);
+        blocks_.erase(blocks_.begin() + current_);
+        continue;
+      }
+      ++current_;
+    }
+    size_t capacity = std::max(n, size_t(kMinimumBlockSize));
+    if (!blocks_.empty())
+      capacity = std::max(capacity, 2 * blocks_.back().capacity);
+    Block block;
+    block.memory = std::malloc(capacity * sizeof(ExecutionTraceStorage) +
+                               TraceAlignment);
+    if (!block.memory) throw std::bad_alloc();
+    size_t address = reinterpret_cast<size_t>(block.memory);
+    address += TraceAlignment - address % TraceAlignment;
+    block.data = reinterpret_cast<ExecutionTraceStorage*>(address);
+    block.capacity = capacity;
+    block.used = 0;
+    blocks_.push_back(block);
+    current_ = blocks_.size() - 1;
+    return blocks_.back();
+  }
+
+public:
+
+  ~TraceArena() {
+    for (const Block& block : blocks_) std::free(block.memory);
+  }
+
+  /// The arena of the calling thread
+  static TraceArena& ThreadLocal() {
+    static thread_local TraceArena arena;
+    return arena;
+  }
+
+  /// Total capacity of the arena, in units of ExecutionTraceStorage
+  size_t capacity() const {
+    size_t total = 0;
+    for (const Block& block : blocks_) total += block.capacity;
+    return total;
+  }
+
+  /**
+   * Storage for one execution trace, of traceSize() elements, taken from the
+   * arena of the calling thread and released on destruction.
+   */
+  class Allocation {
+    TraceArena& arena_;
+    size_t previous_, block_, mark_;
+    ExecutionTraceStorage* data_;
+
+  public:
+    explicit Allocation(size_t n, TraceArena& arena = ThreadLocal())
+        : arena_(arena), previous_(arena.current_) {
+      // Allocate at least one element so nested allocations differ
+      Block& block = arena_.reserve(std::max<size_t>(n, 1));
+      block_ = arena_.current_;
+      mark_ = block.used;
+      data_ = block.data + block.used;
+      block.used += std::max<size_t>(n, 1);
+    }
+
+    ~Allocation() {
+      arena_.blocks_[block_].used = mark_;
+      arena_.current_ = previous_;
+    }
+
+    Allocation(const Allocation&) = delete;
+    Allocation& operator=(const Allocation&) = delete;
+
+    /// The aligned storage
+    ExecutionTraceStorage* data() const { return data_; }
+  };
+};
+
+} // namespace internal
+} // namespace gtsam
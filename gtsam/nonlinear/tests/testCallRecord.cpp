@@ -93,6 +93,13 @@ struct Record: public internal::CallRecordImplementor<Record, Cols> {
     cc.runTimeRows = dFdT.rows();
     cc.runTimeCols = dFdT.cols();
   }
+  template<int N>
+  void forwardAD4(Eigen::Matrix<double, Cols, N>& J) const {
+    cc.compTimeRows = Cols;
+    cc.compTimeCols = N;
+    cc.runTimeRows = J.rows();
+    cc.runTimeCols = J.cols();
+  }
 
   template<typename Derived, int Rows>
   friend struct internal::CallRecordImplementor;
@@ -161,6 +168,20 @@ TEST(CallRecord, virtualReverseAdDispatching) {
   }
 }
 
+/* ************************************************************************* */
+TEST(CallRecord, virtualForwardAdDispatching) {
+  Record record;
+  Eigen::Matrix<double, Cols, 1> J1;
+  record.CallRecord::forwardAD2(J1);
+  EXPECT((assert_equal(record.cc, CallConfig(Cols, 1))));
+  Eigen::Matrix<double, Cols, 6> J6;
+  record.CallRecord::forwardAD2(J6);
+  EXPECT((assert_equal(record.cc, CallConfig(Cols, 6))));
+  Eigen::Matrix<double, Cols, Eigen::Dynamic> JD(Cols, 7);
+  record.CallRecord::forwardAD2(JD);
+  EXPECT((assert_equal(record.cc, CallConfig(Cols, Eigen::Dynamic, Cols, 7))));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -17,6 +17,7 @@
  */
 
 #include <gtsam/nonlinear/internal/ExecutionTrace.h>
+#include <gtsam/nonlinear/internal/TraceArena.h>
 #include <gtsam/geometry/Point2.h>
 
 #include <CppUnitLite/TestHarness.h>
@@ -30,6 +31,38 @@ TEST(ExecutionTrace, construct) {
   internal::ExecutionTrace<Point2> trace;
 }
 
+/* ************************************************************************* */
+// Nested allocations are aligned, distinct, and survive growth of the arena
+TEST(TraceArena, nested) {
+  using internal::TraceArena;
+  TraceArena& arena = TraceArena::ThreadLocal();
+  internal::ExecutionTraceStorage* first;
+  {
+    TraceArena::Allocation a(10);
+    first = a.data();
+    EXPECT_LONGS_EQUAL(0, reinterpret_cast<size_t>(a.data()) %
+                              internal::TraceAlignment);
+    a.data()[9] = internal::ExecutionTraceStorage();
+    {
+      TraceArena::Allocation b(arena.capacity() + 1);
+      EXPECT(b.data() != a.data());
+      EXPECT(b.data() + arena.capacity() <= a.data() ||
+             b.data() >= a.data() + 10);
+      EXPECT_LONGS_EQUAL(0, reinterpret_cast<size_t>(b.data()) %
+                                internal::TraceAlignment);
+      TraceArena::Allocation c(1);
+      EXPECT(c.data() != b.data());
+    }
+    TraceArena::Allocation d(1);
+    EXPECT(d.data() == a.data() + 10);
+  }
+  // Released memory is reused, nothing is allocated
+  const size_t capacity = arena.capacity();
+  TraceArena::Allocation e(10);
+  EXPECT(e.data() == first);
+  EXPECT_LONGS_EQUAL(capacity, arena.capacity());
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -46,6 +46,11 @@ namespace gtsam {
 
     VALUE measured_; /** The measurement */
 
+    /// noiseModel_, resolved once for the dimension of VALUE
+    typedef noiseModel::FixedWhitener<internal::FixedDimension<VALUE>::value>
+        Whitener;
+    Whitener whitener_;
+
   public:
 
     // shorthand for a smart pointer to a factor
@@ -57,7 +62,7 @@ namespace gtsam {
     /** Constructor */
     BetweenFactor(Key key1, Key key2, const VALUE& measured,
         const SharedNoiseModel& model = nullptr) :
-      Base(model, key1, key2), measured_(measured) {
+      Base(model, key1, key2), measured_(measured), whitener_(model) {
     }
 
     virtual ~BetweenFactor() {}
@@ -102,6 +107,11 @@ namespace gtsam {
 #endif
     }
 
+    /// linearize, whitening without virtual calls on the noise model
+    virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+      return this->linearizeWhitened(x, whitener_);
+    }
+
     /** return the measured */
     const VALUE& measured() const {
       return measured_;
@@ -121,6 +131,8 @@ namespace gtsam {
       ar & boost::serialization::make_nvp("NoiseModelFactor2",
           boost::serialization::base_object<Base>(*this));
       ar & BOOST_SERIALIZATION_NVP(measured_);
+      if (ARCHIVE::is_loading::value)
+        whitener_ = Whitener(this->noiseModel_);
     }
 
 	  // Alignment, see https://eigen.tuxfamily.org/dox/group__TopicStructHavingEigenMembers.html
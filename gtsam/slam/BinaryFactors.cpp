@@ -0,0 +1,46 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinaryFactors.cpp
+ * @date October 2026
+ * @brief Registration of the common SLAM factors with BinaryRegistry
+ */
+
+#include <gtsam/slam/BinaryFactors.h>
+
+namespace gtsam {
+namespace internal {
+
+/* ************************************************************************* */
+template<class VALUE>
+static void registerPriorAndBetween(BinaryRegistry& registry,
+                                    const std::string& name) {
+  registry.registerFactor<PriorFactor<VALUE> >("PriorFactor<" + name + ">");
+  registry.registerFactor<BetweenFactor<VALUE> >("BetweenFactor<" + name + ">");
+}
+
+/* ************************************************************************* */
+void registerSlamFactors(BinaryRegistry& registry) {
+  registerPriorAndBetween<double>(registry, "double");
+  registry.registerFactor<PriorFactor<Vector> >("PriorFactor<Vector>");
+  registerPriorAndBetween<Point2>(registry, "Point2");
+  registerPriorAndBetween<Point3>(registry, "Point3");
+  registerPriorAndBetween<Rot2>(registry, "Rot2");
+  registerPriorAndBetween<Rot3>(registry, "Rot3");
+  registerPriorAndBetween<Pose2>(registry, "Pose2");
+  registerPriorAndBetween<Pose3>(registry, "Pose3");
+  registry.registerFactor<BearingRangeFactor<Pose2, Point2> >(
+      "BearingRangeFactor<Pose2,Point2>");
+}
+
+} // namespace internal
+} // namespace gtsam
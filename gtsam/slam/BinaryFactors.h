@@ -0,0 +1,82 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BinaryFactors.h
+ * @date October 2026
+ * @brief Binary format of the common SLAM factors, see BinarySerialization.h
+ */
+
+#pragma once
+
+#include <gtsam/nonlinear/BinarySerialization.h>
+#include <gtsam/sam/BearingRangeFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/PriorFactor.h>
+
+#include <boost/make_shared.hpp>
+
+namespace gtsam {
+
+/// PriorFactor as key, prior and noise model
+template<class VALUE>
+struct BinaryCodec<PriorFactor<VALUE> > {
+  static void write(BinaryOutArchive& ar, const PriorFactor<VALUE>& factor) {
+    ar.write(factor.key());
+    BinaryCodec<VALUE>::write(ar, factor.prior());
+    writeNoiseModel(ar, factor.noiseModel());
+  }
+  static boost::shared_ptr<PriorFactor<VALUE> > read(BinaryInArchive& ar) {
+    const Key key = ar.read<Key>();
+    const VALUE prior = BinaryCodec<VALUE>::read(ar);
+    return boost::make_shared<PriorFactor<VALUE> >(key, prior,
+                                                   readNoiseModel(ar));
+  }
+};
+
+/// BetweenFactor as keys, measurement and noise model
+template<class VALUE>
+struct BinaryCodec<BetweenFactor<VALUE> > {
+  static void write(BinaryOutArchive& ar, const BetweenFactor<VALUE>& factor) {
+    ar.write(factor.key1());
+    ar.write(factor.key2());
+    BinaryCodec<VALUE>::write(ar, factor.measured());
+    writeNoiseModel(ar, factor.noiseModel());
+  }
+  static boost::shared_ptr<BetweenFactor<VALUE> > read(BinaryInArchive& ar) {
+    const Key key1 = ar.read<Key>(), key2 = ar.read<Key>();
+    const VALUE measured = BinaryCodec<VALUE>::read(ar);
+    return boost::make_shared<BetweenFactor<VALUE> >(key1, key2, measured,
+                                                     readNoiseModel(ar));
+  }
+};
+
+/// BearingRangeFactor<Pose2, Point2> as keys, bearing, range and noise model
+template<>
+struct BinaryCodec<BearingRangeFactor<Pose2, Point2> > {
+  typedef BearingRangeFactor<Pose2, Point2> Factor;
+  static void write(BinaryOutArchive& ar, const Factor& factor) {
+    ar.write(factor.keys()[0]);
+    ar.write(factor.keys()[1]);
+    BinaryCodec<Rot2>::write(ar, factor.measured().bearing());
+    ar.write(factor.measured().range());
+    writeNoiseModel(ar, factor.noiseModel());
+  }
+  static boost::shared_ptr<Factor> read(BinaryInArchive& ar) {
+    const Key key1 = ar.read<Key>(), key2 = ar.read<Key>();
+    const Rot2 bearing = BinaryCodec<Rot2>::read(ar);
+    const double range = ar.read<double>();
+    return boost::make_shared<Factor>(key1, key2, bearing, range,
+                                      readNoiseModel(ar));
+  }
+};
+
+} // namespace gtsam
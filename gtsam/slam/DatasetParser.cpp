@@ -0,0 +1,399 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DatasetParser.cpp
+ * @date October 2026
+ * @brief Fast parsing of g2o, TORO and BAL files, used by the dataset readers
+ */
+
+#include <gtsam/slam/DatasetParser.h>
+#include <gtsam/config.h>  // for GTSAM_USE_TBB
+
+#include <boost/make_shared.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef GTSAM_USE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
+using namespace std;
+
+namespace gtsam {
+
+namespace {
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// Skip whitespace, but not past the end of the line
+inline void skipBlanks(const char*& p, const char* end) {
+  while (p != end && *p != '\n' && isSpace(*p)) ++p;
+}
+
+/// Skip all whitespace, including line ends
+inline void skipSpaces(const char*& p, const char* end) {
+  while (p != end && isSpace(*p)) ++p;
+}
+
+/// End of the token starting at p
+inline const char* tokenEnd(const char* p, const char* end) {
+  while (p != end && !isSpace(*p)) ++p;
+  return p;
+}
+
+/// Run f(i) for i in [0, n), in parallel if GTSAM is built with TBB
+template <class FUNCTION>
+void forEachChunk(size_t n, const FUNCTION& f) {
+#ifdef GTSAM_USE_TBB
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, n),
+                    [&](const tbb::blocked_range<size_t>& range) {
+                      for (size_t i = range.begin(); i != range.end(); ++i)
+                        f(i);
+                    });
+#else
+  for (size_t i = 0; i < n; ++i) f(i);
+#endif
+}
+
+/// Split [begin, end) into pieces of about chunkSize bytes, at line ends
+vector<const char*> splitLines(const char* begin, const char* end,
+                               size_t chunkSize) {
+  vector<const char*> boundaries(1, begin);
+  const char* p = begin;
+  while (static_cast<size_t>(end - p) > chunkSize) {
+    const char* eol =
+        static_cast<const char*>(memchr(p + chunkSize, '\n',
+                                        end - p - chunkSize));
+    if (!eol) break;
+    p = eol + 1;
+    boundaries.push_back(p);
+  }
+  if (boundaries.back() != end) boundaries.push_back(end);
+  return boundaries;
+}
+
+/// A decimal number split into an integer mantissa and a power of ten
+struct Decimal {
+  uint64_t mantissa;
+  int exponent;
+  bool negative;
+};
+
+/**
+ * Scan a decimal number with at most 19 significant digits, which ends at
+ * whitespace or end. Returns false for anything else, which is then left to
+ * the C library.
+ */
+bool scanDecimal(const char* p, const char* end, Decimal* d) {
+  d->negative = false;
+  if (p != end && (*p == '-' || *p == '+')) d->negative = *p++ == '-';
+  d->mantissa = 0;
+  d->exponent = 0;
+  int digits = 0;
+  bool any = false;
+  for (; p != end && isDigit(*p); ++p, any = true) {
+    if (d->mantissa == 0 && *p == '0') continue;
+    if (++digits > 19) return false;
+    d->mantissa = d->mantissa * 10 + (*p - '0');
+  }
+  if (p != end && *p == '.') {
+    for (++p; p != end && isDigit(*p); ++p, any = true) {
+      --d->exponent;
+      if (d->mantissa == 0 && *p == '0') continue;
+      if (++digits > 19) return false;
+      d->mantissa = d->mantissa * 10 + (*p - '0');
+    }
+  }
+  if (!any) return false;
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+    if (p == end || !isDigit(*p)) return false;
+    int exponent = 0;
+    for (; p != end && isDigit(*p); ++p)
+      if (exponent < 10000) exponent = exponent * 10 + (*p - '0');
+    d->exponent += negative ? -exponent : exponent;
+  }
+  return p == end || isSpace(*p);
+}
+
+const double kPowersOf10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                              1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                              1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * Convert a decimal to the nearest double when that takes a single rounding:
+ * mantissa and power of ten are both exact in double precision.
+ */
+bool exactDouble(const Decimal& d, double* x) {
+  if (d.mantissa > (uint64_t(1) << 53) || d.exponent < -22 || d.exponent > 22)
+    return false;
+  double value = static_cast<double>(d.mantissa);
+  if (d.exponent < 0)
+    value /= kPowersOf10[-d.exponent];
+  else
+    value *= kPowersOf10[d.exponent];
+  *x = d.negative ? -value : value;
+  return true;
+}
+
+/// Parse the token [p, end) with strtod or strtof
+template <typename T>
+bool parseWithLibrary(const char* p, const char* end, T* x) {
+  const string token(p, end);
+  char* last;
+  *x = sizeof(T) == sizeof(float) ? strtof(token.c_str(), &last)
+                                  : strtod(token.c_str(), &last);
+  return last == token.c_str() + token.size() && !token.empty();
+}
+
+/// Parse the numbers of the lines in [begin, end) into chunk
+void parseLines(const char* begin, const char* end, DatasetChunk* chunk) {
+  chunk->records.clear();
+  chunk->numbers.clear();
+  for (const char* p = begin; p != end;) {
+    const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (!eol) eol = end;
+    skipBlanks(p, eol);
+    const char* tagEnd = tokenEnd(p, eol);
+    const string tag(p, tagEnd);
+    p = tagEnd;
+
+    DatasetRecord record;
+    size_t nrKeys = 2, nrNumbers;
+    if (tag == "VERTEX2" || tag == "VERTEX_SE2" || tag == "VERTEX") {
+      record.type = DATASET_VERTEX_SE2;
+      nrKeys = 1;
+      nrNumbers = 3;
+    } else if (tag == "EDGE2" || tag == "EDGE" || tag == "EDGE_SE2" ||
+               tag == "ODOMETRY") {
+      record.type = DATASET_EDGE_SE2;
+      nrNumbers = 9;
+    } else if (tag == "BR") {
+      record.type = DATASET_BEARING_RANGE;
+      nrNumbers = 4;
+    } else if (tag == "LANDMARK") {
+      record.type = DATASET_LANDMARK;
+      nrNumbers = 5;
+    } else if (tag == "VERTEX3") {
+      record.type = DATASET_VERTEX3;
+      nrKeys = 1;
+      nrNumbers = 6;
+    } else if (tag == "VERTEX_SE3:QUAT") {
+      record.type = DATASET_VERTEX_SE3_QUAT;
+      nrKeys = 1;
+      nrNumbers = 7;
+    } else if (tag == "EDGE3") {
+      record.type = DATASET_EDGE3;
+      nrNumbers = 27;
+    } else if (tag == "EDGE_SE3:QUAT") {
+      record.type = DATASET_EDGE_SE3_QUAT;
+      nrNumbers = 28;
+    } else {
+      p = eol == end ? end : eol + 1;
+      continue;
+    }
+
+    uint64_t keys[2] = {0, 0};
+    for (size_t k = 0; k < nrKeys; ++k) {
+      skipBlanks(p, eol);
+      if (!internal::parseUnsigned(p, eol, &keys[k]))
+        throw runtime_error("DatasetParser: invalid id in " + tag + " line");
+    }
+    record.key1 = keys[0];
+    record.key2 = keys[1];
+    record.offset = chunk->numbers.size();
+    chunk->numbers.resize(record.offset + nrNumbers);
+    for (size_t k = 0; k < nrNumbers; ++k) {
+      skipBlanks(p, eol);
+      if (!internal::parseDouble(p, eol,
+                                 &chunk->numbers[record.offset + k]))
+        throw runtime_error("DatasetParser: invalid number in " + tag +
+                            " line");
+    }
+    chunk->records.push_back(record);
+    p = eol == end ? end : eol + 1;
+  }
+}
+
+/// Count the whitespace separated tokens in [p, end)
+size_t countTokens(const char* p, const char* end) {
+  size_t n = 0;
+  for (skipSpaces(p, end); p != end; skipSpaces(p, end)) {
+    p = tokenEnd(p, end);
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+namespace internal {
+
+bool parseDouble(const char*& p, const char* end, double* x) {
+  const char* last = tokenEnd(p, end);
+  Decimal d;
+  if (!(scanDecimal(p, last, &d) && exactDouble(d, x)) &&
+      !parseWithLibrary(p, last, x))
+    return false;
+  p = last;
+  return true;
+}
+
+bool parseFloat(const char*& p, const char* end, float* x) {
+  const char* last = tokenEnd(p, end);
+  Decimal d;
+  double value;
+  if (scanDecimal(p, last, &d) && exactDouble(d, &value)) {
+    // Rounding the correctly rounded double to float again only differs from
+    // rounding the decimal once if the double falls on the midpoint between
+    // two floats, or if the float is subnormal or out of range.
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint64_t lowBits = bits & ((uint64_t(1) << 29) - 1);
+    const double magnitude = std::abs(value);
+    if (lowBits != (uint64_t(1) << 28) &&
+        (magnitude == 0.0 || (magnitude >= FLT_MIN && magnitude <= FLT_MAX))) {
+      *x = static_cast<float>(value);
+      p = last;
+      return true;
+    }
+  }
+  if (!parseWithLibrary(p, last, x)) return false;
+  p = last;
+  return true;
+}
+
+bool parseUnsigned(const char*& p, const char* end, uint64_t* x) {
+  const char* q = p;
+  bool negative = false;
+  if (q != end && (*q == '-' || *q == '+')) negative = *q++ == '-';
+  if (q == end || !isDigit(*q)) return false;
+  uint64_t value = 0;
+  for (; q != end && isDigit(*q); ++q) {
+    const uint64_t digit = *q - '0';
+    if (value > (UINT64_MAX - digit) / 10) return false;
+    value = value * 10 + digit;
+  }
+  if (q != end && !isSpace(*q)) return false;
+  *x = negative ? uint64_t(0) - value : value;
+  p = q;
+  return true;
+}
+
+}  // namespace internal
+
+/* ************************************************************************* */
+DatasetParser::DatasetParser(const string& filename, size_t chunkSize)
+    : filename_(filename), file_(boost::make_shared<MappedFile>(filename)) {
+  boundaries_ = splitLines(file_->data(), file_->end(), chunkSize);
+}
+
+/* ************************************************************************* */
+void DatasetParser::parseChunk(size_t i, DatasetChunk* chunk) const {
+  try {
+    parseLines(boundaries_[i], boundaries_[i + 1], chunk);
+  } catch (const runtime_error& e) {
+    throw runtime_error(string(e.what()) + " of " + filename_);
+  }
+}
+
+/* ************************************************************************* */
+vector<DatasetChunk> DatasetParser::parseAll() const {
+  vector<DatasetChunk> chunks(nrChunks());
+  forEachChunk(nrChunks(), [&](size_t i) { parseChunk(i, &chunks[i]); });
+  return chunks;
+}
+
+/* ************************************************************************* */
+BALContents parseBAL(const string& filename, size_t chunkSize) {
+  const MappedFile file(filename);
+  const char* p = file.data();
+  const char* end = file.end();
+
+  // The header: number of cameras, points and observations
+  uint64_t header[3];
+  for (uint64_t& n : header) {
+    skipSpaces(p, end);
+    if (!internal::parseUnsigned(p, end, &n))
+      throw runtime_error("parseBAL: invalid header in " + filename);
+  }
+  BALContents bal;
+  bal.nrCameras = header[0];
+  bal.nrPoints = header[1];
+  const size_t nrObservations = header[2];
+  const size_t nrObservationTokens = 4 * nrObservations;
+  const size_t nrParameters = 9 * bal.nrCameras + 3 * bal.nrPoints;
+  bal.cameraIndices.resize(nrObservations);
+  bal.pointIndices.resize(nrObservations);
+  bal.uv.resize(2 * nrObservations);
+  bal.parameters.resize(nrParameters);
+
+  // Count the tokens in each chunk to know where its numbers go
+  const vector<const char*> boundaries = splitLines(p, end, chunkSize);
+  const size_t nrChunks = boundaries.size() - 1;
+  vector<size_t> first(nrChunks + 1, 0);
+  forEachChunk(nrChunks, [&](size_t i) {
+    first[i + 1] = countTokens(boundaries[i], boundaries[i + 1]);
+  });
+  for (size_t i = 0; i < nrChunks; ++i) first[i + 1] += first[i];
+  if (first[nrChunks] != nrObservationTokens + nrParameters)
+    throw runtime_error("parseBAL: wrong number of values in " + filename);
+
+  forEachChunk(nrChunks, [&](size_t i) {
+    const char* q = boundaries[i];
+    const char* last = boundaries[i + 1];
+    bool valid = true;
+    for (size_t t = first[i]; t < first[i + 1] && valid; ++t) {
+      skipSpaces(q, last);
+      if (t < nrObservationTokens) {
+        const size_t k = t / 4;
+        switch (t % 4) {
+          case 0:
+            valid = internal::parseUnsigned(q, last, &bal.cameraIndices[k]);
+            break;
+          case 1:
+            valid = internal::parseUnsigned(q, last, &bal.pointIndices[k]);
+            break;
+          default:
+            valid = internal::parseFloat(q, last, &bal.uv[2 * k + t % 4 - 2]);
+        }
+      } else {
+        valid = internal::parseFloat(
+            q, last, &bal.parameters[t - nrObservationTokens]);
+      }
+    }
+    if (!valid)
+      throw runtime_error("parseBAL: invalid number in " + filename);
+  });
+
+  for (size_t k = 0; k < nrObservations; ++k)
+    if (bal.cameraIndices[k] >= bal.nrCameras ||
+        bal.pointIndices[k] >= bal.nrPoints)
+      throw runtime_error("parseBAL: invalid observation in " + filename);
+  return bal;
+}
+
+} // namespace gtsam
@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DatasetParser.h
+ * @date October 2026
+ * @brief Fast parsing of g2o, TORO and BAL files, used by the dataset readers
+ */
+
+#pragma once
+
+#include <gtsam/base/MappedFile.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/dllexport.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gtsam {
+
+/// The lines of g2o, TORO and graph files that the dataset readers use
+enum DatasetRecordType {
+  DATASET_VERTEX_SE2,      ///< VERTEX2, VERTEX_SE2, VERTEX: x y yaw
+  DATASET_EDGE_SE2,        ///< EDGE2, EDGE, EDGE_SE2, ODOMETRY: x y yaw, 6 noise entries
+  DATASET_BEARING_RANGE,   ///< BR: bearing range bearing_std range_std
+  DATASET_LANDMARK,        ///< LANDMARK: x y, 3 covariance entries
+  DATASET_VERTEX3,         ///< VERTEX3: x y z roll pitch yaw
+  DATASET_VERTEX_SE3_QUAT, ///< VERTEX_SE3:QUAT: x y z qx qy qz qw
+  DATASET_EDGE3,           ///< EDGE3: x y z roll pitch yaw, 21 information entries
+  DATASET_EDGE_SE3_QUAT    ///< EDGE_SE3:QUAT: x y z qx qy qz qw, 21 information entries
+};
+
+/// A parsed line, its numbers (after the ids) are stored in a DatasetChunk
+struct DatasetRecord {
+  DatasetRecordType type;
+  Key key1;
+  Key key2;       ///< second id of edges and measurements, 0 for vertices
+  size_t offset;  ///< index of the first number in DatasetChunk::numbers
+};
+
+/// The records parsed from a range of lines, in file order
+struct DatasetChunk {
+  std::vector<DatasetRecord> records;
+  std::vector<double> numbers;
+
+  /// The numbers of a record
+  const double* values(const DatasetRecord& record) const {
+    return numbers.data() + record.offset;
+  }
+};
+
+/**
+ * Parses the vertices, edges and measurements of a g2o, TORO or graph file.
+ * The file is mapped into memory and split into chunks of whole lines, which
+ * can be parsed independently, and in parallel if GTSAM is built with TBB.
+ * Lines with other tags are skipped, lines with a known tag but missing or
+ * malformed numbers throw std::runtime_error.
+ */
+class GTSAM_EXPORT DatasetParser {
+  std::string filename_;
+  boost::shared_ptr<MappedFile> file_;
+  std::vector<const char*> boundaries_;  ///< chunk i is [boundaries_[i], boundaries_[i+1])
+
+public:
+
+  /// Map filename and split it into chunks of about chunkSize bytes
+  explicit DatasetParser(const std::string& filename,
+                         size_t chunkSize = 1 << 22);
+
+  /// The number of chunks
+  size_t nrChunks() const { return boundaries_.size() - 1; }
+
+  /// Parse the lines of chunk i into chunk, replacing its contents
+  void parseChunk(size_t i, DatasetChunk* chunk) const;
+
+  /// Parse all chunks, in parallel if GTSAM is built with TBB
+  std::vector<DatasetChunk> parseAll() const;
+};
+
+/// The numbers in a BAL file, in the order they are stored
+struct BALContents {
+  size_t nrCameras = 0, nrPoints = 0;
+  std::vector<uint64_t> cameraIndices;  ///< camera of each observation
+  std::vector<uint64_t> pointIndices;   ///< point of each observation
+  std::vector<float> uv;                ///< 2 coordinates per observation
+  std::vector<float> parameters;        ///< 9 per camera, then 3 per point
+};
+
+/**
+ * Parse a Bundle Adjustment in the Large file. After the header, which is
+ * read first, the file is split into chunks of lines. The numbers in each
+ * chunk are counted, and then parsed straight into place, both in parallel if
+ * GTSAM is built with TBB. Throws std::runtime_error if the file cannot be
+ * read or is malformed.
+ */
+GTSAM_EXPORT BALContents parseBAL(const std::string& filename,
+                                  size_t chunkSize = 1 << 22);
+
+namespace internal {
+
+/**
+ * Parse a number that ends at whitespace or at end. Decimal numbers with up
+ * to 15 significant digits and small exponents are converted with a single
+ * rounding without calling the C library, others fall back to strtod and
+ * strtof, so the result is the correctly rounded value in both cases. On
+ * success p is moved past the number.
+ */
+GTSAM_EXPORT bool parseDouble(const char*& p, const char* end, double* x);
+GTSAM_EXPORT bool parseFloat(const char*& p, const char* end, float* x);
+
+/// Parse an unsigned integer the way operator>> does, including wrapping of
+/// negative numbers
+GTSAM_EXPORT bool parseUnsigned(const char*& p, const char* end, uint64_t* x);
+
+}  // namespace internal
+
+} // namespace gtsam
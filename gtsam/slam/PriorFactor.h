@@ -38,6 +38,11 @@ namespace gtsam {
 
     VALUE prior_; /** The measurement */
 
+    /// noiseModel_, resolved once for the dimension of VALUE
+    typedef noiseModel::FixedWhitener<internal::FixedDimension<VALUE>::value>
+        Whitener;
+    Whitener whitener_;
+
     /** concept check by type */
     GTSAM_CONCEPT_TESTABLE_TYPE(T)
 
@@ -56,12 +61,13 @@ namespace gtsam {
 
     /** Constructor */
     PriorFactor(Key key, const VALUE& prior, const SharedNoiseModel& model = nullptr) :
-      Base(model, key), prior_(prior) {
+      Base(model, key), prior_(prior), whitener_(model) {
     }
 
     /** Convenience constructor that takes a full covariance argument */
     PriorFactor(Key key, const VALUE& prior, const Matrix& covariance) :
-      Base(noiseModel::Gaussian::Covariance(covariance), key), prior_(prior) {
+      Base(noiseModel::Gaussian::Covariance(covariance), key), prior_(prior),
+      whitener_(this->noiseModel_) {
     }
 
     /// @return a deep copy of this factor
@@ -98,6 +104,11 @@ namespace gtsam {
       return -traits<T>::Local(x, prior_);
     }
 
+    /// linearize, whitening without virtual calls on the noise model
+    virtual boost::shared_ptr<GaussianFactor> linearize(const Values& x) const {
+      return this->linearizeWhitened(x, whitener_);
+    }
+
     const VALUE & prior() const { return prior_; }
 
   private:
@@ -109,6 +120,8 @@ namespace gtsam {
       ar & boost::serialization::make_nvp("NoiseModelFactor1",
           boost::serialization::base_object<Base>(*this));
       ar & BOOST_SERIALIZATION_NVP(prior_);
+      if (ARCHIVE::is_loading::value)
+        whitener_ = Whitener(this->noiseModel_);
     }
 
 	// Alignment, see https://eigen.tuxfamily.org/dox/group__TopicStructHavingEigenMembers.html
@@ -18,6 +18,7 @@
 #include <gtsam/sam/BearingRangeFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/slam/dataset.h>
+#include <gtsam/slam/DatasetParser.h>
 #include <gtsam/geometry/Point3.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Rot3.h>
@@ -26,7 +27,9 @@
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam/nonlinear/Values-inl.h>
+#include <gtsam/nonlinear/BinarySerialization.h>
 #include <gtsam/linear/Sampler.h>
+#include <gtsam/base/BinaryArchive.h>
 #include <gtsam/base/GenericValue.h>
 #include <gtsam/base/Lie.h>
 #include <gtsam/base/Matrix.h>
@@ -35,12 +38,14 @@
 #include <gtsam/base/Vector.h>
 
 #include <boost/assign/list_inserter.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 using namespace std;
@@ -110,10 +115,10 @@ GraphAndValues load2D(pair<string, SharedNoiseModel> dataset, int maxID,
 
 /* ************************************************************************* */
 // Read noise parameters and interpret them according to flags
-static SharedNoiseModel readNoiseModel(ifstream& is, bool smart,
+static SharedNoiseModel readNoiseModel(const double* v, bool smart,
     NoiseFormat noiseFormat, KernelFunctionType kernelFunctionType) {
-  double v1, v2, v3, v4, v5, v6;
-  is >> v1 >> v2 >> v3 >> v4 >> v5 >> v6;
+  const double v1 = v[0], v2 = v[1], v3 = v[2], v4 = v[3], v5 = v[4],
+      v6 = v[5];
 
   if (noiseFormat == NoiseFormatAUTO) {
     // Try to guess covariance matrix layout
@@ -191,6 +196,46 @@ static SharedNoiseModel readNoiseModel(ifstream& is, bool smart,
   }
 }
 
+/* ************************************************************************* */
+// Bearing, range and their standard deviations of a BR or LANDMARK record
+static void readBearingRange(const DatasetRecord& record, const double* v,
+    double* bearing, double* range, double* bearing_std, double* range_std,
+    bool* haveLandmark) {
+  if (record.type == DATASET_BEARING_RANGE) {
+    // A bearing-range measurement
+    *bearing = v[0];
+    *range = v[1];
+    *bearing_std = v[2];
+    *range_std = v[3];
+    return;
+  }
+
+  // A landmark measurement, TODO Frank says: don't know why is converted to bearing-range
+  const double lmx = v[0], lmy = v[1];
+  const double v1 = v[2], v3 = v[4];
+
+  // Convert x,y to bearing,range
+  *bearing = atan2(lmy, lmx);
+  *range = sqrt(lmx * lmx + lmy * lmy);
+
+  // In our experience, the x-y covariance on landmark sightings is not very good, so assume
+  // it describes the uncertainty at a range of 10m, and convert that to bearing/range uncertainty.
+  if (std::abs(v1 - v3) < 1e-4) {
+    *bearing_std = sqrt(v1 / 10.0);
+    *range_std = sqrt(v1);
+  } else {
+    *bearing_std = 1;
+    *range_std = 1;
+    if (!*haveLandmark) {
+      cout
+          << "Warning: load2D is a very simple dataset loader and is ignoring the\n"
+              "non-uniform covariance on LANDMARK measurements in this file."
+          << endl;
+      *haveLandmark = true;
+    }
+  }
+}
+
 /* ************************************************************************* */
 boost::optional<IndexedPose> parseVertex(istream& is, const string& tag) {
   if ((tag == "VERTEX2") || (tag == "VERTEX_SE2") || (tag == "VERTEX")) {
@@ -225,31 +270,35 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
   ifstream is(filename.c_str());
   if (!is)
     throw invalid_argument("load2D: can not find file " + filename);
+  is.close();
+
+  // Parse the whole file, in parallel if GTSAM is built with TBB
+  const vector<DatasetChunk> chunks = DatasetParser(filename).parseAll();
 
   Values::shared_ptr initial(new Values);
   NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
 
-  string tag;
-
-  // load the poses
-  while (!is.eof()) {
-    if (!(is >> tag))
-      break;
-
-    const auto indexed_pose = parseVertex(is, tag);
-    if (indexed_pose) {
-      Key id = indexed_pose->first;
+  // load the poses, and count the factors
+  size_t nrFactors = 0;
+  for (const DatasetChunk& chunk : chunks) {
+    for (const DatasetRecord& record : chunk.records) {
+      if (record.type == DATASET_EDGE_SE2 ||
+          record.type == DATASET_BEARING_RANGE ||
+          record.type == DATASET_LANDMARK)
+        ++nrFactors;
+      if (record.type != DATASET_VERTEX_SE2)
+        continue;
+      Key id = record.key1;
 
       // optional filter
       if (maxID && id >= maxID)
         continue;
 
-      initial->insert(id, indexed_pose->second);
+      const double* v = chunk.values(record);
+      initial->insert(id, Pose2(v[0], v[1], v[2]));
     }
-    is.ignore(LINESIZE, '\n');
   }
-  is.clear(); /* clears the end-of-file and error flags */
-  is.seekg(0, ios::beg);
+  graph->reserve(nrFactors);
 
   // If asked, create a sampler with random number generator
   Sampler sampler;
@@ -268,78 +317,50 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
   Key id1, id2;
   bool haveLandmark = false;
   const bool useModelInFile = !model;
-  while (!is.eof()) {
-    if (!(is >> tag))
-      break;
-
-    auto between_pose = parseEdge(is, tag);
-    if (between_pose) {
-      std::tie(id1, id2) = between_pose->first;
-      Pose2& l1Xl2 = between_pose->second;
-
-      // read noise model
-      SharedNoiseModel modelInFile = readNoiseModel(is, smart, noiseFormat,
-          kernelFunctionType);
-
-      // optional filter
-      if (maxID && (id1 >= maxID || id2 >= maxID))
+  for (const DatasetChunk& chunk : chunks) {
+    for (const DatasetRecord& record : chunk.records) {
+      const double* v = chunk.values(record);
+      id1 = record.key1;
+      id2 = record.key2;
+
+      if (record.type == DATASET_EDGE_SE2) {
+        Pose2 l1Xl2(v[0], v[1], v[2]);
+
+        // read noise model
+        SharedNoiseModel modelInFile = readNoiseModel(v + 3, smart,
+            noiseFormat, kernelFunctionType);
+
+        // optional filter
+        if (maxID && (id1 >= maxID || id2 >= maxID))
+          continue;
+
+        if (useModelInFile)
+          model = modelInFile;
+
+        if (addNoise)
+          l1Xl2 = l1Xl2.retract(sampler.sample());
+
+        // Insert vertices if pure odometry file
+        if (!initial->exists(id1))
+          initial->insert(id1, Pose2());
+        if (!initial->exists(id2))
+          initial->insert(id2, initial->at<Pose2>(id1) * l1Xl2);
+
+        NonlinearFactor::shared_ptr factor(
+            new BetweenFactor<Pose2>(id1, id2, l1Xl2, model));
+        graph->push_back(factor);
         continue;
-
-      if (useModelInFile)
-        model = modelInFile;
-
-      if (addNoise)
-        l1Xl2 = l1Xl2.retract(sampler.sample());
-
-      // Insert vertices if pure odometry file
-      if (!initial->exists(id1))
-        initial->insert(id1, Pose2());
-      if (!initial->exists(id2))
-        initial->insert(id2, initial->at<Pose2>(id1) * l1Xl2);
-
-      NonlinearFactor::shared_ptr factor(
-          new BetweenFactor<Pose2>(id1, id2, l1Xl2, model));
-      graph->push_back(factor);
-    }
-    // Parse measurements
-    double bearing, range, bearing_std, range_std;
-
-    // A bearing-range measurement
-    if (tag == "BR") {
-      is >> id1 >> id2 >> bearing >> range >> bearing_std >> range_std;
-    }
-
-    // A landmark measurement, TODO Frank says: don't know why is converted to bearing-range
-    if (tag == "LANDMARK") {
-      double lmx, lmy;
-      double v1, v2, v3;
-
-      is >> id1 >> id2 >> lmx >> lmy >> v1 >> v2 >> v3;
-
-      // Convert x,y to bearing,range
-      bearing = atan2(lmy, lmx);
-      range = sqrt(lmx * lmx + lmy * lmy);
-
-      // In our experience, the x-y covariance on landmark sightings is not very good, so assume
-      // it describes the uncertainty at a range of 10m, and convert that to bearing/range uncertainty.
-      if (std::abs(v1 - v3) < 1e-4) {
-        bearing_std = sqrt(v1 / 10.0);
-        range_std = sqrt(v1);
-      } else {
-        bearing_std = 1;
-        range_std = 1;
-        if (!haveLandmark) {
-          cout
-              << "Warning: load2D is a very simple dataset loader and is ignoring the\n"
-                  "non-uniform covariance on LANDMARK measurements in this file."
-              << endl;
-          haveLandmark = true;
-        }
       }
-    }
 
-    // Do some common stuff for bearing-range measurements
-    if (tag == "LANDMARK" || tag == "BR") {
+      // Parse measurements
+      if (record.type != DATASET_BEARING_RANGE &&
+          record.type != DATASET_LANDMARK)
+        continue;
+      double bearing, range, bearing_std, range_std;
+      readBearingRange(record, v, &bearing, &range, &bearing_std, &range_std,
+                       &haveLandmark);
+
+      // Do some common stuff for bearing-range measurements
 
       // optional filter
       if (maxID && id1 >= maxID)
@@ -363,7 +384,6 @@ GraphAndValues load2D(const string& filename, SharedNoiseModel model, Key maxID,
         initial->insert(L(id2), global);
       }
     }
-    is.ignore(LINESIZE, '\n');
   }
 
   return make_pair(graph, initial);
@@ -511,96 +531,116 @@ void writeG2o(const NonlinearFactorGraph& graph, const Values& estimate,
 }
 
 /* ************************************************************************* */
-std::map<Key, Pose3> parse3DPoses(const string& filename) {
+// Parse filename, and throw invalid_argument with caller if it does not exist
+static vector<DatasetChunk> parseDataset(const string& filename,
+                                         const string& caller) {
   ifstream is(filename.c_str());
   if (!is)
-    throw invalid_argument("parse3DPoses: can not find file " + filename);
+    throw invalid_argument(caller + ": can not find file " + filename);
+  is.close();
+  return DatasetParser(filename).parseAll();
+}
 
-  std::map<Key, Pose3> poses;
-  while (!is.eof()) {
-    char buf[LINESIZE];
-    is.getline(buf, LINESIZE);
-    istringstream ls(buf);
-    string tag;
-    ls >> tag;
-
-    if (tag == "VERTEX3") {
-      Key id;
-      double x, y, z, roll, pitch, yaw;
-      ls >> id >> x >> y >> z >> roll >> pitch >> yaw;
-      poses.emplace(id, Pose3(Rot3::Ypr(yaw, pitch, roll), {x, y, z}));
-    }
-    if (tag == "VERTEX_SE3:QUAT") {
-      Key id;
-      double x, y, z, qx, qy, qz, qw;
-      ls >> id >> x >> y >> z >> qx >> qy >> qz >> qw;
-      poses.emplace(id, Pose3(Rot3::Quaternion(qw, qx, qy, qz), {x, y, z}));
-    }
+/* ************************************************************************* */
+// The pose of a VERTEX3 or VERTEX_SE3:QUAT record
+static Pose3 readPose3(const DatasetRecord& record, const double* v) {
+  if (record.type == DATASET_VERTEX3) {
+    // x y z roll pitch yaw
+    return Pose3(Rot3::Ypr(v[5], v[4], v[3]), {v[0], v[1], v[2]});
   }
-  return poses;
+  // x y z qx qy qz qw
+  return Pose3(Rot3::Quaternion(v[6], v[3], v[4], v[5]), {v[0], v[1], v[2]});
 }
 
 /* ************************************************************************* */
-BetweenFactorPose3s parse3DFactors(const string& filename) {
-  ifstream is(filename.c_str());
-  if (!is) throw invalid_argument("parse3DFactors: can not find file " + filename);
+static std::map<Key, Pose3> parse3DPoses(const vector<DatasetChunk>& chunks) {
+  std::map<Key, Pose3> poses;
+  for (const DatasetChunk& chunk : chunks)
+    for (const DatasetRecord& record : chunk.records)
+      if (record.type == DATASET_VERTEX3 ||
+          record.type == DATASET_VERTEX_SE3_QUAT)
+        poses.emplace(record.key1, readPose3(record, chunk.values(record)));
+  return poses;
+}
 
-  std::vector<BetweenFactor<Pose3>::shared_ptr> factors;
-  while (!is.eof()) {
-    char buf[LINESIZE];
-    is.getline(buf, LINESIZE);
-    istringstream ls(buf);
-    string tag;
-    ls >> tag;
-
-    if (tag == "EDGE3") {
-      Key id1, id2;
-      double x, y, z, roll, pitch, yaw;
-      ls >> id1 >> id2 >> x >> y >> z >> roll >> pitch >> yaw;
-      Matrix m(6, 6);
-      for (size_t i = 0; i < 6; i++)
-        for (size_t j = i; j < 6; j++) ls >> m(i, j);
-      SharedNoiseModel model = noiseModel::Gaussian::Information(m);
-      factors.emplace_back(new BetweenFactor<Pose3>(
-          id1, id2, Pose3(Rot3::Ypr(yaw, pitch, roll), {x, y, z}), model));
-    }
-    if (tag == "EDGE_SE3:QUAT") {
-      Key id1, id2;
-      double x, y, z, qx, qy, qz, qw;
-      ls >> id1 >> id2 >> x >> y >> z >> qx >> qy >> qz >> qw;
-      Matrix m(6, 6);
-      for (size_t i = 0; i < 6; i++) {
-        for (size_t j = i; j < 6; j++) {
-          double mij;
-          ls >> mij;
-          m(i, j) = mij;
-          m(j, i) = mij;
-        }
-      }
-      Matrix mgtsam(6, 6);
+/* ************************************************************************* */
+std::map<Key, Pose3> parse3DPoses(const string& filename) {
+  return parse3DPoses(parseDataset(filename, "parse3DPoses"));
+}
 
-      mgtsam.block<3, 3>(0, 0) = m.block<3, 3>(3, 3);  // cov rotation
-      mgtsam.block<3, 3>(3, 3) = m.block<3, 3>(0, 0);  // cov translation
-      mgtsam.block<3, 3>(0, 3) = m.block<3, 3>(0, 3);  // off diagonal
-      mgtsam.block<3, 3>(3, 0) = m.block<3, 3>(3, 0);  // off diagonal
+/* ************************************************************************* */
+// The factor of an EDGE3 or EDGE_SE3:QUAT record
+static BetweenFactor<Pose3>::shared_ptr readBetweenPose3(
+    const DatasetRecord& record, const double* v) {
+  if (record.type == DATASET_EDGE3) {
+    // x y z roll pitch yaw, then the upper triangle of the information
+    Matrix m = Matrix::Zero(6, 6);
+    const double* mij = v + 6;
+    for (size_t i = 0; i < 6; i++)
+      for (size_t j = i; j < 6; j++) m(i, j) = *mij++;
+    SharedNoiseModel model = noiseModel::Gaussian::Information(m);
+    return boost::make_shared<BetweenFactor<Pose3> >(
+        record.key1, record.key2,
+        Pose3(Rot3::Ypr(v[5], v[4], v[3]), {v[0], v[1], v[2]}), model);
+  }
 
-      SharedNoiseModel model = noiseModel::Gaussian::Information(mgtsam);
-      factors.emplace_back(new BetweenFactor<Pose3>(
-          id1, id2, Pose3(Rot3::Quaternion(qw, qx, qy, qz), {x, y, z}), model));
+  // x y z qx qy qz qw, then the upper triangle of the information
+  Matrix m(6, 6);
+  const double* mij = v + 7;
+  for (size_t i = 0; i < 6; i++) {
+    for (size_t j = i; j < 6; j++) {
+      m(i, j) = *mij;
+      m(j, i) = *mij++;
     }
   }
+  Matrix mgtsam(6, 6);
+
+  mgtsam.block<3, 3>(0, 0) = m.block<3, 3>(3, 3);  // cov rotation
+  mgtsam.block<3, 3>(3, 3) = m.block<3, 3>(0, 0);  // cov translation
+  mgtsam.block<3, 3>(0, 3) = m.block<3, 3>(0, 3);  // off diagonal
+  mgtsam.block<3, 3>(3, 0) = m.block<3, 3>(3, 0);  // off diagonal
+
+  SharedNoiseModel model = noiseModel::Gaussian::Information(mgtsam);
+  return boost::make_shared<BetweenFactor<Pose3> >(
+      record.key1, record.key2,
+      Pose3(Rot3::Quaternion(v[6], v[3], v[4], v[5]), {v[0], v[1], v[2]}),
+      model);
+}
+
+/* ************************************************************************* */
+static BetweenFactorPose3s parse3DFactors(const vector<DatasetChunk>& chunks) {
+  size_t nrFactors = 0;
+  for (const DatasetChunk& chunk : chunks)
+    for (const DatasetRecord& record : chunk.records)
+      if (record.type == DATASET_EDGE3 || record.type == DATASET_EDGE_SE3_QUAT)
+        ++nrFactors;
+
+  std::vector<BetweenFactor<Pose3>::shared_ptr> factors;
+  factors.reserve(nrFactors);
+  for (const DatasetChunk& chunk : chunks)
+    for (const DatasetRecord& record : chunk.records)
+      if (record.type == DATASET_EDGE3 || record.type == DATASET_EDGE_SE3_QUAT)
+        factors.push_back(readBetweenPose3(record, chunk.values(record)));
   return factors;
 }
 
+/* ************************************************************************* */
+BetweenFactorPose3s parse3DFactors(const string& filename) {
+  return parse3DFactors(parseDataset(filename, "parse3DFactors"));
+}
+
 /* ************************************************************************* */
 GraphAndValues load3D(const string& filename) {
-  const auto factors = parse3DFactors(filename);
+  // Parse the file once for both factors and poses
+  const vector<DatasetChunk> chunks = parseDataset(filename, "parse3DFactors");
+  const auto factors = parse3DFactors(chunks);
   NonlinearFactorGraph::shared_ptr graph(new NonlinearFactorGraph);
+  graph->reserve(factors.size());
   for (const auto& factor : factors) {
     graph->push_back(factor);
   }
 
-  const auto poses = parse3DPoses(filename);
+  const auto poses = parse3DPoses(chunks);
   Values::shared_ptr initial(new Values);
   for (const auto& key_pose : poses) {
     initial->insert(key_pose.first, key_pose.second);
@@ -609,6 +649,198 @@ GraphAndValues load3D(const string& filename) {
   return make_pair(graph, initial);
 }
 
+/* ************************************************************************* */
+DatasetStream::DatasetStream(const string& filename, const Params& params)
+    : params_(params),
+      parser_(filename, params.chunkSize),
+      nextChunk_(0),
+      firstRecord_(0),
+      cursor_(0),
+      horizon_(0),
+      nrBatches_(0),
+      haveLandmark_(false) {}
+
+/* ************************************************************************* */
+// Record i of the file and its numbers, or null past the end of the file
+const DatasetRecord* DatasetStream::record(size_t i, const double** v) {
+  // Forget the chunks before the cursor
+  while (!chunks_.empty() &&
+         cursor_ >= firstRecord_ + chunks_.front().records.size()) {
+    firstRecord_ += chunks_.front().records.size();
+    chunks_.pop_front();
+  }
+
+  size_t first = firstRecord_;
+  for (size_t c = 0;; ++c) {
+    if (c == chunks_.size()) {
+      if (nextChunk_ == parser_.nrChunks()) return nullptr;
+      chunks_.emplace_back();
+      parser_.parseChunk(nextChunk_++, &chunks_.back());
+    }
+    const DatasetChunk& chunk = chunks_[c];
+    if (i < first + chunk.records.size()) {
+      const DatasetRecord& r = chunk.records[i - first];
+      *v = chunk.values(r);
+      return &r;
+    }
+    first += chunk.records.size();
+  }
+}
+
+/* ************************************************************************* */
+// Keep the pose of the vertex in record i until its first factor
+void DatasetStream::pend(size_t i, const DatasetRecord& record,
+                         const double* v) {
+  const Key key = record.key1;
+  if (introduced_.exists(key) || pending_.exists(key)) return;
+  if (record.type == DATASET_VERTEX_SE2)
+    pending_.insert(key, Pose2(v[0], v[1], v[2]));
+  else if (record.type == DATASET_VERTEX3 ||
+           record.type == DATASET_VERTEX_SE3_QUAT)
+    pending_.insert(key, readPose3(record, v));
+  else
+    return;
+  pendingOrder_.emplace_back(i, key);
+}
+
+/* ************************************************************************* */
+// Forget the vertices more than lookahead lines behind the cursor
+void DatasetStream::forgetPending() {
+  while (!pendingOrder_.empty() &&
+         pendingOrder_.front().first + params_.lookahead < cursor_) {
+    const Key key = pendingOrder_.front().second;
+    if (pending_.exists(key)) pending_.erase(key);
+    pendingOrder_.pop_front();
+  }
+}
+
+/* ************************************************************************* */
+// Look ahead for the vertex of key, returns whether it is pending
+bool DatasetStream::lookFor(Key key) {
+  const double* v;
+  for (horizon_ = std::max(horizon_, cursor_ + 1);
+       horizon_ <= cursor_ + params_.lookahead && !pending_.exists(key);
+       ++horizon_) {
+    const DatasetRecord* r = record(horizon_, &v);
+    if (!r) break;
+    pend(horizon_, *r, v);
+  }
+  return pending_.exists(key);
+}
+
+/* ************************************************************************* */
+void DatasetStream::introduce(Key key, const Value& value,
+                              DatasetBatch* batch) {
+  batch->values.insert(key, value);
+  batch->timestamps[key] = batch->index;
+  introduced_.insert(key);
+  recent_.insert(key, value);
+  recentOrder_.push_back(key);
+  if (params_.maxRecentValues && recentOrder_.size() > params_.maxRecentValues) {
+    recent_.erase(recentOrder_.front());
+    recentOrder_.pop_front();
+  }
+  if (pending_.exists(key)) pending_.erase(key);  // value may be this vertex
+}
+
+/* ************************************************************************* */
+// Estimate of a pose introduced before, to initialize new variables from
+template<class POSE>
+POSE DatasetStream::estimate(Key key, const Values* estimates) const {
+  if (estimates && estimates->exists(key)) return estimates->at<POSE>(key);
+  if (recent_.exists(key)) return recent_.at<POSE>(key);
+  throw runtime_error("DatasetStream::next: no estimate of variable " +
+                      DefaultKeyFormatter(key) +
+                      ", pass the current estimates to next");
+}
+
+/* ************************************************************************* */
+bool DatasetStream::next(DatasetBatch* batch, const Values* estimates) {
+  batch->factors = NonlinearFactorGraph();
+  batch->values.clear();
+  batch->timestamps.clear();
+  batch->index = nrBatches_;
+
+  size_t nrNewVariables = 0;
+  const double* v;
+  while (const DatasetRecord* r = record(cursor_, &v)) {
+    forgetPending();
+    if (r->type == DATASET_VERTEX_SE2 || r->type == DATASET_VERTEX3 ||
+        r->type == DATASET_VERTEX_SE3_QUAT) {
+      pend(cursor_, *r, v);
+      ++cursor_;
+      continue;
+    }
+
+    // End the batch before a factor with too many new variables
+    const bool bearingRange = r->type == DATASET_BEARING_RANGE ||
+                              r->type == DATASET_LANDMARK;
+    const Key id1 = r->key1, id2 = bearingRange ? L(r->key2) : r->key2;
+    const bool new1 = !introduced_.exists(id1);
+    const bool new2 = id2 != id1 && !introduced_.exists(id2);
+    if (params_.maxNewVariables && !batch->factors.empty() &&
+        nrNewVariables + new1 + new2 > params_.maxNewVariables)
+      break;
+    nrNewVariables += new1 + new2;
+    const bool pending1 = new1 && lookFor(id1);
+    const bool pending2 = new2 && lookFor(id2);
+
+    // Initialize new variables from their vertices, or as load2D does: the
+    // first pose at the origin, and the second one from the measurement
+    const bool pose3 = r->type == DATASET_EDGE3 ||
+                       r->type == DATASET_EDGE_SE3_QUAT;
+    if (pending1)
+      introduce(id1, pending_.at(id1), batch);
+    else if (new1 && pose3)
+      introduce(id1, GenericValue<Pose3>(Pose3()), batch);
+    else if (new1)
+      introduce(id1, GenericValue<Pose2>(Pose2()), batch);
+    if (pending2) introduce(id2, pending_.at(id2), batch);
+
+    if (r->type == DATASET_EDGE_SE2) {
+      const Pose2 l1Xl2(v[0], v[1], v[2]);
+      SharedNoiseModel model = readNoiseModel(v + 3, params_.smart,
+          params_.noiseFormat, params_.kernelFunctionType);
+      if (new2 && !pending2)
+        introduce(id2, GenericValue<Pose2>(
+                           estimate<Pose2>(id1, estimates) * l1Xl2),
+                  batch);
+      batch->factors.push_back(
+          boost::make_shared<BetweenFactor<Pose2> >(id1, id2, l1Xl2, model));
+    } else if (bearingRange) {
+      double bearing, range, bearing_std, range_std;
+      readBearingRange(*r, v, &bearing, &range, &bearing_std, &range_std,
+                       &haveLandmark_);
+      noiseModel::Diagonal::shared_ptr measurementNoise =
+          noiseModel::Diagonal::Sigmas((Vector(2) << bearing_std, range_std).finished());
+      if (new2 && !pending2) {
+        Point2 local(cos(bearing) * range, sin(bearing) * range);
+        introduce(id2, GenericValue<Point2>(
+                           estimate<Pose2>(id1, estimates).transformFrom(local)),
+                  batch);
+      }
+      batch->factors.push_back(
+          boost::make_shared<BearingRangeFactor<Pose2, Point2> >(
+              id1, id2, bearing, range, measurementNoise));
+    } else {
+      BetweenFactor<Pose3>::shared_ptr factor = readBetweenPose3(*r, v);
+      if (new2 && !pending2)
+        introduce(id2, GenericValue<Pose3>(estimate<Pose3>(id1, estimates) *
+                                           factor->measured()),
+                  batch);
+      batch->factors.push_back(factor);
+    }
+    ++cursor_;
+
+    if (params_.maxFactors && batch->factors.size() >= params_.maxFactors)
+      break;
+  }
+
+  if (batch->factors.empty()) return false;
+  ++nrBatches_;
+  return true;
+}
+
 /* ************************************************************************* */
 Rot3 openGLFixedRotation() { // this is due to different convention for cameras in gtsam and openGL
   /* R = [ 1   0   0
@@ -740,55 +972,207 @@ bool readBAL(const string& filename, SfM_data &data) {
     cout << "Error in readBAL: can not find the file!!" << endl;
     return false;
   }
+  is.close();
 
-  // Get the number of camera poses and 3D points
-  size_t nrPoses, nrPoints, nrObservations;
-  is >> nrPoses >> nrPoints >> nrObservations;
+  // Parse all numbers, in parallel if GTSAM is built with TBB
+  BALContents bal;
+  try {
+    bal = parseBAL(filename);
+  } catch (const runtime_error& e) {
+    cout << "Error in readBAL: " << e.what() << endl;
+    return false;
+  }
+  const size_t nrPoses = bal.nrCameras, nrPoints = bal.nrPoints;
 
+  // Count the observations of each point to allocate the tracks once
   data.tracks.resize(nrPoints);
+  vector<size_t> nrMeasurements(nrPoints, 0);
+  for (uint64_t j : bal.pointIndices) ++nrMeasurements[j];
+  for (size_t j = 0; j < nrPoints; j++)
+    data.tracks[j].measurements.reserve(nrMeasurements[j]);
 
   // Get the information for the observations
-  for (size_t k = 0; k < nrObservations; k++) {
-    size_t i = 0, j = 0;
-    float u, v;
-    is >> i >> j >> u >> v;
-    data.tracks[j].measurements.emplace_back(i, Point2(u, -v));
+  for (size_t k = 0; k < bal.pointIndices.size(); k++) {
+    const float u = bal.uv[2 * k], v = bal.uv[2 * k + 1];
+    data.tracks[bal.pointIndices[k]].measurements.emplace_back(
+        bal.cameraIndices[k], Point2(u, -v));
   }
 
   // Get the information for the camera poses
-  for (size_t i = 0; i < nrPoses; i++) {
+  data.cameras.reserve(data.cameras.size() + nrPoses);
+  const float* c = bal.parameters.data();
+  for (size_t i = 0; i < nrPoses; i++, c += 9) {
     // Get the Rodrigues vector
-    float wx, wy, wz;
-    is >> wx >> wy >> wz;
-    Rot3 R = Rot3::Rodrigues(wx, wy, wz); // BAL-OpenGL rotation matrix
+    Rot3 R = Rot3::Rodrigues(c[0], c[1], c[2]); // BAL-OpenGL rotation matrix
 
     // Get the translation vector
-    float tx, ty, tz;
-    is >> tx >> ty >> tz;
-
-    Pose3 pose = openGL2gtsam(R, tx, ty, tz);
+    Pose3 pose = openGL2gtsam(R, c[3], c[4], c[5]);
 
     // Get the focal length and the radial distortion parameters
-    float f, k1, k2;
-    is >> f >> k1 >> k2;
-    Cal3Bundler K(f, k1, k2);
+    Cal3Bundler K(c[6], c[7], c[8]);
 
     data.cameras.emplace_back(pose, K);
   }
 
   // Get the information for the 3D points
-  for (size_t j = 0; j < nrPoints; j++) {
+  for (size_t j = 0; j < nrPoints; j++, c += 3) {
     // Get the 3D position
-    float x, y, z;
-    is >> x >> y >> z;
     SfM_Track& track = data.tracks[j];
-    track.p = Point3(x, y, z);
+    track.p = Point3(c[0], c[1], c[2]);
     track.r = 0.4f;
     track.g = 0.4f;
     track.b = 0.4f;
   }
 
-  is.close();
+  return true;
+}
+
+/* ************************************************************************* */
+namespace {
+/// Doubles per camera in the binary SfM format: 3x4 pose, f, k1, k2, u0, v0
+const size_t kSfMCameraSize = 17;
+}
+
+/* ************************************************************************* */
+bool writeBinarySfM(const string& filename, const SfM_data& data) {
+  const size_t nrCameras = data.number_cameras(), nrTracks = data.number_tracks();
+
+  // Flatten cameras, points and the measurements, sorted by track
+  vector<double> cameras;
+  cameras.reserve(kSfMCameraSize * nrCameras);
+  for (const SfM_Camera& camera : data.cameras) {
+    const Matrix34 T = camera.pose().matrix().topRows<3>();
+    cameras.insert(cameras.end(), T.data(), T.data() + 12);
+    const Cal3Bundler& K = camera.calibration();
+    const double k[] = {K.fx(), K.k1(), K.k2(), K.u0(), K.v0()};
+    cameras.insert(cameras.end(), k, k + 5);
+  }
+  vector<double> points, uv;
+  vector<float> colors;
+  vector<uint64_t> trackOffsets(1, 0), cameraIndices, pointIndices, siftIndices;
+  points.reserve(3 * nrTracks);
+  colors.reserve(3 * nrTracks);
+  trackOffsets.reserve(nrTracks + 1);
+  bool haveSift = true;
+  for (size_t j = 0; j < nrTracks; j++) {
+    const SfM_Track& track = data.tracks[j];
+    points.insert(points.end(), {track.p.x(), track.p.y(), track.p.z()});
+    colors.insert(colors.end(), {track.r, track.g, track.b});
+    for (const SfM_Measurement& m : track.measurements) {
+      cameraIndices.push_back(m.first);
+      pointIndices.push_back(j);
+      uv.insert(uv.end(), {m.second.x(), m.second.y()});
+    }
+    trackOffsets.push_back(cameraIndices.size());
+    haveSift = haveSift &&
+        track.siftIndices.size() == track.measurements.size();
+    if (haveSift)
+      for (const SIFT_Index& sift : track.siftIndices)
+        siftIndices.insert(siftIndices.end(), {sift.first, sift.second});
+  }
+  const size_t nrMeasurements = cameraIndices.size();
+
+  ofstream os(filename.c_str(), ios::binary);
+  if (!os) {
+    cout << "Error in writeBinarySfM: can not open the file!!" << endl;
+    return false;
+  }
+  try {
+    BinaryOutArchive ar(os);
+    ar.beginSection(BINARY_SFM_DATA);
+    ar.write<uint64_t>(nrCameras);
+    ar.write<uint64_t>(nrTracks);
+    ar.write<uint64_t>(nrMeasurements);
+    ar.write<uint8_t>(haveSift);
+    ar.writeArray(cameras.data(), cameras.size());
+    ar.writeArray(points.data(), points.size());
+    ar.writeArray(colors.data(), colors.size());
+    ar.writeArray(trackOffsets.data(), trackOffsets.size());
+    ar.writeArray(cameraIndices.data(), nrMeasurements);
+    ar.writeArray(pointIndices.data(), nrMeasurements);
+    ar.writeArray(uv.data(), uv.size());
+    if (haveSift) ar.writeArray(siftIndices.data(), siftIndices.size());
+    ar.endSection();
+  } catch (const runtime_error& e) {
+    cout << "Error in writeBinarySfM: " << e.what() << endl;
+    return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+SfM_dataView::SfM_dataView(const string& filename)
+    : archive_(new BinaryInArchive(filename)) {
+  BinaryInArchive& ar = *archive_;
+  ar.readSection(BINARY_SFM_DATA);
+  nrCameras_ = ar.read<uint64_t>();
+  nrTracks_ = ar.read<uint64_t>();
+  nrMeasurements_ = ar.read<uint64_t>();
+  const bool haveSift = ar.read<uint8_t>() != 0;
+  if (nrCameras_ > numeric_limits<size_t>::max() / kSfMCameraSize ||
+      nrTracks_ > numeric_limits<size_t>::max() / 3 ||
+      nrMeasurements_ > numeric_limits<size_t>::max() / 2)
+    throw runtime_error("SfM_dataView: corrupt sizes in " + filename);
+  cameras_ = ar.readArray<double>(kSfMCameraSize * nrCameras_);
+  points_ = ar.readArray<double>(3 * nrTracks_);
+  colors_ = ar.readArray<float>(3 * nrTracks_);
+  trackOffsets_ = ar.readArray<uint64_t>(nrTracks_ + 1);
+  cameraIndices_ = ar.readArray<uint64_t>(nrMeasurements_);
+  pointIndices_ = ar.readArray<uint64_t>(nrMeasurements_);
+  uv_ = ar.readArray<double>(2 * nrMeasurements_);
+  siftIndices_ = haveSift ? ar.readArray<uint64_t>(2 * nrMeasurements_) : 0;
+
+  // Validate the indices once, so that accessors do not need to
+  if (trackOffsets_[0] != 0 || trackOffsets_[nrTracks_] != nrMeasurements_)
+    throw runtime_error("SfM_dataView: corrupt tracks in " + filename);
+  for (size_t j = 0; j < nrTracks_; j++)
+    if (trackOffsets_[j] > trackOffsets_[j + 1])
+      throw runtime_error("SfM_dataView: corrupt tracks in " + filename);
+  for (size_t k = 0; k < nrMeasurements_; k++)
+    if (cameraIndices_[k] >= nrCameras_ || pointIndices_[k] >= nrTracks_)
+      throw runtime_error("SfM_dataView: corrupt measurements in " + filename);
+}
+
+/* ************************************************************************* */
+SfM_Camera SfM_dataView::camera(size_t i) const {
+  const double* c = cameras_ + kSfMCameraSize * i;
+  const Eigen::Map<const Matrix34> T(c);
+  const Pose3 pose(Rot3(T.leftCols<3>()), Point3(T(0, 3), T(1, 3), T(2, 3)));
+  return SfM_Camera(pose, Cal3Bundler(c[12], c[13], c[14], c[15], c[16]));
+}
+
+/* ************************************************************************* */
+SfM_data SfM_dataView::data() const {
+  SfM_data data;
+  data.cameras.reserve(nrCameras_);
+  for (size_t i = 0; i < nrCameras_; i++)
+    data.cameras.push_back(camera(i));
+  data.tracks.resize(nrTracks_);
+  for (size_t j = 0; j < nrTracks_; j++) {
+    SfM_Track& track = data.tracks[j];
+    track.p = point(j);
+    track.r = colors_[3 * j];
+    track.g = colors_[3 * j + 1];
+    track.b = colors_[3 * j + 2];
+    track.measurements.reserve(trackOffsets_[j + 1] - trackOffsets_[j]);
+    for (size_t k = trackOffsets_[j]; k < trackOffsets_[j + 1]; k++) {
+      track.measurements.push_back(measurement(k));
+      if (siftIndices_)
+        track.siftIndices.emplace_back(siftIndices_[2 * k],
+                                       siftIndices_[2 * k + 1]);
+    }
+  }
+  return data;
+}
+
+/* ************************************************************************* */
+bool readBinarySfM(const string& filename, SfM_data &data) {
+  try {
+    data = SfM_dataView(filename).data();
+  } catch (const runtime_error& e) {
+    cout << "Error in readBinarySfM: " << e.what() << endl;
+    return false;
+  }
   return true;
 }
 
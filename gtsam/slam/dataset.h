@@ -19,6 +19,7 @@
 #pragma once
 
 #include <gtsam/slam/BetweenFactor.h>
+#include <gtsam/slam/DatasetParser.h>
 #include <gtsam/geometry/Cal3Bundler.h>
 #include <gtsam/geometry/PinholeCamera.h>
 #include <gtsam/geometry/Point2.h>
@@ -34,11 +35,14 @@
 #include <string>
 #include <utility> // for pair
 #include <vector>
+#include <deque>
 #include <iosfwd>
 #include <map>
 
 namespace gtsam {
 
+class BinaryInArchive;
+
 /**
  * Find the full path to an example dataset distributed with gtsam.  The name
  * may be specified with or without a file extension - if no extension is
@@ -119,6 +123,7 @@ GTSAM_EXPORT GraphAndValues load2D(
  * @param noiseFormat how noise parameters are stored
  * @param kernelFunctionType whether to wrap the noise model in a robust kernel
  * @return graph and initial values
+ * @throw std::runtime_error if a vertex or edge line is malformed
  */
 GTSAM_EXPORT GraphAndValues load2D(const std::string& filename,
     SharedNoiseModel model = SharedNoiseModel(), Key maxID = 0, bool addNoise =
@@ -165,6 +170,108 @@ GTSAM_EXPORT std::map<Key, Pose3> parse3DPoses(const std::string& filename);
 /// Load TORO 3D Graph
 GTSAM_EXPORT GraphAndValues load3D(const std::string& filename);
 
+/// A batch of new factors read by DatasetStream
+struct GTSAM_EXPORT DatasetBatch {
+  NonlinearFactorGraph factors;  ///< the new factors, in file order
+  Values values;  ///< initial estimates of the variables the factors introduce
+  std::map<Key, double> timestamps;  ///< index of the batch, for each new variable
+  size_t index = 0;  ///< number of batches read before this one
+};
+
+/// When DatasetStream ends batches, and how it interprets the file
+struct GTSAM_EXPORT DatasetStreamParams {
+  /// A batch ends before a factor that would introduce more new variables
+  /// than this, e.g., 1 for one batch per new pose. 0 for no limit.
+  size_t maxNewVariables = 1;
+  /// A batch ends after this many factors, 0 for no limit
+  size_t maxFactors = 0;
+  /// How many lines to look ahead for the vertex of a new variable, and how
+  /// many lines a vertex is kept before its first factor
+  size_t lookahead = 1000;
+  /// How many of the last introduced variables to keep initial estimates of,
+  /// to initialize new variables from. 0 for no limit.
+  size_t maxRecentValues = 1000;
+  /// How noise parameters of 2D edges are stored, see load2D
+  NoiseFormat noiseFormat = NoiseFormatAUTO;
+  /// Whether to wrap the noise models of 2D edges in a robust kernel
+  KernelFunctionType kernelFunctionType = KernelFunctionTypeNONE;
+  /// Try to reduce the noise models of 2D edges to cheaper ones
+  bool smart = true;
+  /// Size in bytes of the chunks the file is parsed in
+  size_t chunkSize = 1 << 20;
+};
+
+/**
+ * Reads a g2o or TORO file in batches of factors, in file order, without
+ * loading the whole graph. Each batch holds exactly what ISAM2::update needs:
+ * its new factors, and initial estimates for the variables they introduce.
+ * With the timestamps, batches can also be passed to FixedLagSmoother::update.
+ * Example:
+ * \code
+ *   DatasetStream stream(filename);
+ *   DatasetBatch batch;
+ *   while (stream.next(&batch)) isam.update(batch.factors, batch.values);
+ * \endcode
+ *
+ * Factors are created as by load2D and load3D. A new variable is initialized
+ * with its vertex if that is at most Params::lookahead lines before or after
+ * its first factor. Otherwise it is initialized as load2D does for odometry
+ * files: from the other pose of the edge, or from the pose of a bearing-range
+ * measurement. That pose is taken from the estimates passed to next, if any,
+ * or else from the initial estimates of the last Params::maxRecentValues
+ * variables introduced.
+ *
+ * The file is memory mapped and parsed in chunks. Besides the chunks in the
+ * lookahead window, and the vertices and estimates above, the stream only
+ * keeps the keys of the variables introduced so far.
+ */
+class GTSAM_EXPORT DatasetStream {
+public:
+  typedef DatasetStreamParams Params;
+
+  /// Open filename, throws std::runtime_error if it cannot be read
+  explicit DatasetStream(const std::string& filename,
+                         const Params& params = Params());
+
+  /**
+   * Read the next batch into batch, replacing its contents.
+   * @param estimates if given, the current estimates of the variables
+   *        introduced so far, e.g., from ISAM2::calculateEstimate, to
+   *        initialize new variables from
+   * @return false if the file has no factors left, true otherwise
+   * @throw std::runtime_error if a vertex or edge line is malformed, or if a
+   *        variable is initialized from a pose that has no estimate
+   */
+  bool next(DatasetBatch* batch, const Values* estimates = nullptr);
+
+  /// Initial estimates of the last Params::maxRecentValues variables
+  const Values& recentValues() const { return recent_; }
+
+private:
+  const DatasetRecord* record(size_t i, const double** v);
+  void pend(size_t i, const DatasetRecord& record, const double* v);
+  void forgetPending();
+  bool lookFor(Key key);
+  void introduce(Key key, const Value& value, DatasetBatch* batch);
+  template<class POSE>
+  POSE estimate(Key key, const Values* estimates) const;
+
+  Params params_;
+  DatasetParser parser_;
+  size_t nextChunk_;  ///< next chunk of the file to parse
+  std::deque<DatasetChunk> chunks_;  ///< parsed chunks, from the cursor on
+  size_t firstRecord_;  ///< index in the file of the first record in chunks_
+  size_t cursor_;  ///< index of the next record to read
+  size_t horizon_;  ///< index of the first record not looked at yet
+  size_t nrBatches_;
+  bool haveLandmark_;  ///< whether the LANDMARK warning was printed
+  Values pending_;  ///< vertices read before their first factor
+  std::deque<std::pair<size_t, Key> > pendingOrder_;  ///< and their records
+  KeySet introduced_;  ///< the variables introduced so far
+  Values recent_;  ///< initial estimates of the last introduced variables
+  std::deque<Key> recentOrder_;  ///< in the order they were introduced
+};
+
 /// A measurement with its camera index
 typedef std::pair<size_t, Point2> SfM_Measurement;
 
@@ -216,6 +323,82 @@ GTSAM_EXPORT bool readBundler(const std::string& filename, SfM_data &data);
  */
 GTSAM_EXPORT bool readBAL(const std::string& filename, SfM_data &data);
 
+/**
+ * @brief This function writes SfM data to a binary file, which SfM_dataView
+ * maps into memory without parsing. Measurements are stored as flat arrays of
+ * camera indices, point indices and image coordinates, sorted by track. SIFT
+ * indices are kept if every track has one per measurement.
+ * @param filename The name of the binary file
+ * @param data SfM structure to write
+ * @return true if the file was written, false otherwise
+ */
+GTSAM_EXPORT bool writeBinarySfM(const std::string& filename,
+    const SfM_data& data);
+
+/**
+ * @brief This function reads a file written by writeBinarySfM into a SfM_data
+ * structure
+ * @param filename The name of the binary file
+ * @param data SfM structure where the data is stored
+ * @return true if the parsing was successful, false otherwise
+ */
+GTSAM_EXPORT bool readBinarySfM(const std::string& filename, SfM_data &data);
+
+/**
+ * Read-only view of a file written by writeBinarySfM. The file is memory
+ * mapped, and cameras, points and measurements are read in place, so opening
+ * even a large problem takes no time. The flat measurement arrays can be used
+ * directly to build factors in batches.
+ */
+class GTSAM_EXPORT SfM_dataView {
+  boost::shared_ptr<BinaryInArchive> archive_;  ///< keeps the file mapped
+  size_t nrCameras_, nrTracks_, nrMeasurements_;
+  const double* cameras_;  ///< per camera: pose as 3x4 matrix, f, k1, k2, u0, v0
+  const double* points_;  ///< x, y, z per track
+  const float* colors_;  ///< r, g, b per track
+  const uint64_t* trackOffsets_;  ///< first measurement of each track, and the end
+  const uint64_t* cameraIndices_;  ///< per measurement
+  const uint64_t* pointIndices_;  ///< per measurement
+  const double* uv_;  ///< u, v per measurement
+  const uint64_t* siftIndices_;  ///< two per measurement, or null
+
+public:
+  /// Map filename, throws std::runtime_error if it is not a binary SfM file
+  explicit SfM_dataView(const std::string& filename);
+
+  size_t number_cameras() const { return nrCameras_; }
+  size_t number_tracks() const { return nrTracks_; }
+  size_t number_measurements() const { return nrMeasurements_; }
+
+  /// Camera i
+  SfM_Camera camera(size_t i) const;
+
+  /// Position of track j
+  Point3 point(size_t j) const {
+    return Point3(points_[3 * j], points_[3 * j + 1], points_[3 * j + 2]);
+  }
+
+  /// Measurements k of track j are those with trackBegin(j) <= k < trackBegin(j + 1)
+  size_t trackBegin(size_t j) const { return trackOffsets_[j]; }
+
+  /// Measurement k, with its camera index
+  SfM_Measurement measurement(size_t k) const {
+    return SfM_Measurement(cameraIndices_[k], Point2(uv_[2 * k], uv_[2 * k + 1]));
+  }
+
+  /// Camera index of each measurement
+  const uint64_t* cameraIndices() const { return cameraIndices_; }
+
+  /// Track index of each measurement
+  const uint64_t* pointIndices() const { return pointIndices_; }
+
+  /// Image coordinates u, v of each measurement
+  const double* uv() const { return uv_; }
+
+  /// Copy the data into a SfM_data structure
+  SfM_data data() const;
+};
+
 /**
  * @brief This function writes a "Bundle Adjustment in the Large" (BAL) file from a
  * SfM_data structure
@@ -6,6 +6,7 @@
  */
 
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/Pose2.h>
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/slam/BetweenFactor.h>
@@ -44,6 +45,36 @@ TEST(BetweenFactor, Rot3) {
   EXPECT(assert_equal(numericalH2,actualH2, 1E-5));
 }
 
+/* ************************************************************************* */
+// The fixed-size whitening in linearize agrees with NoiseModelFactor::linearize
+TEST(BetweenFactor, linearizeWhitened) {
+  Values values;
+  values.insert(X(1), Pose2(1.0, 2.0, 0.3));
+  values.insert(X(2), Pose2(2.5, 1.0, -0.2));
+  const Pose2 measured(1.2, -0.9, -0.4);
+
+  Matrix3 S;
+  S << 1.0, 0.1, 0.2,
+       0.1, 2.0, 0.3,
+       0.2, 0.3, 0.5;
+  std::vector<SharedNoiseModel> models;
+  models.push_back(SharedNoiseModel());
+  models.push_back(Unit::Create(3));
+  models.push_back(Isotropic::Sigma(3, 0.5));
+  models.push_back(Diagonal::Sigmas(Vector3(0.5, 1.0, 2.0)));
+  models.push_back(Gaussian::Covariance(S));
+  models.push_back(Robust::Create(mEstimator::Huber::Create(0.1),
+                                  Diagonal::Sigmas(Vector3(0.5, 1.0, 2.0))));
+
+  for (const SharedNoiseModel& model : models) {
+    BetweenFactor<Pose2> factor(X(1), X(2), measured, model);
+    GaussianFactor::shared_ptr expected =
+        factor.NoiseModelFactor::linearize(values);
+    GaussianFactor::shared_ptr actual = factor.linearize(values);
+    EXPECT(assert_equal(*expected, *actual, 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 /*
 // Constructor scalar
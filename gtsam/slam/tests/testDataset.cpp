@@ -17,15 +17,19 @@
 
 
 #include <gtsam/slam/dataset.h>
+#include <gtsam/slam/DatasetParser.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/geometry/Pose2.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/base/TestableAssertions.h>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 
 #include <CppUnitLite/TestHarness.h>
 
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 
@@ -384,6 +388,113 @@ TEST( dataSet, writeG2o3DNonDiagonalNoise)
   EXPECT(assert_equal(*expectedGraph,*actualGraph,1e-4));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, DatasetStream)
+{
+  for (const string name : {"example", "w100.graph", "pose3example"}) {
+    const string filename = findExampleDataFile(name);
+    const GraphAndValues expected = name == "pose3example"
+        ? load3D(filename) : load2D(filename);
+
+    // One pose per batch, with only known variables besides the new ones
+    DatasetStream::Params params;
+    params.chunkSize = 1000;
+    DatasetStream stream(filename, params);
+    NonlinearFactorGraph actual;
+    Values known;
+    DatasetBatch batch;
+    size_t nrBatches = 0;
+    while (stream.next(&batch)) {
+      EXPECT_LONGS_EQUAL(nrBatches++, batch.index);
+      if (batch.index > 0) EXPECT(batch.values.size() <= 1);
+      EXPECT_LONGS_EQUAL(batch.values.size(), batch.timestamps.size());
+      known.insert(batch.values);
+      for (const auto& factor : batch.factors)
+        for (Key key : factor->keys()) EXPECT(known.exists(key));
+      actual.push_back(batch.factors);
+    }
+    EXPECT(!stream.next(&batch));
+    EXPECT(nrBatches > 1);
+    EXPECT(assert_equal(*expected.first, actual));
+    EXPECT(stream.recentValues().size() <= params.maxRecentValues);
+    for (const auto& key_value : known)
+      EXPECT(key_value.value.equals_(expected.second->at(key_value.key), 1e-9));
+  }
+}
+
+/* ************************************************************************* */
+TEST( dataSet, DatasetStreamLookahead)
+{
+  // Vertices after the edge that uses them
+  const boost::filesystem::path filename =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path();
+  {
+    ofstream os(filename.string());
+    os << "EDGE_SE2 0 1 1 0 0 1 0 0 1 0 1\n"
+          "VERTEX_SE2 0 0 0 0\n"
+          "VERTEX_SE2 1 1.1 0.1 0\n";
+  }
+  DatasetStream::Params params;
+  params.noiseFormat = NoiseFormatG2O;
+  DatasetBatch batch;
+  CHECK(DatasetStream(filename.string(), params).next(&batch));
+  EXPECT(assert_equal(Pose2(1.1, 0.1, 0), batch.values.at<Pose2>(1)));
+
+  // Without lookahead, the pose is initialized from the edge
+  params.lookahead = 0;
+  CHECK(DatasetStream(filename.string(), params).next(&batch));
+  EXPECT(assert_equal(Pose2(1, 0, 0), batch.values.at<Pose2>(1)));
+  boost::filesystem::remove(filename);
+}
+
+/* ************************************************************************* */
+TEST( dataSet, DatasetStreamMemory)
+{
+  // Vertices first, then a chain of odometry and a loop closure
+  const boost::filesystem::path filename =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path();
+  {
+    ofstream os(filename.string());
+    os << "VERTEX_SE2 0 0.5 0 0\n"
+          "VERTEX_SE2 1 1.1 0.1 0\n"
+          "VERTEX_SE2 2 2.2 0.2 0\n"
+          "EDGE_SE2 0 1 1 0 0 1 0 0 1 0 1\n"
+          "EDGE_SE2 1 2 1 0 0 1 0 0 1 0 1\n"
+          "EDGE_SE2 0 3 3 0 0 1 0 0 1 0 1\n";
+  }
+  DatasetStream::Params params;
+  params.noiseFormat = NoiseFormatG2O;
+  DatasetBatch batch;
+
+  // Vertices further behind than the lookahead are forgotten
+  params.lookahead = 2;
+  DatasetStream stream(filename.string(), params);
+  CHECK(stream.next(&batch));
+  EXPECT(assert_equal(Pose2(0, 0, 0), batch.values.at<Pose2>(0)));
+  EXPECT(assert_equal(Pose2(1.1, 0.1, 0), batch.values.at<Pose2>(1)));
+  CHECK(stream.next(&batch));
+  EXPECT(assert_equal(Pose2(2.2, 0.2, 0), batch.values.at<Pose2>(2)));
+
+  // Only the last introduced variables are kept, older poses have to be
+  // passed to next
+  params.lookahead = 1000;
+  params.maxRecentValues = 1;
+  DatasetStream recent(filename.string(), params);
+  Values estimates;
+  for (int i = 0; i < 2; i++) {
+    CHECK(recent.next(&batch));
+    estimates.insert(batch.values);
+  }
+  EXPECT_LONGS_EQUAL(1, recent.recentValues().size());
+  CHECK_EXCEPTION(recent.next(&batch), std::runtime_error);
+  estimates.update(0, Pose2(1, 0, 0));
+  CHECK(recent.next(&batch, &estimates));
+  EXPECT(assert_equal(Pose2(4, 0, 0), batch.values.at<Pose2>(3)));
+  boost::filesystem::remove(filename);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, readBAL_Dubrovnik)
 {
@@ -405,6 +516,77 @@ TEST( dataSet, readBAL_Dubrovnik)
   EXPECT(assert_equal(expected,actual,12));
 }
 
+/* ************************************************************************* */
+TEST( dataSet, parseNumbers)
+{
+  // The fast path and the fallback agree with the C library on every string
+  const char* numbers[] = {"0", "-0.0", "1", "+2.5", "-3.326500e-01",
+      "385.989990", "1.5255013120234e+02", "0.1", "1e22", "1e23", "1e-300",
+      "123456789012345678901234", "0.000000000000000000000000123", "3.4e38",
+      "1.17549435e-38", "16777217", "9007199254740993", ".5", "5."};
+  for (const char* number : numbers) {
+    const char* end = number + strlen(number);
+    const char* p = number;
+    double x;
+    CHECK(internal::parseDouble(p, end, &x));
+    EXPECT(p == end);
+    EXPECT(x == strtod(number, nullptr));
+    p = number;
+    float f;
+    CHECK(internal::parseFloat(p, end, &f));
+    EXPECT(f == strtof(number, nullptr));
+  }
+
+  const char* invalid[] = {"", "-", "1.5x", "e5", "1e"};
+  for (const char* number : invalid) {
+    const char* p = number;
+    double x;
+    EXPECT(!internal::parseDouble(p, number + strlen(number), &x));
+  }
+
+  const string key = "-1";
+  const char* p = key.data();
+  uint64_t id;
+  CHECK(internal::parseUnsigned(p, key.data() + key.size(), &id));
+  EXPECT(id == uint64_t(-1));
+}
+
+/* ************************************************************************* */
+TEST( dataSet, DatasetParserChunks)
+{
+  // Chunks of a few lines give the same records as the whole file
+  const string filename = findExampleDataFile("w100.graph");
+  const DatasetParser whole(filename), small(filename, 100);
+  EXPECT_LONGS_EQUAL(1, whole.nrChunks());
+  CHECK(small.nrChunks() > 10);
+  DatasetChunk expected;
+  whole.parseChunk(0, &expected);
+  size_t r = 0, n = 0;
+  for (const DatasetChunk& chunk : small.parseAll()) {
+    for (const DatasetRecord& record : chunk.records) {
+      const DatasetRecord& other = expected.records[r++];
+      EXPECT(record.type == other.type);
+      EXPECT(record.key1 == other.key1 && record.key2 == other.key2);
+    }
+    for (double number : chunk.numbers)
+      EXPECT(number == expected.numbers[n++]);
+  }
+  EXPECT_LONGS_EQUAL(expected.records.size(), r);
+}
+
+/* ************************************************************************* */
+TEST( dataSet, parseBALChunks)
+{
+  const string filename = findExampleDataFile("dubrovnik-3-7-pre");
+  const BALContents expected = parseBAL(filename), actual = parseBAL(filename, 50);
+  EXPECT_LONGS_EQUAL(3, expected.nrCameras);
+  EXPECT_LONGS_EQUAL(7, expected.nrPoints);
+  EXPECT(expected.cameraIndices == actual.cameraIndices);
+  EXPECT(expected.pointIndices == actual.pointIndices);
+  EXPECT(expected.uv == actual.uv);
+  EXPECT(expected.parameters == actual.parameters);
+}
+
 /* ************************************************************************* */
 TEST( dataSet, openGL2gtsam)
 {
@@ -486,6 +668,58 @@ TEST( dataSet, writeBAL_Dubrovnik)
   }
 }
 
+/* ************************************************************************* */
+TEST( dataSet, writeBinarySfM_Dubrovnik)
+{
+  const string filenameToRead = findExampleDataFile("dubrovnik-3-7-pre");
+  SfM_data readData;
+  CHECK(readBAL(filenameToRead, readData));
+
+  const boost::filesystem::path filename =
+      boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path();
+  CHECK(writeBinarySfM(filename.string(), readData));
+
+  // The view reads cameras, points and measurements in place
+  SfM_dataView view(filename.string());
+  EXPECT_LONGS_EQUAL(3, view.number_cameras());
+  EXPECT_LONGS_EQUAL(7, view.number_tracks());
+  for (size_t i = 0; i < view.number_cameras(); i++)
+    EXPECT(assert_equal(readData.cameras[i], view.camera(i)));
+  size_t k = 0;
+  for (size_t j = 0; j < view.number_tracks(); j++) {
+    const SfM_Track& track = readData.tracks[j];
+    EXPECT(assert_equal(track.p, view.point(j)));
+    EXPECT_LONGS_EQUAL(k, view.trackBegin(j));
+    for (const SfM_Measurement& m : track.measurements) {
+      EXPECT_LONGS_EQUAL(m.first, view.measurement(k).first);
+      EXPECT_LONGS_EQUAL(j, view.pointIndices()[k]);
+      EXPECT(assert_equal(m.second, view.measurement(k).second));
+      k++;
+    }
+  }
+  EXPECT_LONGS_EQUAL(k, view.number_measurements());
+
+  // Reading the whole file gives back the same data
+  SfM_data writtenData;
+  CHECK(readBinarySfM(filename.string(), writtenData));
+  EXPECT_LONGS_EQUAL(readData.number_cameras(), writtenData.number_cameras());
+  EXPECT_LONGS_EQUAL(readData.number_tracks(), writtenData.number_tracks());
+  for (size_t j = 0; j < readData.number_tracks(); j++) {
+    const SfM_Track &expected = readData.tracks[j],
+                    &actual = writtenData.tracks[j];
+    EXPECT(assert_equal(expected.p, actual.p));
+    EXPECT_DOUBLES_EQUAL(expected.r, actual.r, 0);
+    EXPECT_LONGS_EQUAL(expected.number_measurements(),
+                       actual.number_measurements());
+  }
+  boost::filesystem::remove(filename);
+
+  // Other files are rejected
+  SfM_data notBinary;
+  EXPECT(!readBinarySfM(filenameToRead, notBinary));
+}
+
 
 /* ************************************************************************* */
 TEST( dataSet, writeBALfromValues_Dubrovnik){
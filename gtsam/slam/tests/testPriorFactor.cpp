@@ -6,6 +6,7 @@
  */
 
 #include <gtsam/base/Vector.h>
+#include <gtsam/geometry/Pose3.h>
 #include <gtsam/slam/PriorFactor.h>
 #include <CppUnitLite/TestHarness.h>
 
@@ -33,6 +34,40 @@ TEST(PriorFactor, ConstructorDynamicSizeVector) {
   PriorFactor<Vector> factor(1, v, model);
 }
 
+// The fixed-size whitening in linearize agrees with NoiseModelFactor::linearize
+TEST(PriorFactor, linearizeWhitened) {
+  Values values;
+  values.insert(1, Pose3(Rot3::Rodrigues(0.1, 0.2, 0.3), Point3(1, 2, 3)));
+  const Pose3 prior(Rot3::Rodrigues(0.2, 0.1, 0.4), Point3(1.5, 1.8, 2.7));
+
+  Vector6 sigmas;
+  sigmas << 0.1, 0.2, 0.3, 1.0, 2.0, 3.0;
+  Matrix6 covariance = sigmas.asDiagonal();
+  covariance(0, 3) = covariance(3, 0) = 0.05;
+  std::vector<SharedNoiseModel> models;
+  models.push_back(noiseModel::Isotropic::Sigma(6, 0.5));
+  models.push_back(noiseModel::Diagonal::Sigmas(sigmas));
+  models.push_back(noiseModel::Gaussian::Covariance(covariance));
+  models.push_back(noiseModel::Constrained::MixedSigmas(
+      (Vector6() << 0, 0, 0, 1, 1, 1).finished()));
+
+  for (const SharedNoiseModel& model : models) {
+    PriorFactor<Pose3> factor(1, prior, model);
+    GaussianFactor::shared_ptr expected =
+        factor.NoiseModelFactor::linearize(values);
+    GaussianFactor::shared_ptr actual = factor.linearize(values);
+    EXPECT(assert_equal(*expected, *actual, 1e-9));
+  }
+
+  // Dynamic-size values fall back to the noise model
+  Vector v(5); v << 1, 2, 3, 4, 5;
+  Values vectorValues;
+  vectorValues.insert(1, Vector(Vector::Zero(5)));
+  PriorFactor<Vector> factor(1, v, noiseModel::Isotropic::Sigma(5, 2.0));
+  EXPECT(assert_equal(*factor.NoiseModelFactor::linearize(vectorValues),
+                      *factor.linearize(vectorValues), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,238 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testBinarySerialization.cpp
+ * @brief   Unit tests for the binary format of graphs, Values and Bayes trees
+ */
+
+#include <gtsam/nonlinear/BinarySerialization.h>
+#include <gtsam/slam/BinaryFactors.h>
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/linear/HessianFactor.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/base/TestableAssertions.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::L;
+using symbol_shorthand::X;
+
+namespace {
+/// Points compare with a strict inequality, so this is as exact as it gets
+const double kExact = 1e-300;
+
+/// Write obj to a string, then read all of it back
+template<class T>
+T roundTrip(const T& obj) {
+  ostringstream os;
+  BinaryOutArchive out(os);
+  writeBinary(out, obj);
+  const string data = os.str();
+  BinaryInArchive in(data.data(), data.size());
+  T result;
+  readBinary(in, result);
+  if (!in.atEnd()) throw runtime_error("roundTrip: data was not read");
+  return result;
+}
+
+/// A small pose graph with a variety of noise models
+NonlinearFactorGraph poseGraph() {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<PriorFactor<Pose2> >(
+      X(0), Pose2(0.1, 0.2, 0.3), noiseModel::Unit::Create(3));
+  graph.emplace_shared<BetweenFactor<Pose2> >(
+      X(0), X(1), Pose2(1.0, 0.0, 0.1), noiseModel::Isotropic::Sigma(3, 0.1));
+  graph.emplace_shared<BetweenFactor<Pose2> >(
+      X(1), X(2), Pose2(1.0, 0.1, 0.0),
+      noiseModel::Diagonal::Sigmas(Vector3(0.1, 0.2, 0.3)));
+  graph.emplace_shared<BetweenFactor<Pose2> >(
+      X(2), X(0), Pose2(-2.0, 0.0, -0.1),
+      noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.345),
+                                 noiseModel::Isotropic::Sigma(3, 0.2)));
+  Matrix3 covariance;
+  covariance << 1.0, 0.1, 0.0, 0.1, 2.0, 0.2, 0.0, 0.2, 3.0;
+  graph.emplace_shared<PriorFactor<Point3> >(
+      L(0), Point3(1, 2, 3), noiseModel::Gaussian::Covariance(covariance));
+  graph.emplace_shared<PriorFactor<Pose3> >(
+      X(3), Pose3(), noiseModel::Isotropic::Sigma(6, 1.0));
+  graph.emplace_shared<BetweenFactor<Pose3> >(
+      X(3), X(4), Pose3(Rot3::Ypr(0.1, 0.2, 0.3), Point3(1, 2, 3)),
+      noiseModel::Constrained::MixedSigmas(
+          (Vector(6) << 0, 0, 0, 0.1, 0.1, 0.1).finished()));
+  return graph;
+}
+
+Values poseGraphValues() {
+  Values values;
+  values.insert(X(0), Pose2(0.0, 0.0, 0.0));
+  values.insert(X(1), Pose2(1.1, 0.1, 0.1));
+  values.insert(X(2), Pose2(2.0, 0.2, 0.1));
+  values.insert(L(0), Point3(1.0, 2.1, 2.9));
+  values.insert(X(3), Pose3(Rot3::Rodrigues(0.1, -0.2, 0.3), Point3(4, 5, 6)));
+  values.insert(X(4), Pose3());
+  return values;
+}
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, Values) {
+  Values values = poseGraphValues();
+  values.insert(L(1), Point2(3.0, 4.0));
+  values.insert(L(2), Rot2::fromAngle(0.4));
+  values.insert(L(3), Rot3::Ypr(0.4, -0.1, 0.2));
+  values.insert(L(4), 5.0);
+  values.insert(L(5), (Vector(4) << 1, 2, 3, 4).finished());
+  values.insert(L(6), Cal3_S2(500, 510, 0.1, 320, 240));
+  values.insert(L(7), Cal3Bundler(500, 1e-3, 1e-5, 320, 240));
+
+  // All types are stored exactly
+  const Values actual = roundTrip(values);
+  EXPECT(assert_equal(values, actual, kExact));
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, NonlinearFactorGraph) {
+  NonlinearFactorGraph graph = poseGraph();
+  graph.push_back(NonlinearFactor::shared_ptr());  // null factors are kept
+  const NonlinearFactorGraph actual = roundTrip(graph);
+  EXPECT(assert_equal(graph, actual, 1e-12));
+
+  // The restored graph has the same error everywhere
+  const Values values = poseGraphValues();
+  EXPECT_DOUBLES_EQUAL(graph.error(values), actual.error(values), 1e-9);
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, GaussianFactorGraphAndVectorValues) {
+  const NonlinearFactorGraph graph = poseGraph();
+  const Values values = poseGraphValues();
+  GaussianFactorGraph linear = *graph.linearize(values);
+  linear.push_back(boost::make_shared<HessianFactor>(
+      X(0), X(1), Matrix3::Identity(), Matrix3::Ones(), Vector3(1, 2, 3),
+      2.0 * Matrix3::Identity(), Vector3(4, 5, 6), 7.0));
+  EXPECT(assert_equal(linear, roundTrip(linear), kExact));
+
+  const VectorValues delta = linear.optimize();
+  EXPECT(assert_equal(delta, roundTrip(delta), kExact));
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, GaussianBayesTree) {
+  const NonlinearFactorGraph graph = poseGraph();
+  const Values values = poseGraphValues();
+  const GaussianBayesTree bayesTree =
+      *graph.linearize(values)->eliminateMultifrontal();
+  const GaussianBayesTree actual = roundTrip(bayesTree);
+  EXPECT(assert_equal(bayesTree, actual, kExact));
+  EXPECT_LONGS_EQUAL(bayesTree.nodes().size(), actual.nodes().size());
+  EXPECT(assert_equal(bayesTree.optimize(), actual.optimize(), kExact));
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, file) {
+  const string filename =
+      (boost::filesystem::temp_directory_path() /
+       boost::filesystem::unique_path("gtsam-%%%%-%%%%.bin")).string();
+
+  // Several sections can be written to one file, and read back in order
+  const NonlinearFactorGraph graph = poseGraph();
+  const Values values = poseGraphValues();
+  {
+    ofstream os(filename.c_str(), ios::binary);
+    BinaryOutArchive ar(os);
+    writeBinary(ar, graph);
+    writeBinary(ar, values);
+  }
+  NonlinearFactorGraph actualGraph;
+  Values actualValues;
+  {
+    BinaryInArchive ar(filename);
+    readBinary(ar, actualGraph);
+    readBinary(ar, actualValues);
+    EXPECT(ar.atEnd());
+  }
+  EXPECT(assert_equal(graph, actualGraph, 1e-12));
+  EXPECT(assert_equal(values, actualValues, kExact));
+
+  // Convenience functions for a single object
+  EXPECT(saveBinary(values, filename));
+  Values loaded;
+  EXPECT(loadBinary(filename, loaded));
+  EXPECT(assert_equal(values, loaded, kExact));
+  boost::filesystem::remove(filename);
+  EXPECT(!loadBinary(filename, loaded));
+}
+
+/* ************************************************************************* */
+TEST(BinarySerialization, errors) {
+  ostringstream os;
+  {
+    BinaryOutArchive ar(os);
+    writeBinary(ar, poseGraphValues());
+  }
+  const string data = os.str();
+
+  // Reading the wrong section
+  {
+    BinaryInArchive ar(data.data(), data.size());
+    NonlinearFactorGraph graph;
+    CHECK_EXCEPTION(readBinary(ar, graph), std::runtime_error);
+  }
+
+  // Truncated data
+  {
+    BinaryInArchive ar(data.data(), data.size() - 8);
+    Values values;
+    CHECK_EXCEPTION(readBinary(ar, values), std::runtime_error);
+  }
+
+  // Counts larger than the data are rejected before anything is allocated
+  {
+    ostringstream os3;
+    {
+      BinaryOutArchive out(os3);
+      out.write<uint64_t>(uint64_t(1) << 60);
+      out.beginSection(BINARY_VARIABLE_INDEX);
+      out.write<uint64_t>(1);             // factors
+      out.write<uint64_t>(1);             // keys
+      out.write<Key>(X(0));
+      out.write<uint64_t>(uint64_t(1) << 60);  // factors of X(0)
+      out.endSection();
+    }
+    const string corrupt = os3.str();
+    BinaryInArchive in(corrupt.data(), corrupt.size());
+    CHECK_EXCEPTION(readKeys(in), std::runtime_error);
+    VariableIndex variableIndex;
+    CHECK_EXCEPTION(readBinary(in, variableIndex), std::runtime_error);
+  }
+
+  // Not the binary format
+  const string text = "22 serialization::archive";
+  CHECK_EXCEPTION(BinaryInArchive(text.data(), text.size()), std::runtime_error);
+
+  // Types that are not registered cannot be written
+  Values unregistered;
+  unregistered.insert(X(0), Cal3DS2());
+  ostringstream os2;
+  BinaryOutArchive ar(os2);
+  CHECK_EXCEPTION(writeBinary(ar, unregistered), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */
@@ -23,6 +23,8 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/nonlinear/expressionTesting.h>
 #include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/ExpressionFactorGroup.h>
+#include <gtsam/nonlinear/ExpressionFactorGraph.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam/nonlinear/expressionTesting.h>
 #include <gtsam/base/Testable.h>
@@ -630,6 +632,124 @@ TEST(ExpressionFactor, MultiplyWithInverseFunction) {
   EXPECT_CORRECT_FACTOR_JACOBIANS(factor, values, 1e-5, 1e-5);
 }
 
+/* ************************************************************************* */
+TEST(ExpressionFactorGroup, linearize) {
+  // Projections of three points into two cameras, keys 10+i and 20+j
+  Values values;
+  values.insert(10, Pose3());
+  values.insert(11, Pose3(Rot3::Ypr(0.1, 0.2, 0.3), Point3(0.5, 0, 0)));
+  values.insert(20, Point3(0, 0, 1));
+  values.insert(21, Point3(0.2, -0.1, 2));
+  values.insert(22, Point3(-0.3, 0.4, 3));
+
+  // The group expression uses placeholder keys 1 (pose) and 2 (point)
+  ExpressionFactorGroup<Point2> group(model,
+      project(transformTo(Pose3_(1), Point3_(2))));
+  EXPECT(KeyVector(list_of(1)(2)) == group.placeholderKeys());
+
+  NonlinearFactorGraph expected;
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      const Point2 z(0.1 * i, 0.05 * j);
+      group.add(list_of<Key>(10 + i)(20 + j), z);
+      expected.addExpressionFactor(model, z,
+          project(transformTo(Pose3_(10 + i), Point3_(20 + j))));
+    }
+  }
+  EXPECT_LONGS_EQUAL(6, group.size());
+  EXPECT(KeyVector(list_of(11)(21)) == group.keys(4));
+  EXPECT(assert_equal(Point2(0.1, 0.05), group.measured(4)));
+
+  EXPECT_DOUBLES_EQUAL(expected.error(values), group.error(values), 1e-9);
+  GaussianFactorGraph::shared_ptr actual = group.linearize(values);
+  EXPECT(assert_equal(*expected.linearize(values), *actual, 1e-9));
+
+  // Robust noise model, the weights of all members are computed at once
+  SharedNoiseModel robust = noiseModel::Robust::Create(
+      noiseModel::mEstimator::Huber::Create(0.05), model);
+  ExpressionFactorGroup<Point2> robustGroup(robust,
+      project(transformTo(Pose3_(1), Point3_(2))));
+  NonlinearFactorGraph robustExpected;
+  for (size_t i = 0; i < group.size(); i++) {
+    robustGroup.add(group.keys(i), group.measured(i));
+    robustExpected.addExpressionFactor(robust, group.measured(i),
+        project(transformTo(Pose3_(group.keys(i)[0]), Point3_(group.keys(i)[1]))));
+  }
+  EXPECT(assert_equal(*robustExpected.linearize(values),
+                      *robustGroup.linearize(values), 1e-9));
+
+  CHECK_EXCEPTION(group.add(list_of<Key>(10), Point2()), std::invalid_argument);
+  CHECK_EXCEPTION(group.add(list_of<Key>(10)(10), Point2()),
+                  std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST(ExpressionFactorGraph, linearizeShared) {
+  Values values;
+  values.insert(10, Pose3());
+  values.insert(11, Pose3(Rot3::Ypr(0.1, 0.2, 0.3), Point3(0.5, 0, 0)));
+  values.insert(20, Point3(0, 0, 1));
+  values.insert(21, Point3(0.2, -0.1, 2));
+  values.insert(22, Point3(-0.3, 0.4, 3));
+
+  // Three factors share the relative pose, one of them twice
+  ExpressionFactorGraph graph;
+  SharedNoiseModel model3 = noiseModel::Isotropic::Sigma(3, 0.1);
+  Pose3_ relative = between(Pose3_(10), Pose3_(11));
+  graph.addExpressionFactor(transformTo(relative, Point3_(20)), Point3(0, 0, 1),
+                            model3);
+  graph.addExpressionFactor(transformTo(relative, Point3_(21)), Point3(0, 0, 2),
+                            model3);
+  graph.addExpressionFactor(
+      transformTo(relative, Point3_(22)) + transformFrom(relative, Point3_(22)),
+      Point3(0, 0, 6), model3);
+  graph.emplace_shared<PriorFactor<Pose3> >(10, Pose3(),
+                                           noiseModel::Isotropic::Sigma(6, 0.1));
+
+  ExpressionFactorGraph::SharingStatistics statistics;
+  GaussianFactorGraph::shared_ptr actual =
+      graph.linearizeShared(values, &statistics);
+  EXPECT(assert_equal(*graph.linearize(values), *actual, 1e-9));
+
+  EXPECT_LONGS_EQUAL(1, statistics.sharedSubexpressions);
+  EXPECT_LONGS_EQUAL(1, statistics.evaluations);
+  EXPECT_LONGS_EQUAL(4, statistics.uses);
+  EXPECT_DOUBLES_EQUAL(0.75, statistics.reuseRatio(), 1e-9);
+
+  // Nothing is cached outside of linearizeShared
+  EXPECT(assert_equal(*graph.linearize(values), *actual, 1e-9));
+}
+
+/* ************************************************************************* */
+// A single Rot2 key and a 2D measurement: linearize uses forward AD
+TEST(ExpressionFactor, forwardAD) {
+  Values values;
+  values.insert(1, Rot2::fromAngle(0.3));
+
+  Rot2_ r(1);
+  Point2_ p(Point2(1, 2));
+  Point2_ once(r, &Rot2::rotate, p);
+  Point2_ twice(r, &Rot2::rotate, once);
+  Point2_ h = 2.0 * twice + once + p;
+  ExpressionFactor<Point2> f(model, Point2(0.5, -1), h);
+  EXPECT_CORRECT_FACTOR_JACOBIANS(f, values, 1e-7, 1e-5);
+
+  // Same Jacobian as with reverse AD, including with shared sub-expressions
+  std::vector<Matrix> H(1);
+  Vector error = f.unwhitenedError(values, H);
+  JacobianFactor::shared_ptr jf =
+      boost::dynamic_pointer_cast<JacobianFactor>(f.linearize(values));
+  EXPECT(assert_equal(H[0], Matrix(jf->getA(jf->begin())), 1e-9));
+  EXPECT(assert_equal(Vector(-error), Vector(jf->getb()), 1e-9));
+
+  ExpressionFactorGraph graph;
+  graph.addExpressionFactor(h, Point2(0.5, -1), model);
+  graph.addExpressionFactor(Point2_(r, &Rot2::rotate, twice), Point2(0, 1),
+                            model);
+  EXPECT(assert_equal(*graph.linearize(values),
+                      *graph.linearizeShared(values), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
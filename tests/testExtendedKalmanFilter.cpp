@@ -17,6 +17,7 @@
 #include <gtsam/slam/PriorFactor.h>
 #include <gtsam/slam/BetweenFactor.h>
 #include <gtsam/nonlinear/ExtendedKalmanFilter-inl.h>
+#include <gtsam/nonlinear/FixedExtendedKalmanFilter.h>
 #include <gtsam/nonlinear/NonlinearFactor.h>
 #include <gtsam/inference/Symbol.h>
 #include <gtsam/geometry/Point2.h>
@@ -418,6 +419,60 @@ TEST( ExtendedKalmanFilter, nonlinear ) {
 }
 
 
+/* ************************************************************************* */
+TEST( FixedExtendedKalmanFilter, linear ) {
+
+  // Same example as above, with a Point2 state
+  Point2 x_initial(0.0, 0.0);
+  SharedDiagonal P_initial = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1));
+  ExtendedKalmanFilter<Point2> ekf(X(0), x_initial, P_initial);
+  FixedExtendedKalmanFilter<Point2> fekf(x_initial, P_initial);
+
+  Point2 difference(1.0, 0.0);
+  SharedDiagonal Q = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.2), true);
+  SharedDiagonal R = noiseModel::Diagonal::Sigmas(Vector2(0.25, 0.5), true);
+
+  for (size_t i = 0; i < 3; i++) {
+    BetweenFactor<Point2> motionFactor(X(i), X(i + 1), difference, Q);
+    EXPECT(assert_equal(ekf.predict(motionFactor), fekf.predict(motionFactor)));
+    EXPECT(assert_equal(ekf.Density()->information(),
+                        Matrix(fekf.P().inverse()), 1e-9));
+
+    PriorFactor<Point2> measurementFactor(X(i + 1), Point2(i + 1.1, 0.1), R);
+    EXPECT(assert_equal(ekf.update(measurementFactor),
+                        fekf.update(measurementFactor), 1e-9));
+    EXPECT(assert_equal(ekf.Density()->information(),
+                        Matrix(fekf.P().inverse()), 1e-9));
+  }
+
+  // Constrained noise models are not Gaussian
+  PriorFactor<Point2> constrained(X(3), Point2(3, 0),
+                                  noiseModel::Constrained::All(2));
+  CHECK_EXCEPTION(fekf.update(constrained), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+TEST( FixedExtendedKalmanFilter, nonlinear ) {
+
+  // Same example as above, with a one-dimensional measurement
+  Point2 x_initial(0.90, 1.10);
+  SharedDiagonal P_initial = noiseModel::Diagonal::Sigmas(Vector2(0.1, 0.1));
+  ExtendedKalmanFilter<Point2> ekf(X(0), x_initial, P_initial);
+  FixedExtendedKalmanFilter<Point2> fekf(x_initial, P_initial);
+
+  for (unsigned int i = 0; i < 10; ++i) {
+    NonlinearMotionModel motionFactor(X(i), X(i+1));
+    EXPECT(assert_equal(ekf.predict(motionFactor), fekf.predict(motionFactor),
+                        1e-9));
+
+    NonlinearMeasurementModel measurementFactor(X(i+1), (Vector(1) << i + 1.0).finished());
+    EXPECT(assert_equal(ekf.update(measurementFactor),
+                        fekf.update(measurementFactor), 1e-9));
+    EXPECT(assert_equal(ekf.Density()->information(),
+                        Matrix(fekf.P().inverse()), 1e-9));
+  }
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
 /* ************************************************************************* */
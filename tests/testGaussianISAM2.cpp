@@ -5,6 +5,8 @@
  */
 
 #include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/ISAM2AsyncUpdater.h>
+#include <gtsam/nonlinear/BinarySerialization.h>
 
 #include <tests/smallExample.h>
 #include <gtsam/slam/PriorFactor.h>
@@ -808,6 +810,218 @@ TEST(ISAM2, marginalCovariance)
   EXPECT(assert_equal(expected, actual));
 }
 
+/* ************************************************************************* */
+TEST(ISAM2, trackedMarginalCovariances)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true,
+                     ISAM2Params::CHOLESKY, true, DefaultKeyFormatter, true);
+  params.cacheMarginalCovariances = true;
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  // Track a pose, a landmark, and a key that does not exist yet
+  isam.trackMarginalCovariances(list_of<Key>(5)(100)(12));
+  EXPECT(isam.hasTrackedMarginalCovariance(5));
+  EXPECT(isam.hasTrackedMarginalCovariance(100));
+  EXPECT(!isam.hasTrackedMarginalCovariance(12));
+
+  Marginals marginals(isam.getFactorsUnsafe(), isam.getLinearizationPoint());
+  EXPECT(assert_equal(marginals.marginalCovariance(5),
+                      isam.trackedMarginalCovariance(5)));
+  EXPECT(assert_equal(marginals.marginalCovariance(100),
+                      isam.trackedMarginalCovariance(100)));
+
+  // Add a loop closure and the new pose, cached marginals must follow
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  newfactors += BearingRangeFactor<Pose2, Point2>(
+      12, 100, Rot2::fromAngle(M_PI / 2.0), 4.0, brNoise);
+  Values init;
+  init.insert(12, Pose2(7.9, 0.1, 0.01));
+  isam.update(newfactors, init);
+
+  EXPECT(isam.hasTrackedMarginalCovariance(12));
+  Marginals updated(isam.getFactorsUnsafe(), isam.getLinearizationPoint());
+  for (Key key : isam.getTrackedMarginalKeys()) {
+    EXPECT(assert_equal(updated.marginalCovariance(key),
+                        isam.trackedMarginalCovariance(key)));
+    EXPECT(assert_equal(updated.marginalCovariance(key),
+                        isam.marginalCovariance(key)));
+  }
+
+  isam.untrackMarginalCovariances(list_of<Key>(5));
+  EXPECT(!isam.hasTrackedMarginalCovariance(5));
+  EXPECT_LONGS_EQUAL(2, isam.getTrackedMarginalKeys().size());
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, estimateView)
+{
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true,
+                     ISAM2Params::CHOLESKY, true, DefaultKeyFormatter, true);
+  params.publishEstimate = true;
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  ISAM2EstimateView::shared_ptr view = isam.estimateView();
+  const Values expected = isam.calculateEstimate();
+  EXPECT(assert_equal(expected, view->values()));
+  EXPECT(assert_equal(isam.getDelta(), view->deltas()));
+  EXPECT(assert_equal(expected.at<Pose2>(5), view->at<Pose2>(5)));
+  EXPECT(assert_equal(expected.at<Point2>(100), view->at<Point2>(100)));
+  CHECK_EXCEPTION(view->at<Point2>(5), ValuesIncorrectType);
+  CHECK_EXCEPTION(view->at(12), ValuesKeyDoesNotExist);
+
+  // An update that changes nothing shares every estimate with the old view
+  isam.update();
+  ISAM2EstimateView::shared_ptr unchanged = isam.estimateView();
+  EXPECT(unchanged != view);
+  EXPECT_LONGS_EQUAL(view->size(), unchanged->size());
+  for (Key key : view->keys())
+    EXPECT(&view->at(key) == &unchanged->at(key));
+
+  // Adding a pose publishes a new view, while the old one stays intact
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(11, 12, Pose2(1.0, 0.0, 0.0), odoNoise);
+  newfactors += BearingRangeFactor<Pose2, Point2>(
+      12, 100, Rot2::fromAngle(M_PI / 2.0), 4.0, brNoise);
+  Values init;
+  init.insert(12, Pose2(7.9, 0.1, 0.01));
+  isam.update(newfactors, init);
+
+  ISAM2EstimateView::shared_ptr updated = isam.estimateView();
+  EXPECT(assert_equal(isam.calculateEstimate(), updated->values()));
+  EXPECT(updated->exists(12));
+  EXPECT(!view->exists(12));
+  EXPECT(assert_equal(expected, view->values()));
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, asyncUpdater)
+{
+  // Relinearize every other step
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.01, 2, true, true,
+                     ISAM2Params::CHOLESKY, true, DefaultKeyFormatter, true);
+
+  vector<NonlinearFactorGraph> batches;
+  vector<Values> inits;
+  vector<ISAM2UpdateParams> updateParams;
+  {
+    NonlinearFactorGraph newfactors;
+    newfactors += PriorFactor<Pose2>(0, Pose2(0.0, 0.0, 0.0), odoNoise);
+    Values init;
+    init.insert(0, Pose2(0.01, 0.01, 0.01));
+    batches.push_back(newfactors);
+    inits.push_back(init);
+    updateParams.push_back(ISAM2UpdateParams());
+  }
+  for (size_t i = 0; i < 10; ++i) {
+    NonlinearFactorGraph newfactors;
+    newfactors += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+    newfactors += BearingRangeFactor<Pose2, Point2>(
+        i + 1, 100, Rot2::fromAngle(M_PI / 4.0), 5.0, brNoise);
+    Values init;
+    init.insert(i + 1, Pose2(double(i + 1) + 0.1, -0.1, 0.01));
+    if (i == 0) init.insert(100, Point2(4.5, 3.0));
+    batches.push_back(newfactors);
+    inits.push_back(init);
+    updateParams.push_back(ISAM2UpdateParams());
+    // Full solves on some relinearization steps
+    updateParams.back().forceFullSolve = (i % 4 == 3);
+  }
+
+  ISAM2 expected(params);
+  vector<ISAM2Result> expectedResults;
+  for (size_t i = 0; i < batches.size(); ++i)
+    expectedResults.push_back(
+        expected.update(batches[i], inits[i], updateParams[i]));
+
+  ISAM2 actual(params);
+  vector<std::future<ISAM2Result> > futures;
+  {
+    ISAM2AsyncUpdater updater(actual, 2);
+    for (size_t i = 0; i < batches.size(); ++i)
+      futures.push_back(updater.update(batches[i], inits[i], updateParams[i]));
+    updater.waitUntilIdle();
+    EXPECT_LONGS_EQUAL(0, updater.pendingUpdates());
+  }
+
+  for (size_t i = 0; i < futures.size(); ++i) {
+    const ISAM2Result result = futures[i].get();
+    EXPECT_LONGS_EQUAL(expectedResults[i].variablesRelinearized,
+                       result.variablesRelinearized);
+    EXPECT_LONGS_EQUAL(expectedResults[i].variablesReeliminated,
+                       result.variablesReeliminated);
+  }
+  // Every job is one call to ISAM2::update(), so results are identical. Point2
+  // is compared with ==, as its Equals is relative.
+  EXPECT(assert_equal(expected.getDelta(), actual.getDelta(), 0.0));
+  const Values expectedEstimate = expected.calculateEstimate();
+  const Values actualEstimate = actual.calculateEstimate();
+  for (size_t i = 0; i <= 10; ++i)
+    EXPECT(assert_equal(expectedEstimate.at<Pose2>(i),
+                        actualEstimate.at<Pose2>(i), 0.0));
+  EXPECT(expectedEstimate.at<Point2>(100) == actualEstimate.at<Point2>(100));
+
+  // Failed updates are reported through the future
+  ISAM2AsyncUpdater updater(actual);
+  NonlinearFactorGraph bad;
+  bad += BetweenFactor<Pose2>(10, 200, Pose2(1.0, 0.0, 0.0), odoNoise);
+  std::future<ISAM2Result> failed = updater.update(bad);
+  CHECK_EXCEPTION(failed.get(), std::exception);
+}
+
+/* ************************************************************************* */
+TEST(ISAM2, maxRelinearizeKeys)
+{
+  // Accumulate deltas without relinearizing, then relinearize on demand
+  ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.001, 1, false, true,
+                     ISAM2Params::CHOLESKY, true, DefaultKeyFormatter, true);
+  ISAM2 unlimited = createSlamlikeISAM2(boost::none, boost::none, params);
+  ISAM2 limited = createSlamlikeISAM2(boost::none, boost::none, params);
+
+  ISAM2UpdateParams updateParams;
+  updateParams.force_relinearize = true;
+  const ISAM2Result expected =
+      unlimited.update(NonlinearFactorGraph(), Values(), updateParams);
+
+  // Rank the variables by their delta, all thresholds being equal
+  vector<pair<double, Key> > ranked;
+  for (const auto& key_delta : limited.getDelta())
+    ranked.emplace_back(key_delta.second.lpNorm<Eigen::Infinity>(),
+                        key_delta.first);
+  sort(ranked.rbegin(), ranked.rend());
+
+  updateParams.maxRelinearizeKeys = 2;
+  const ISAM2Result actual =
+      limited.update(NonlinearFactorGraph(), Values(), updateParams);
+
+  KeySet expectedAbove, actualAbove;
+  for (const auto& key_status : expected.detail->variableStatus)
+    if (key_status.second.isAboveRelinThreshold)
+      expectedAbove.insert(key_status.first);
+  for (const auto& key_status : actual.detail->variableStatus)
+    if (key_status.second.isAboveRelinThreshold)
+      actualAbove.insert(key_status.first);
+  EXPECT(expectedAbove.size() > 2);
+  EXPECT_LONGS_EQUAL(0, expected.variablesDeferred);
+  EXPECT_LONGS_EQUAL(expectedAbove.size() - 2, actual.variablesDeferred);
+  KeySet largest;
+  largest.insert(ranked[0].second);
+  largest.insert(ranked[1].second);
+  EXPECT(assert_container_equality(largest, actualAbove));
+
+  // Relinearization is disabled, so the next update leaves the backlog alone
+  const ISAM2Result skipped = limited.update();
+  EXPECT_LONGS_EQUAL(0, skipped.variablesRelinearized);
+  EXPECT_LONGS_EQUAL(0, skipped.variablesDeferred);
+
+  // and the next forced relinearization picks it up
+  updateParams.maxRelinearizeKeys = boost::none;
+  const ISAM2Result next =
+      limited.update(NonlinearFactorGraph(), Values(), updateParams);
+  EXPECT_LONGS_EQUAL(0, next.variablesDeferred);
+  EXPECT(next.variablesRelinearized > 0);
+}
+
 /* ************************************************************************* */
 TEST(ISAM2, calculate_nnz)
 {
@@ -818,6 +1032,79 @@ TEST(ISAM2, calculate_nnz)
   EXPECT_LONGS_EQUAL(expected, actual);
 }
 
+/* ************************************************************************* */
+namespace {
+string saveCheckpoint(const ISAM2& isam, bool incremental = false) {
+  ostringstream os;
+  BinaryOutArchive ar(os);
+  isam.saveCheckpoint(ar, incremental);
+  return os.str();
+}
+
+void restoreCheckpoint(ISAM2& isam, const string& checkpoint) {
+  BinaryInArchive ar(checkpoint.data(), checkpoint.size());
+  isam.restoreCheckpoint(ar);
+}
+
+/// Add the pose i+1, seen from pose i and landmark 100
+void addPose(ISAM2& isam, size_t i) {
+  NonlinearFactorGraph newfactors;
+  newfactors += BetweenFactor<Pose2>(i, i + 1, Pose2(1.0, 0.0, 0.0), odoNoise);
+  newfactors += BearingRangeFactor<Pose2, Point2>(
+      i + 1, 100, Rot2::fromAngle(M_PI / 2.0), 4.0, brNoise);
+  Values init;
+  init.insert(i + 1, Pose2(double(i + 1) - 0.1, 0.1, 0.01));
+  isam.update(newfactors, init);
+}
+}  // namespace
+
+/* ************************************************************************* */
+TEST(ISAM2, checkpoint)
+{
+  const ISAM2Params params(ISAM2GaussNewtonParams(0.001), 0.0, 0, false, true,
+                           ISAM2Params::CHOLESKY, true, DefaultKeyFormatter,
+                           true);
+  ISAM2 isam = createSlamlikeISAM2(boost::none, boost::none, params);
+  const string full = saveCheckpoint(isam);
+  EXPECT_LONGS_EQUAL(1, isam.getCheckpoint());
+
+  ISAM2 restored(params);
+  restoreCheckpoint(restored, full);
+  EXPECT(assert_equal(isam, restored));
+  EXPECT(assert_equal(isam.getDelta(), restored.getDelta()));
+  EXPECT(assert_equal(isam.getLinearizationPoint(),
+                      restored.getLinearizationPoint()));
+  EXPECT(assert_equal(isam.getVariableIndex(), restored.getVariableIndex()));
+  EXPECT_LONGS_EQUAL(isam.getUpdateCount(), restored.getUpdateCount());
+
+  // An incremental checkpoint only contains what the update changed
+  addPose(isam, 11);
+  const string incremental = saveCheckpoint(isam, true);
+  EXPECT(incremental.size() < full.size());
+  EXPECT_LONGS_EQUAL(2, isam.getCheckpoint());
+
+  // which can be restored on top of the full one
+  ISAM2 other(params);
+  CHECK_EXCEPTION(restoreCheckpoint(other, incremental), std::runtime_error);
+  restoreCheckpoint(restored, incremental);
+  EXPECT_LONGS_EQUAL(2, restored.getCheckpoint());
+  EXPECT(assert_equal(isam, restored));
+  EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate()));
+
+  // Both continue identically
+  addPose(isam, 12);
+  addPose(restored, 12);
+  EXPECT(assert_equal(isam, restored));
+  EXPECT(assert_equal(isam.calculateEstimate(), restored.calculateEstimate(),
+                      1e-12));
+
+  // Checkpoints continue from a restored ISAM2
+  restoreCheckpoint(other, full);
+  restoreCheckpoint(other, incremental);
+  restoreCheckpoint(other, saveCheckpoint(restored, true));
+  EXPECT(assert_equal(restored, other));
+}
+
 /* ************************************************************************* */
 int main() { TestResult tr; return TestRegistry::runAllTests(tr);}
 /* ************************************************************************* */
@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------------
+
+ * GTSAM Copyright 2010, Georgia Tech Research Corporation,
+ * Atlanta, Georgia 30332-0415
+ * All Rights Reserved
+ * Authors: Frank Dellaert, et al. (see THANKS for the full author list)
+
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file    testGncOptimizer.cpp
+ * @brief   Unit tests for GncOptimizer
+ */
+
+#include <gtsam/nonlinear/GncOptimizer.h>
+#include <gtsam/nonlinear/GaussNewtonOptimizer.h>
+#include <gtsam/slam/PriorFactor.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <CppUnitLite/TestHarness.h>
+
+using namespace std;
+using namespace gtsam;
+using symbol_shorthand::X;
+
+namespace {
+// Priors on a single point: most agree on (1, 1), a few are gross outliers
+NonlinearFactorGraph outlierPriors(const SharedNoiseModel& model) {
+  NonlinearFactorGraph graph;
+  for (int i = 0; i < 10; i++)
+    graph.emplace_shared<PriorFactor<Point2> >(
+        X(0), Point2(1.0 + 0.01 * (i % 3), 1.0 - 0.01 * (i % 2)), model);
+  for (int i = 0; i < 4; i++)
+    graph.emplace_shared<PriorFactor<Point2> >(
+        X(0), Point2(30.0 + i, -20.0), model);
+  return graph;
+}
+}
+
+/* ************************************************************************* */
+TEST(GncOptimizer, gemanMcClure) {
+  const noiseModel::mEstimator::GemanMcClure::shared_ptr gemanMcClure =
+      noiseModel::mEstimator::GemanMcClure::Create(1.0);
+  const SharedNoiseModel model = noiseModel::Robust::Create(
+      gemanMcClure, noiseModel::Isotropic::Sigma(2, 0.1));
+  const NonlinearFactorGraph graph = outlierPriors(model);
+
+  // Started far from the inliers, the outliers win
+  Values initial;
+  initial.insert(X(0), Point2(25.0, -15.0));
+  const Values local = LevenbergMarquardtOptimizer(graph, initial).optimize();
+  EXPECT(distance2(local.at<Point2>(X(0)), Point2(1.0, 1.0)) > 1.0);
+
+  // GNC starts from the convexified problem, where all factors agree
+  GncOptimizer<> gnc(graph, initial);
+  EXPECT_LONGS_EQUAL(1, gnc.numKernels());
+  const Values result = gnc.optimize();
+  EXPECT(assert_equal(Point2(1.0, 1.0), result.at<Point2>(X(0)), 0.02));
+  EXPECT(gnc.stages() > 1);
+
+  // The estimator of the graph was restored
+  DOUBLES_EQUAL(1.0, gemanMcClure->modelParameter(), 1e-12);
+}
+
+/* ************************************************************************* */
+TEST(GncOptimizer, tukeyGaussNewton) {
+  const noiseModel::mEstimator::Tukey::shared_ptr tukey =
+      noiseModel::mEstimator::Tukey::Create(4.6851);
+  const SharedNoiseModel model = noiseModel::Robust::Create(
+      tukey, noiseModel::Isotropic::Sigma(2, 0.1));
+  const NonlinearFactorGraph graph = outlierPriors(model);
+
+  Values initial;
+  initial.insert(X(0), Point2(25.0, -15.0));
+  GncOptimizer<GaussNewtonOptimizer>::Params params;
+  params.muStep = 2.0;
+  GncOptimizer<GaussNewtonOptimizer> gnc(graph, initial, params);
+  const Values result = gnc.optimize();
+  EXPECT(assert_equal(Point2(1.0, 1.0), result.at<Point2>(X(0)), 0.02));
+  DOUBLES_EQUAL(4.6851, tukey->modelParameter(), 1e-12);
+}
+
+/* ************************************************************************* */
+TEST(GncOptimizer, maxStages) {
+  const SharedNoiseModel model = noiseModel::Robust::Create(
+      noiseModel::mEstimator::GemanMcClure::Create(1.0),
+      noiseModel::Isotropic::Sigma(2, 0.1));
+  const NonlinearFactorGraph graph = outlierPriors(model);
+  Values initial;
+  initial.insert(X(0), Point2(25.0, -15.0));
+
+  // A single stage solves the original problem
+  GncOptimizer<>::Params params;
+  params.maxStages = 1;
+  GncOptimizer<> single(graph, initial, params);
+  const Values expected = LevenbergMarquardtOptimizer(graph, initial).optimize();
+  EXPECT(assert_equal(expected, single.optimize(), 1e-9));
+  EXPECT_LONGS_EQUAL(1, single.stages());
+
+  // Running out of stages before mu reaches 1 still ends at mu = 1
+  params.maxStages = 3;
+  params.muInit = 1e4;
+  GncOptimizer<> gnc(graph, initial, params);
+  const Values result = gnc.optimize();
+  EXPECT_LONGS_EQUAL(3, gnc.stages());
+  const Values refined = LevenbergMarquardtOptimizer(graph, result).optimize();
+  EXPECT(assert_equal(refined, result, 1e-6));
+}
+
+/* ************************************************************************* */
+int main() { TestResult tr; return TestRegistry::runAllTests(tr); }
+/* ************************************************************************* */